@@ -182,6 +182,8 @@ void Checkpoint::dumpAll( VectorPatch &vecPatches, unsigned int itime,  SmileiMP
     nameDumpTmp << "dump-" << setfill('0') << setw(5) << num_dump << "-" << setfill('0') << setw(10) << smpi->getRank() << ".h5" ;
     std::string dumpName=nameDumpTmp.str();
 
+    // The asynchronous outputs must be complete before accessing HDF5
+    vecPatches.waitAllDiagsOutput();
 
     hid_t fid = H5Fcreate( dumpName.c_str(), H5F_ACC_TRUNC, H5P_DEFAULT, H5P_DEFAULT);
     dump_number++;
@@ -245,7 +247,7 @@ void Checkpoint::dumpAll( VectorPatch &vecPatches, unsigned int itime,  SmileiMP
         dumpPatch( vecPatches(ipatch)->EMfields, vecPatches(ipatch)->vecSpecies, params, patch_gid );
 
         // Random number generator state
-        H5::attr(patch_gid, "xorshift32_state", vecPatches(ipatch)->xorshift32_state);
+        H5::attr(patch_gid, "random_state", vecPatches(ipatch)->rand_->get_state());
 
         // Close a group
         H5Gclose(patch_gid);
@@ -493,7 +495,9 @@ void Checkpoint::restartAll( VectorPatch &vecPatches,  SmileiMPI* smpi, SimWindo
         restartPatch( vecPatches(ipatch)->EMfields, vecPatches(ipatch)->vecSpecies, params, patch_gid );
 
         // Random number generator state
-        H5::getAttr(patch_gid, "xorshift32_state", vecPatches(ipatch)->xorshift32_state);
+        vector<unsigned int> random_state;
+        H5::getAttr(patch_gid, "random_state", random_state, H5T_NATIVE_UINT);
+        vecPatches(ipatch)->rand_->set_state( random_state );
 
         H5Gclose(patch_gid);
 
@@ -660,7 +664,7 @@ void Checkpoint::restartPatch( ElectroMagn* EMfields,std::vector<Species*> &vecS
                 H5::getVect(gid,"Id",vecSpecies[ispec]->particles->Id, H5T_NATIVE_UINT64);
             }
 
-            if (params.vectorization_mode == "off" || params.vectorization_mode == "on")
+            if (params.vectorization_mode == "off" || params.vectorization_mode == "on" || params.vectorization_mode == "hybrid")
             {
                 H5::getVect(gid,"first_index",vecSpecies[ispec]->first_index,true);
                 H5::getVect(gid,"last_index",vecSpecies[ispec]->last_index,true);
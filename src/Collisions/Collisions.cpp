@@ -172,6 +172,9 @@ void Collisions::collide(Params& params, Patch* patch, int itime, vector<Diagnos
 
     bool debug = (debug_every > 0 && itime % debug_every == 0); // debug only every N timesteps
 
+    // Random stream of this collision block in this patch and at this timestep
+    patch->rand_->set_stream( patch->Hindex(), itime, Random::COLLISIONS, n_collisions );
+
     if( debug ) {
         ncol = 0.;
         smean       = 0.;
@@ -221,7 +224,7 @@ void Collisions::collide(Params& params, Patch* patch, int itime, vector<Diagnos
         for (unsigned int i=0; i<npart1; i++) index1[i] = i; // first, we make an ordered array
         // shuffle the index array
         for (unsigned int i=npart1; i>1; i--) {
-            unsigned int p = patch->xorshift32() % i;
+            unsigned int p = patch->rand_->integer() % i;
             swap(index1[i-1], index1[p]);
         }
         if (intra_collisions) { // In the case of collisions within one species
@@ -298,9 +301,9 @@ void Collisions::collide(Params& params, Patch* patch, int itime, vector<Diagnos
             m12  = s1->mass / s2->mass; // mass ratio
 
             logL = coulomb_log;
-            double U1  = patch->xorshift32() * patch->xorshift32_invmax;
-            double U2  = patch->xorshift32() * patch->xorshift32_invmax;
-            double phi = patch->xorshift32() * patch->xorshift32_invmax * twoPi;
+            double U1  = patch->rand_->uniform();
+            double U2  = patch->rand_->uniform();
+            double phi = patch->rand_->uniform() * twoPi;
             s = one_collision(p1, i1, s1->mass, p2, i2, m12, coeff1, coeff2, coeff3, coeff4, n123, n223, debye2, logL, U1, U2, phi);
 
             // Handle ionization
@@ -353,6 +356,9 @@ void Collisions::debug(Params& params, int itime, unsigned int icoll, VectorPatc
                 debye_length_squared[ipatch] += vecPatches(ipatch)->debye_length_squared[ibin];
         }
 
+        // The asynchronous outputs must be complete before accessing HDF5
+        vecPatches.waitAllDiagsOutput();
+
         // Open the HDF5 file
         hid_t file_access = H5Pcreate(H5P_FILE_ACCESS);
         H5Pset_fapl_mpio(file_access, MPI_COMM_WORLD, MPI_INFO_NULL);
@@ -35,6 +35,9 @@ void CollisionsSingle::collide(Params& params, Patch* patch, int itime, vector<D
     s2 = patch->vecSpecies[species_group2[0]];
     
     bool debug = (debug_every > 0 && itime % debug_every == 0); // debug only every N timesteps
+
+    // Random stream of this collision block in this patch and at this timestep
+    patch->rand_->set_stream( patch->Hindex(), itime, Random::COLLISIONS, n_collisions );
     
     if( debug ) {
         ncol = 0.;
@@ -82,7 +85,7 @@ void CollisionsSingle::collide(Params& params, Patch* patch, int itime, vector<D
         for (unsigned int i=0; i<npairs; i++)
             index1[i] = first_index1 + i;
         for (unsigned int i=npairs; i>1; i--) {
-            unsigned int p = patch->xorshift32() % i;
+            unsigned int p = patch->rand_->integer() % i;
             swap(index1[i-1], index1[p]);
         }
         p1->swap_parts(index1); // exchange particles along the cycle defined by the shuffle
@@ -127,9 +130,9 @@ void CollisionsSingle::collide(Params& params, Patch* patch, int itime, vector<D
             i2 = first_index2 + i%N2max;
 
             logL = coulomb_log;
-            double U1  = patch->xorshift32() * patch->xorshift32_invmax;
-            double U2  = patch->xorshift32() * patch->xorshift32_invmax;
-            double phi = patch->xorshift32() * patch->xorshift32_invmax * twoPi;
+            double U1  = patch->rand_->uniform();
+            double U2  = patch->rand_->uniform();
+            double phi = patch->rand_->uniform() * twoPi;
             
             s = one_collision(p1, i1, s1->mass, p2, i2, m12, coeff1, coeff2, coeff3, coeff4, n123, n223, debye2, logL, U1, U2, phi);
 
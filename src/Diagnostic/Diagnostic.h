@@ -41,6 +41,12 @@ public :
     
     //! Tells whether this diagnostic requires the pre-calculation of the particle J & Rho
     virtual bool needsRhoJs(int timestep) { return false; };
+    
+    //! Tells whether this diag accesses HDF5 files at this timestep (the asynchronous outputs must be completed before)
+    virtual bool usesHDF5(int timestep) { return true; };
+    
+    //! Waits for the end of the asynchronous output of this diag, if any
+    virtual void waitOutput() {};
 
     //! Time selection for writing the diagnostic
     TimeSelection * timeSelection;
@@ -26,6 +26,10 @@ DiagnosticFields::DiagnosticFields( Params &params, SmileiMPI* smpi, VectorPatch
     if( time_average < 1 ) time_average = 1;
     time_average_inv = 1./((double)time_average);
     
+    // Extract the asynchronous parameter
+    asynchronous = false;
+    PyTools::extract("asynchronous", asynchronous, "DiagFields", ndiag);
+    
     // Define the filename
     ostringstream fn("");
     fn << "Fields"<< ndiag <<".h5";
@@ -144,7 +148,7 @@ DiagnosticFields::DiagnosticFields( Params &params, SmileiMPI* smpi, VectorPatch
     // Some output
     ostringstream p("");
     p << "(time average = " << time_average << ")";
-    MESSAGE(1,"Diagnostic Fields #"<<ndiag<<" "<<(time_average>1?p.str():"")<<" :");
+    MESSAGE(1,"Diagnostic Fields #"<<ndiag<<" "<<(time_average>1?p.str():"")<<(asynchronous?" (asynchronous)":"")<<" :");
     MESSAGE(2, ss.str() );
     
     // Create new fields in each patch, for time-average storage
@@ -177,6 +181,9 @@ DiagnosticFields::DiagnosticFields( Params &params, SmileiMPI* smpi, VectorPatch
     write_plist = H5Pcreate(H5P_DATASET_XFER);
     H5Pset_dxpl_mpio(write_plist, H5FD_MPIO_COLLECTIVE);
     
+    // Staging buffers of the asynchronous output
+    if( asynchronous ) data_staged.resize( fields_names.size() );
+    
     // Prepare some openPMD parameters
     field_type.resize( fields_names.size() );
     for( unsigned int ifield=0; ifield<fields_names.size(); ifield++ ) {
@@ -194,6 +201,7 @@ DiagnosticFields::DiagnosticFields( Params &params, SmileiMPI* smpi, VectorPatch
 
 DiagnosticFields::~DiagnosticFields()
 {
+    waitOutput();
     H5Pclose( write_plist );
     
     delete timeSelection;
@@ -247,6 +255,8 @@ void DiagnosticFields::openFile( Params& params, SmileiMPI* smpi, bool newfile )
 
 void DiagnosticFields::closeFile()
 {
+    waitOutput();
+    
     if ( filespace_firstwrite>0 ) H5Sclose( filespace_firstwrite );
     if ( memspace_firstwrite >0 ) H5Sclose( memspace_firstwrite );
     if ( filespace_reread    >0 ) H5Sclose( filespace_reread );
@@ -336,36 +346,83 @@ void DiagnosticFields::run( SmileiMPI* smpi, VectorPatch& vecPatches, int itime,
         
         #pragma omp master
         {
-            // Create field dataset in HDF5
-            hid_t plist_id = H5Pcreate(H5P_DATASET_CREATE);
-            hid_t dset_id  = H5Dcreate( iteration_group_id, fields_names[ifield].c_str(), H5T_NATIVE_DOUBLE, filespace, H5P_DEFAULT, plist_id, H5P_DEFAULT);
-            H5Pclose(plist_id);
-            
-            // Write
-            writeField(dset_id, itime);
-            
-            // Attributes for openPMD
-            openPMD->writeFieldAttributes( dset_id, subgrid_start, subgrid_step );
-            openPMD->writeRecordAttributes( dset_id, field_type[ifield] );
-            openPMD->writeFieldRecordAttributes( dset_id );
-            openPMD->writeComponentAttributes( dset_id, field_type[ifield] );
-            
-            // Close dataset
-            H5Dclose( dset_id );
+            if( asynchronous ) {
+                // Keep the buffer for the I/O thread
+                swapStagedField( ifield );
+            } else {
+                writeDataset( ifield, itime );
+            }
         }
     }
     
     #pragma omp master
     {
-        // write x_moved
         double x_moved = simWindow ? simWindow->getXmoved() : 0.;
-        H5::attr(iteration_group_id, "x_moved", x_moved);
-        
-        H5Gclose(iteration_group_id);
-        if( tmp_dset_id>0 ) H5Dclose( tmp_dset_id );
-        tmp_dset_id=0;
-        if( flush_timeSelection->theTimeIsNow(itime) ) H5Fflush( fileId_, H5F_SCOPE_GLOBAL );
+        bool flush = flush_timeSelection->theTimeIsNow(itime);
+        if( asynchronous ) {
+            // The file is written while the PIC loop goes on
+            io_thread = thread( &DiagnosticFields::writeStagedFields, this, itime, x_moved, flush );
+        } else {
+            closeIteration( itime, x_moved, flush );
+        }
+    }
+}
+
+void DiagnosticFields::writeDataset( unsigned int ifield, int itime )
+{
+    // Create field dataset in HDF5
+    hid_t plist_id = H5Pcreate(H5P_DATASET_CREATE);
+    hid_t dset_id  = H5Dcreate( iteration_group_id, fields_names[ifield].c_str(), H5T_NATIVE_DOUBLE, filespace, H5P_DEFAULT, plist_id, H5P_DEFAULT);
+    H5Pclose(plist_id);
+    
+    // Write
+    writeField(dset_id, itime);
+    
+    // Attributes for openPMD
+    openPMD->writeFieldAttributes( dset_id, subgrid_start, subgrid_step );
+    openPMD->writeRecordAttributes( dset_id, field_type[ifield] );
+    openPMD->writeFieldRecordAttributes( dset_id );
+    openPMD->writeComponentAttributes( dset_id, field_type[ifield] );
+    
+    // Close dataset
+    H5Dclose( dset_id );
+}
+
+void DiagnosticFields::closeIteration( int itime, double x_moved, bool flush )
+{
+    // write x_moved
+    H5::attr(iteration_group_id, "x_moved", x_moved);
+    
+    H5Gclose(iteration_group_id);
+    if( tmp_dset_id>0 ) H5Dclose( tmp_dset_id );
+    tmp_dset_id=0;
+    if( flush ) H5Fflush( fileId_, H5F_SCOPE_GLOBAL );
+}
+
+void DiagnosticFields::writeStagedFields( int itime, double x_moved, bool flush )
+{
+    for( unsigned int ifield=0; ifield < fields_indexes.size(); ifield++ ) {
+        swapStagedField( ifield );
+        writeDataset( ifield, itime );
+        swapStagedField( ifield );
     }
+    closeIteration( itime, x_moved, flush );
+}
+
+void DiagnosticFields::swapStagedField( unsigned int ifield )
+{
+    data.swap( data_staged[ifield] );
+    data.resize( data_staged[ifield].size() );
+}
+
+void DiagnosticFields::waitOutput()
+{
+    if( io_thread.joinable() ) io_thread.join();
+}
+
+bool DiagnosticFields::usesHDF5(int itime)
+{
+    return itime - timeSelection->previousTime(itime) == time_average-1;
 }
 
 bool DiagnosticFields::needsRhoJs(int itime)
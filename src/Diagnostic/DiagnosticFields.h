@@ -1,6 +1,8 @@
 #ifndef DIAGNOSTICFIELDS_H
 #define DIAGNOSTICFIELDS_H
 
+#include <thread>
+
 #include "Diagnostic.h"
 
 class DiagnosticFields  : public Diagnostic {
@@ -26,6 +28,12 @@ public :
     
     virtual bool needsRhoJs(int itime) override;
     
+    //! HDF5 is accessed only at the writing timesteps (not while averaging)
+    bool usesHDF5(int itime) override;
+    
+    //! Waits for the end of the I/O thread
+    void waitOutput() override;
+    
     bool hasField(std::string field_name, std::vector<std::string> fieldsToDump);
     
     void findSubgridIntersection(unsigned int subgrid_start,
@@ -74,6 +82,22 @@ protected :
     //! Buffer for the output of a field
     std::vector<double> data;
     
+    //! Write the fields asynchronously, in a separate I/O thread
+    bool asynchronous;
+    //! I/O thread of the asynchronous output
+    std::thread io_thread;
+    //! Buffers of all the fields of the current output, written by the I/O thread
+    std::vector<std::vector<double> > data_staged;
+    //! Exchange the "data" buffer with the staged buffer of a field
+    virtual void swapStagedField( unsigned int ifield );
+    
+    //! Create the dataset of a field and write the "data" buffer
+    void writeDataset( unsigned int ifield, int itime );
+    //! Write the remaining attributes of the iteration, close it and flush the file if requested
+    void closeIteration( int itime, double x_moved, bool flush );
+    //! Write all the staged fields of an iteration (body of the I/O thread)
+    void writeStagedFields( int itime, double x_moved, bool flush );
+    
     //! 1st patch index of vecPatches
     unsigned int refHindex;
     
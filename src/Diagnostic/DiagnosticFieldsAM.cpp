@@ -244,3 +244,10 @@ void DiagnosticFieldsAM::writeField( hid_t dset_id, int itime ) {
     
 }
 
+
+void DiagnosticFieldsAM::swapStagedField( unsigned int ifield )
+{
+    if( idata_staged.size() != fields_names.size() ) idata_staged.resize( fields_names.size() );
+    idata.swap( idata_staged[ifield] );
+    idata.resize( idata_staged[ifield].size() );
+}
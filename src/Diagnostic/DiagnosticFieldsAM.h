@@ -19,6 +19,9 @@ public:
     void getField( Patch* patch, unsigned int ) override;
     
     void writeField(hid_t, int) override;
+    
+    //! Exchange the "idata" buffer with the staged buffer of a field
+    void swapStagedField( unsigned int ifield ) override;
 
 private:
     
@@ -26,6 +29,7 @@ private:
     std::vector<unsigned int> rewrite_patches_x, rewrite_patches_y;
 
     std::vector<std::complex<double>> idata_reread, idata_rewrite, idata;
+    std::vector<std::vector<std::complex<double>>> idata_staged;
 
 };
 
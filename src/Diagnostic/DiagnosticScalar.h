@@ -100,6 +100,9 @@ public :
     
     virtual bool needsRhoJs(int timestep) override;
     
+    //! Scalars are written in a text file
+    bool usesHDF5(int timestep) override { return false; };
+    
     //! get a particular scalar
     double getScalar(std::string name);
     
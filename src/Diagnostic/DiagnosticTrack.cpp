@@ -364,10 +364,13 @@ void DiagnosticTrack::run( SmileiMPI* smpi, VectorPatch& vecPatches, int itime,
     #pragma omp master
     data_double.resize( nParticles_local, 0 );
 
+    // Index of the first momentum component among the properties of type particle_real
+    unsigned int ireal = vecPatches(0)->vecSpecies[speciesId_]->particles->first_real_prop();
+
     // Weight
     if( write_weight ) {
         #pragma omp barrier
-        fill_buffer(vecPatches, nDim_particle+3, data_double);
+        fill_buffer<double,particle_real>(vecPatches, ireal+3, data_double);
         #pragma omp master
         write_scalar( species_group, "weight", data_double[0], H5T_NATIVE_DOUBLE, file_space, mem_space, plist, SMILEI_UNIT_DENSITY, nParticles_global );
     }
@@ -382,7 +385,7 @@ void DiagnosticTrack::run( SmileiMPI* smpi, VectorPatch& vecPatches, int itime,
         for( unsigned int idim=0; idim<3; idim++ ) {
             if( write_momentum[idim] ) {
                 #pragma omp barrier
-                fill_buffer(vecPatches, nDim_particle+idim, data_double);
+                fill_buffer<double,particle_real>(vecPatches, ireal+idim, data_double);
                 #pragma omp master
                 write_component( momentum_group, xyz.substr(idim,1).c_str(), data_double[0], H5T_NATIVE_DOUBLE, file_space, mem_space, plist, SMILEI_UNIT_MOMENTUM, nParticles_global );
             }
@@ -414,12 +417,12 @@ void DiagnosticTrack::run( SmileiMPI* smpi, VectorPatch& vecPatches, int itime,
     if( write_chi )
     {
         #pragma omp barrier
-// Position old exists in this case
-#ifdef  __DEBUG
-        fill_buffer(vecPatches, nDim_particle+3+3+1, data_double);
+// Position old exists in this case, among the doubles
+#if defined(__DEBUG) && !defined(__COMPACT_PARTICLES)
+        fill_buffer<double,particle_real>(vecPatches, ireal+3+3+1, data_double);
 // Else, position old does not exist
 #else
-        fill_buffer(vecPatches, nDim_particle+3+1, data_double);
+        fill_buffer<double,particle_real>(vecPatches, ireal+3+1, data_double);
 #endif
         #pragma omp master
         write_scalar( species_group, "chi", data_double[0], H5T_NATIVE_DOUBLE, file_space, mem_space, plist, SMILEI_UNIT_NONE, nParticles_global );
@@ -548,11 +551,11 @@ void DiagnosticTrack::setIDs(Particles& particles)
 }
 
 
-template<typename T>
+template<typename T, typename U>
 void DiagnosticTrack::fill_buffer(VectorPatch& vecPatches, unsigned int iprop, vector<T>& buffer)
 {
     unsigned int patch_nParticles, i, j, nPatches=vecPatches.size();
-    vector<T>* property = NULL;
+    particle_property<U>* property = NULL;
 
     if( has_filter ) {
         #pragma omp for schedule(runtime)
@@ -34,8 +34,8 @@ public :
     //! Get disk footprint of current diagnostic
     uint64_t getDiskFootPrint(int istart, int istop, Patch* patch) override;
     
-    //! Fills a buffer with the required particle property
-    template<typename T> void fill_buffer(VectorPatch& vecPatches, unsigned int iprop, std::vector<T>& buffer);
+    //! Fills a buffer with the required particle property (stored in the particles as type U)
+    template<typename T, typename U=T> void fill_buffer(VectorPatch& vecPatches, unsigned int iprop, std::vector<T>& buffer);
     
     //! Write a scalar dataset with the given buffer
     template<typename T> void write_scalar( hid_t, std::string, T&, hid_t, hid_t, hid_t, hid_t, unsigned int, unsigned int );
@@ -0,0 +1,109 @@
+
+#include "MA_Solver3D_normTiled.h"
+
+#include <algorithm>
+
+#include "ElectroMagn.h"
+#include "Field3D.h"
+
+MA_Solver3D_normTiled::MA_Solver3D_normTiled(Params &params)
+: Solver3D(params)
+{
+    // A tile holds the rows of 9 fields on 2 consecutive x-planes: keep it within 256 kB
+    tile_y = std::max( 1u, (unsigned int)( 256*1024 / ( 9*2*nz_d*sizeof(double) ) ) );
+}
+
+MA_Solver3D_normTiled::~MA_Solver3D_normTiled()
+{
+}
+
+void MA_Solver3D_normTiled::operator() ( ElectroMagn* fields )
+{
+    // Flat storage of the fields
+    double* Ex = fields->Ex_->data();
+    double* Ey = fields->Ey_->data();
+    double* Ez = fields->Ez_->data();
+    double* Bx = fields->Bx_->data();
+    double* By = fields->By_->data();
+    double* Bz = fields->Bz_->data();
+    double* Jx = fields->Jx_->data();
+    double* Jy = fields->Jy_->data();
+    double* Jz = fields->Jz_->data();
+
+    // Strides along x and y: Ex^(d,p,p), Ey^(p,d,p), Ez^(p,p,d), Bx^(p,d,d), By^(d,p,d), Bz^(d,d,p)
+    const unsigned int sEx_x = ny_p*nz_p, sEx_y = nz_p;
+    const unsigned int sEy_x = ny_d*nz_p, sEy_y = nz_p;
+    const unsigned int sEz_x = ny_p*nz_d, sEz_y = nz_d;
+    const unsigned int sBx_x = ny_d*nz_d, sBx_y = nz_d;
+    const unsigned int sBy_x = ny_p*nz_d, sBy_y = nz_d;
+    const unsigned int sBz_x = ny_d*nz_p, sBz_y = nz_p;
+
+    // Points shared by the 3 components: i in [0,nx_p[, j in [0,ny_p[, k in [0,nz_p[
+    for (unsigned int j0=0 ; j0<ny_p ; j0+=tile_y) {
+        unsigned int j1 = std::min( j0+tile_y, ny_p );
+        for (unsigned int i=0 ; i<nx_p ; i++) {
+            for (unsigned int j=j0 ; j<j1 ; j++) {
+                double* __restrict__ ex = Ex + i*sEx_x + j*sEx_y;
+                double* __restrict__ ey = Ey + i*sEy_x + j*sEy_y;
+                double* __restrict__ ez = Ez + i*sEz_x + j*sEz_y;
+                const double* __restrict__ jx = Jx + i*sEx_x + j*sEx_y;
+                const double* __restrict__ jy = Jy + i*sEy_x + j*sEy_y;
+                const double* __restrict__ jz = Jz + i*sEz_x + j*sEz_y;
+                const double* __restrict__ bx    = Bx + i*sBx_x + j*sBx_y;
+                const double* __restrict__ bx_jp = bx + sBx_y;
+                const double* __restrict__ by    = By + i*sBy_x + j*sBy_y;
+                const double* __restrict__ by_ip = by + sBy_x;
+                const double* __restrict__ bz    = Bz + i*sBz_x + j*sBz_y;
+                const double* __restrict__ bz_jp = bz + sBz_y;
+                const double* __restrict__ bz_ip = bz + sBz_x;
+                #pragma omp simd
+                for (unsigned int k=0 ; k<nz_p ; k++) {
+                    ex[k] += -dt*jx[k]
+                    +        dt_ov_dy * ( bz_jp[k] - bz[k] )
+                    -        dt_ov_dz * ( by[k+1] - by[k] );
+                    ey[k] += -dt*jy[k]
+                    -        dt_ov_dx * ( bz_ip[k] - bz[k] )
+                    +        dt_ov_dz * ( bx[k+1] - bx[k] );
+                    ez[k] += -dt*jz[k]
+                    +        dt_ov_dx * ( by_ip[k] - by[k] )
+                    -        dt_ov_dy * ( bx_jp[k] - bx[k] );
+                }
+                // Ez also at k=nz_p
+                ez[nz_p] += -dt*jz[nz_p]
+                +           dt_ov_dx * ( by_ip[nz_p] - by[nz_p] )
+                -           dt_ov_dy * ( bx_jp[nz_p] - bx[nz_p] );
+            }
+        }
+    }
+
+    // Electric field Ex^(d,p,p) at i=nx_p
+    for (unsigned int j=0 ; j<ny_p ; j++) {
+        double* __restrict__ ex = Ex + nx_p*sEx_x + j*sEx_y;
+        const double* __restrict__ jx    = Jx + nx_p*sEx_x + j*sEx_y;
+        const double* __restrict__ by    = By + nx_p*sBy_x + j*sBy_y;
+        const double* __restrict__ bz    = Bz + nx_p*sBz_x + j*sBz_y;
+        const double* __restrict__ bz_jp = bz + sBz_y;
+        #pragma omp simd
+        for (unsigned int k=0 ; k<nz_p ; k++) {
+            ex[k] += -dt*jx[k]
+            +        dt_ov_dy * ( bz_jp[k] - bz[k] )
+            -        dt_ov_dz * ( by[k+1] - by[k] );
+        }
+    }
+
+    // Electric field Ey^(p,d,p) at j=ny_p
+    for (unsigned int i=0 ; i<nx_p ; i++) {
+        double* __restrict__ ey = Ey + i*sEy_x + ny_p*sEy_y;
+        const double* __restrict__ jy    = Jy + i*sEy_x + ny_p*sEy_y;
+        const double* __restrict__ bx    = Bx + i*sBx_x + ny_p*sBx_y;
+        const double* __restrict__ bz    = Bz + i*sBz_x + ny_p*sBz_y;
+        const double* __restrict__ bz_ip = bz + sBz_x;
+        #pragma omp simd
+        for (unsigned int k=0 ; k<nz_p ; k++) {
+            ey[k] += -dt*jy[k]
+            -        dt_ov_dx * ( bz_ip[k] - bz[k] )
+            +        dt_ov_dz * ( bx[k+1] - bx[k] );
+        }
+    }
+
+}
@@ -0,0 +1,28 @@
+#ifndef MA_SOLVER3D_NORMTILED_H
+#define MA_SOLVER3D_NORMTILED_H
+
+#include "Solver3D.h"
+class ElectroMagn;
+
+//  --------------------------------------------------------------------------------------------------------------------
+//! Class MA_Solver3D_normTiled: Maxwell-Ampere solver working on the flat field storage.
+//! The three E components are updated in a single sweep, blocked along y so that the
+//! planes i and i+1 of the tile stay in cache, with a vectorized inner loop along z.
+//  --------------------------------------------------------------------------------------------------------------------
+class MA_Solver3D_normTiled : public Solver3D
+{
+
+public:
+    MA_Solver3D_normTiled(Params &params);
+    virtual ~MA_Solver3D_normTiled();
+
+    //! Overloading of () operator
+    virtual void operator()( ElectroMagn* fields);
+
+protected:
+    //! Number of y-rows per tile
+    unsigned int tile_y;
+
+};//END class
+
+#endif
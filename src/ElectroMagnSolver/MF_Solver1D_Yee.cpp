@@ -1,6 +1,8 @@
 
 #include "MF_Solver1D_Yee.h"
 
+#include <algorithm>
+
 #include "ElectroMagn.h"
 #include "Field1D.h"
 
@@ -14,6 +16,13 @@ MF_Solver1D_Yee::~MF_Solver1D_Yee()
 }
 
 void MF_Solver1D_Yee::operator() ( ElectroMagn* fields )
+{
+    unsigned int imin[3] = { 0, 0, 0 };
+    unsigned int imax[3] = { nx_d, 1, 1 };
+    solveBox( fields, imin, imax );
+}
+
+void MF_Solver1D_Yee::solveBox( ElectroMagn* fields, unsigned int imin[3], unsigned int imax[3] )
 {
     Field1D* Ey1D   = static_cast<Field1D*>(fields->Ey_);
     Field1D* Ez1D   = static_cast<Field1D*>(fields->Ez_);
@@ -25,10 +34,9 @@ void MF_Solver1D_Yee::operator() ( ElectroMagn* fields )
     // ---------------------
     // NB: bx is given in 1d and defined when initializing the fields (here put to 0)
     // Transverse fields  by & bz are defined on the dual grid
-    //for (unsigned int ix=1 ; ix<nx_p ; ix++) {
-    for (unsigned int ix=1 ; ix<nx_d-1 ; ix++) {
+    unsigned int ix0 = std::max( 1u, imin[0] ), ix1 = std::min( nx_d-1, imax[0] );
+    for (unsigned int ix=ix0 ; ix<ix1 ; ix++) {
         (*By1D)(ix)= (*By1D)(ix) + dt_ov_dx * ( (*Ez1D)(ix) - (*Ez1D)(ix-1)) ;
         (*Bz1D)(ix)= (*Bz1D)(ix) - dt_ov_dx * ( (*Ey1D)(ix) - (*Ey1D)(ix-1)) ;
     } 
 }
-
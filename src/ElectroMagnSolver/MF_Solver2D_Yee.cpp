@@ -1,6 +1,8 @@
 
 #include "MF_Solver2D_Yee.h"
 
+#include <algorithm>
+
 #include "ElectroMagn.h"
 #include "Field2D.h"
 
@@ -17,6 +19,13 @@ MF_Solver2D_Yee::~MF_Solver2D_Yee()
 }
 
 void MF_Solver2D_Yee::operator() ( ElectroMagn* fields )
+{
+    unsigned int imin[3] = { 0, 0, 0 };
+    unsigned int imax[3] = { nx_d, ny_d, 1 };
+    solveBox( fields, imin, imax );
+}
+
+void MF_Solver2D_Yee::solveBox( ElectroMagn* fields, unsigned int imin[3], unsigned int imax[3] )
 {
     // Static-cast of the fields
     Field2D* Ex2D;
@@ -32,40 +41,31 @@ void MF_Solver2D_Yee::operator() ( ElectroMagn* fields )
     Field2D* Bx2D = static_cast<Field2D*>(fields->Bx_);
     Field2D* By2D = static_cast<Field2D*>(fields->By_);
     Field2D* Bz2D = static_cast<Field2D*>(fields->Bz_);
-    
-    // Magnetic field Bx^(p,d)
-    //cout << "nx_p,nx_d-1" << nx_p << " " << nx_d-1 ;
-    //{
-    {
-        #pragma omp simd
-        for (unsigned int j=1 ; j<ny_d-1 ; j++) {
-            (*Bx2D)(0,j) -= dt_ov_dy * ( (*Ez2D)(0,j) - (*Ez2D)(0,j-1) );
-        }
-    }
-    //    for (unsigned int i=0 ; i<nx_p;  i++) {
-    for (unsigned int i=1 ; i<nx_d-1;  i++) {
+
+    // Bounds of the box for the primal (p) and dual (d) components
+    unsigned int i1 = std::min( nx_d-1, imax[0] );
+    unsigned int j0_p = imin[1], j1_p = std::min( ny_p, imax[1] );
+    unsigned int j0_d = std::max( 1u, imin[1] ), j1_d = std::min( ny_d-1, imax[1] );
+
+    for (unsigned int i=imin[0] ; i<i1;  i++) {
+        // Magnetic field Bx^(p,d)
         #pragma omp simd
-        for (unsigned int j=1 ; j<ny_d-1 ; j++) {
+        for (unsigned int j=j0_d ; j<j1_d ; j++) {
             (*Bx2D)(i,j) -= dt_ov_dy * ( (*Ez2D)(i,j) - (*Ez2D)(i,j-1) );
         }
-        //    }
-        
+        if (i==0) continue;
+
         // Magnetic field By^(d,p)
-        //    for (unsigned int i=1 ; i<nx_d-1 ; i++) {
         #pragma omp simd
-        for (unsigned int j=0 ; j<ny_p ; j++) {
+        for (unsigned int j=j0_p ; j<j1_p ; j++) {
             (*By2D)(i,j) += dt_ov_dx * ( (*Ez2D)(i,j) - (*Ez2D)(i-1,j) );
         }
-        //}
-        
+
         // Magnetic field Bz^(d,d)
-        //for (unsigned int i=1 ; i<nx_d-1 ; i++) {
         #pragma omp simd
-        for (unsigned int j=1 ; j<ny_d-1 ; j++) {
+        for (unsigned int j=j0_d ; j<j1_d ; j++) {
             (*Bz2D)(i,j) += dt_ov_dy * ( (*Ex2D)(i,j) - (*Ex2D)(i,j-1) )
             -               dt_ov_dx * ( (*Ey2D)(i,j) - (*Ey2D)(i-1,j) );
         }
     }
-    //}// end parallel
 }
-
@@ -1,6 +1,8 @@
 
 #include "MF_Solver3D_Yee.h"
 
+#include <algorithm>
+
 #include "ElectroMagn.h"
 #include "Field3D.h"
 
@@ -14,6 +16,13 @@ MF_Solver3D_Yee::~MF_Solver3D_Yee()
 }
 
 void MF_Solver3D_Yee::operator() ( ElectroMagn* fields )
+{
+    unsigned int imin[3] = { 0, 0, 0 };
+    unsigned int imax[3] = { nx_d, ny_d, nz_d };
+    solveBox( fields, imin, imax );
+}
+
+void MF_Solver3D_Yee::solveBox( ElectroMagn* fields, unsigned int imin[3], unsigned int imax[3] )
 {
     // Static-cast of the fields
     Field3D* Ex3D = static_cast<Field3D*>(fields->Ex_);
@@ -22,33 +31,40 @@ void MF_Solver3D_Yee::operator() ( ElectroMagn* fields )
     Field3D* Bx3D = static_cast<Field3D*>(fields->Bx_);
     Field3D* By3D = static_cast<Field3D*>(fields->By_);
     Field3D* Bz3D = static_cast<Field3D*>(fields->Bz_);
+
+    // Bounds of the box for the primal (p) and dual (d) components
+    unsigned int i0_p = imin[0], i1_p = std::min( nx_p, imax[0] );
+    unsigned int j0_p = imin[1], j1_p = std::min( ny_p, imax[1] );
+    unsigned int k0_p = imin[2], k1_p = std::min( nz_p, imax[2] );
+    unsigned int i0_d = std::max( 1u, imin[0] ), i1_d = std::min( nx_d-1, imax[0] );
+    unsigned int j0_d = std::max( 1u, imin[1] ), j1_d = std::min( ny_d-1, imax[1] );
+    unsigned int k0_d = std::max( 1u, imin[2] ), k1_d = std::min( nz_d-1, imax[2] );
     
     // Magnetic field Bx^(p,d,d)
-    for (unsigned int i=0 ; i<nx_p;  i++) {
-        for (unsigned int j=1 ; j<ny_d-1 ; j++) {
-            for (unsigned int k=1 ; k<nz_d-1 ; k++) {
+    for (unsigned int i=i0_p ; i<i1_p;  i++) {
+        for (unsigned int j=j0_d ; j<j1_d ; j++) {
+            for (unsigned int k=k0_d ; k<k1_d ; k++) {
                 (*Bx3D)(i,j,k) += -dt_ov_dy * ( (*Ez3D)(i,j,k) - (*Ez3D)(i,j-1,k) ) + dt_ov_dz * ( (*Ey3D)(i,j,k) - (*Ey3D)(i,j,k-1) );
             }
         }
     }
         
     // Magnetic field By^(d,p,d)
-    for (unsigned int i=1 ; i<nx_d-1 ; i++) {
-        for (unsigned int j=0 ; j<ny_p ; j++) {
-            for (unsigned int k=1 ; k<nz_d-1 ; k++) {
+    for (unsigned int i=i0_d ; i<i1_d ; i++) {
+        for (unsigned int j=j0_p ; j<j1_p ; j++) {
+            for (unsigned int k=k0_d ; k<k1_d ; k++) {
                 (*By3D)(i,j,k) += -dt_ov_dz * ( (*Ex3D)(i,j,k) - (*Ex3D)(i,j,k-1) ) + dt_ov_dx * ( (*Ez3D)(i,j,k) - (*Ez3D)(i-1,j,k) );
             }
         }
     }
         
     // Magnetic field Bz^(d,d,p)
-    for (unsigned int i=1 ; i<nx_d-1 ; i++) {
-        for (unsigned int j=1 ; j<ny_d-1 ; j++) {
-            for (unsigned int k=0 ; k<nz_p ; k++) {
+    for (unsigned int i=i0_d ; i<i1_d ; i++) {
+        for (unsigned int j=j0_d ; j<j1_d ; j++) {
+            for (unsigned int k=k0_p ; k<k1_p ; k++) {
                 (*Bz3D)(i,j,k) += -dt_ov_dx * ( (*Ey3D)(i,j,k) - (*Ey3D)(i-1,j,k) ) + dt_ov_dy * ( (*Ex3D)(i,j,k) - (*Ex3D)(i,j-1,k) );
             }
         }
     }
 
 }
-
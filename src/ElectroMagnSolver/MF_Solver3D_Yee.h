@@ -18,6 +18,9 @@ public:
     //! Overloading of () operator
     virtual void operator()( ElectroMagn* fields);
 
+    virtual bool isSplittable() { return true; }
+    virtual void solveBox( ElectroMagn* fields, unsigned int imin[3], unsigned int imax[3] );
+
 protected:
 
 };//END class
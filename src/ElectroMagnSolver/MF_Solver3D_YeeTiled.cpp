@@ -0,0 +1,89 @@
+
+#include "MF_Solver3D_YeeTiled.h"
+
+#include <algorithm>
+
+#include "ElectroMagn.h"
+#include "Field3D.h"
+
+MF_Solver3D_YeeTiled::MF_Solver3D_YeeTiled(Params &params)
+: Solver3D(params)
+{
+    // A tile holds the rows of 6 fields on 2 consecutive x-planes: keep it within 256 kB
+    tile_y = std::max( 1u, (unsigned int)( 256*1024 / ( 6*2*nz_d*sizeof(double) ) ) );
+}
+
+MF_Solver3D_YeeTiled::~MF_Solver3D_YeeTiled()
+{
+}
+
+void MF_Solver3D_YeeTiled::operator() ( ElectroMagn* fields )
+{
+    // Flat storage of the fields
+    double* Ex = fields->Ex_->data();
+    double* Ey = fields->Ey_->data();
+    double* Ez = fields->Ez_->data();
+    double* Bx = fields->Bx_->data();
+    double* By = fields->By_->data();
+    double* Bz = fields->Bz_->data();
+
+    // Strides along x and y: Ex^(d,p,p), Ey^(p,d,p), Ez^(p,p,d), Bx^(p,d,d), By^(d,p,d), Bz^(d,d,p)
+    const unsigned int sEx_x = ny_p*nz_p, sEx_y = nz_p;
+    const unsigned int sEy_x = ny_d*nz_p, sEy_y = nz_p;
+    const unsigned int sEz_x = ny_p*nz_d, sEz_y = nz_d;
+    const unsigned int sBx_x = ny_d*nz_d, sBx_y = nz_d;
+    const unsigned int sBy_x = ny_p*nz_d, sBy_y = nz_d;
+    const unsigned int sBz_x = ny_d*nz_p, sBz_y = nz_p;
+
+    // Points shared by the 3 components: i in [1,nx_p[, j in [1,ny_p[, k in [1,nz_p[
+    for (unsigned int j0=1 ; j0<ny_p ; j0+=tile_y) {
+        unsigned int j1 = std::min( j0+tile_y, ny_p );
+        for (unsigned int i=1 ; i<nx_p ; i++) {
+            for (unsigned int j=j0 ; j<j1 ; j++) {
+                double* __restrict__ bx = Bx + i*sBx_x + j*sBx_y;
+                double* __restrict__ by = By + i*sBy_x + j*sBy_y;
+                double* __restrict__ bz = Bz + i*sBz_x + j*sBz_y;
+                const double* __restrict__ ex    = Ex + i*sEx_x + j*sEx_y;
+                const double* __restrict__ ex_jm = ex - sEx_y;
+                const double* __restrict__ ey    = Ey + i*sEy_x + j*sEy_y;
+                const double* __restrict__ ey_im = ey - sEy_x;
+                const double* __restrict__ ez    = Ez + i*sEz_x + j*sEz_y;
+                const double* __restrict__ ez_jm = ez - sEz_y;
+                const double* __restrict__ ez_im = ez - sEz_x;
+                // Bz also at k=0
+                bz[0] += -dt_ov_dx * ( ey[0] - ey_im[0] ) + dt_ov_dy * ( ex[0] - ex_jm[0] );
+                #pragma omp simd
+                for (unsigned int k=1 ; k<nz_p ; k++) {
+                    bx[k] += -dt_ov_dy * ( ez[k] - ez_jm[k] ) + dt_ov_dz * ( ey[k] - ey[k-1] );
+                    by[k] += -dt_ov_dz * ( ex[k] - ex[k-1] ) + dt_ov_dx * ( ez[k] - ez_im[k] );
+                    bz[k] += -dt_ov_dx * ( ey[k] - ey_im[k] ) + dt_ov_dy * ( ex[k] - ex_jm[k] );
+                }
+            }
+        }
+    }
+
+    // Magnetic field Bx^(p,d,d) at i=0
+    for (unsigned int j=1 ; j<ny_p ; j++) {
+        double* __restrict__ bx = Bx + j*sBx_y;
+        const double* __restrict__ ey    = Ey + j*sEy_y;
+        const double* __restrict__ ez    = Ez + j*sEz_y;
+        const double* __restrict__ ez_jm = ez - sEz_y;
+        #pragma omp simd
+        for (unsigned int k=1 ; k<nz_p ; k++) {
+            bx[k] += -dt_ov_dy * ( ez[k] - ez_jm[k] ) + dt_ov_dz * ( ey[k] - ey[k-1] );
+        }
+    }
+
+    // Magnetic field By^(d,p,d) at j=0
+    for (unsigned int i=1 ; i<nx_p ; i++) {
+        double* __restrict__ by = By + i*sBy_x;
+        const double* __restrict__ ex    = Ex + i*sEx_x;
+        const double* __restrict__ ez    = Ez + i*sEz_x;
+        const double* __restrict__ ez_im = ez - sEz_x;
+        #pragma omp simd
+        for (unsigned int k=1 ; k<nz_p ; k++) {
+            by[k] += -dt_ov_dz * ( ex[k] - ex[k-1] ) + dt_ov_dx * ( ez[k] - ez_im[k] );
+        }
+    }
+
+}
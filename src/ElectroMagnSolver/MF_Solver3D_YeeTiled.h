@@ -0,0 +1,29 @@
+#ifndef MF_SOLVER3D_YEETILED_H
+#define MF_SOLVER3D_YEETILED_H
+
+#include "Solver3D.h"
+class ElectroMagn;
+
+//  --------------------------------------------------------------------------------------------------------------------
+//! Class MF_Solver3D_YeeTiled: Yee Maxwell-Faraday solver working on the flat field storage.
+//! The three B components are updated in a single sweep, blocked along y so that the
+//! planes i and i-1 of the tile stay in cache, with a vectorized inner loop along z.
+//  --------------------------------------------------------------------------------------------------------------------
+class MF_Solver3D_YeeTiled : public Solver3D
+{
+
+public:
+    //! Creator for MF_Solver3D_YeeTiled
+    MF_Solver3D_YeeTiled(Params &params);
+    virtual ~MF_Solver3D_YeeTiled();
+
+    //! Overloading of () operator
+    virtual void operator()( ElectroMagn* fields);
+
+protected:
+    //! Number of y-rows per tile
+    unsigned int tile_y;
+
+};//END class
+
+#endif
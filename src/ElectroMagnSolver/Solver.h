@@ -2,6 +2,7 @@
 #define SOLVER_H
 
 #include "Params.h"
+#include "Tools.h"
 
 class ElectroMagn;
 
@@ -20,6 +21,15 @@ public:
     //! Overloading of () operator
     virtual void operator()( ElectroMagn* fields) = 0;
 
+    //! True if the solver can be applied box by box (see solveBox)
+    virtual bool isSplittable() { return false; }
+    //! Applies the solver on the nodes of the box [imin, imax[ only (indices on the dual grid, the
+    //! unused dimensions are ignored). Applied on the boxes of a partition of the patch, it gives the
+    //! same result as operator().
+    virtual void solveBox( ElectroMagn* fields, unsigned int imin[3], unsigned int imax[3] ) {
+        ERROR( "This solver cannot be applied on a part of the patch" );
+    };
+
 protected:
 
 };//END class
@@ -5,10 +5,12 @@
 #include "MA_Solver2D_norm.h"
 #include "MA_Solver2D_Friedman.h"
 #include "MA_Solver3D_norm.h"
+#include "MA_Solver3D_normTiled.h"
 #include "MA_SolverAM_norm.h"
 #include "MF_Solver1D_Yee.h"
 #include "MF_Solver2D_Yee.h"
 #include "MF_Solver3D_Yee.h"
+#include "MF_Solver3D_YeeTiled.h"
 #include "MF_SolverAM_Yee.h"
 #include "MF_Solver2D_Grassi.h"
 #include "MF_Solver2D_GrassiSpL.h"
@@ -52,7 +54,11 @@ public:
             if ( params.is_pxr == false ) {
                 if (params.is_spectral)
                     WARNING( "PS solveur are not available without Picsar" );
-                solver = new MA_Solver3D_norm(params);
+                if (params.maxwell_sol == "YeeTiled") {
+                    solver = new MA_Solver3D_normTiled(params);
+                } else {
+                    solver = new MA_Solver3D_norm(params);
+                }
             }
             else if ( ( params.is_pxr == true ) && ( params.is_spectral == false ) )
                 solver = new PXR_Solver3D_FDTD(params);
@@ -103,6 +109,9 @@ public:
                 if (params.maxwell_sol == "Yee") {
                     solver = new MF_Solver3D_Yee(params);
                 }
+                else if (params.maxwell_sol == "YeeTiled") {
+                    solver = new MF_Solver3D_YeeTiled(params);
+                }
                 else if(params.maxwell_sol == "Lehe" ){
                     solver = new MF_Solver3D_Lehe(params);
                 }
@@ -14,10 +14,10 @@ class InterpolatorAM2Order : public InterpolatorAM
 
 public:
     InterpolatorAM2Order(Params&, Patch*);
-    ~InterpolatorAM2Order() override final {};
+    ~InterpolatorAM2Order() override {};
 
     inline void operator() (ElectroMagn* EMfields, Particles &particles, int ipart, int nparts, double* ELoc, double* BLoc);
-    void operator() (ElectroMagn* EMfields, Particles &particles, SmileiMPI* smpi, int *istart, int *iend, int ithread, int ipart_ref = 0) override final ;
+    void operator() (ElectroMagn* EMfields, Particles &particles, SmileiMPI* smpi, int *istart, int *iend, int ithread, int ipart_ref = 0) override ;
     void operator() (ElectroMagn* EMfields, Particles &particles, SmileiMPI* smpi, int *istart, int *iend, int ithread, LocalFields* JLoc, double* RhoLoc) override final ;
     void operator() (ElectroMagn* EMfields, Particles &particles, double *buffer, int offset, std::vector<unsigned int> * selection) override final;
 
@@ -113,7 +113,7 @@ public:
         }
         return interp_res;
     }; 
-private:
+protected:
     // Last prim index computed
     int ip_, jp_;
     // Last dual index computed
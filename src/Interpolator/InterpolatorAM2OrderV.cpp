@@ -0,0 +1,169 @@
+#include "InterpolatorAM2OrderV.h"
+
+#include <cmath>
+#include <iostream>
+#include <complex>
+
+#include "ElectroMagn.h"
+#include "ElectroMagnAM.h"
+#include "cField2D.h"
+#include "Particles.h"
+
+using namespace std;
+
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Creator for InterpolatorAM2OrderV
+// ---------------------------------------------------------------------------------------------------------------------
+InterpolatorAM2OrderV::InterpolatorAM2OrderV(Params &params, Patch *patch) : InterpolatorAM2Order(params, patch)
+{
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+// 2nd Order vectorized interpolation of the fields at the position of the particles of a cell (3 nodes are used)
+//   - the coefficients are computed once per particle and used for all modes
+//   - exp(-i m theta) is updated from one mode to the next
+// ---------------------------------------------------------------------------------------------------------------------
+void InterpolatorAM2OrderV::operator() (ElectroMagn* EMfields, Particles &particles, SmileiMPI* smpi, int *istart, int *iend, int ithread, int ipart_ref)
+{
+    if ( istart[0] == iend[0] ) return; //Don't treat empty cells.
+
+    int nparts( (smpi->dynamics_invgf[ithread]).size() );
+
+    double *Epart[3], *Bpart[3];
+
+    double *deltaO[2];
+    deltaO[0] = &(smpi->dynamics_deltaold[ithread][0]);
+    deltaO[1] = &(smpi->dynamics_deltaold[ithread][nparts]);
+    complex<double> *exp_m_theta_old = &(smpi->dynamics_thetaold[ithread][0]);
+
+    for (unsigned int k=0; k<3;k++) {
+        Epart[k]= &(smpi->dynamics_Epart[ithread][k*nparts]);
+        Bpart[k]= &(smpi->dynamics_Bpart[ithread][k*nparts]);
+    }
+
+    ElectroMagnAM* emAM = static_cast<ElectroMagnAM*>( EMfields );
+
+    int idx[2], idxO[2];
+    //Primal indices are constant over the all cell
+    idx[0]  = round( particles.position(0,*istart) * dl_inv_ );
+    idxO[0] = idx[0] - i_domain_begin;
+    idx[1]  = round( sqrt( particles.distance2_to_axis(*istart) ) * dr_inv_ );
+    idxO[1] = idx[1] - j_domain_begin;
+
+    double coeff[2][2][3][32];
+    int dual[2][32]; // Boolean indicating if the part has a dual indice equal to the primal one (dual=0) or if it is +1 (dual=1).
+    // exp(-i theta) and exp(-i m theta) of each particle
+    double e_re[32], e_im[32], em_re[32], em_im[32];
+
+    int vecSize = 32;
+
+    int cell_nparts( (int)iend[0]-(int)istart[0] );
+
+    for (int ivect=0 ; ivect < cell_nparts; ivect += vecSize ){
+
+        int np_computed = min(cell_nparts-ivect,vecSize);
+        int ipart0 = ivect+istart[0];
+
+        #pragma omp simd
+        for (int ipart=0 ; ipart<np_computed; ipart++ ){
+
+            double r = sqrt( particles.distance2_to_axis(ipart0+ipart) );
+            double pos[2];
+            pos[0] = particles.position(0,ipart0+ipart) * dl_inv_;
+            pos[1] = r * dr_inv_;
+
+            for (int i=0;i<2;i++) { // for L/R
+                dual [i][ipart] = ( pos[i] - (double)idx[i] >=0. );
+
+                for (int j=0;j<2;j++) { // for dual
+
+                    double delta   = pos[i] - (double)idx[i] + (double)j*(0.5-dual[i][ipart]);
+                    double delta2  = delta*delta;
+
+                    coeff[i][j][0][ipart]    =  0.5 * (delta2-delta+0.25);
+                    coeff[i][j][1][ipart]    =  (0.75 - delta2);
+                    coeff[i][j][2][ipart]    =  0.5 * (delta2+delta+0.25);
+
+                    if (j==0) deltaO[i][ipart0+ipart-ipart_ref] = delta;
+                }
+            }
+
+            e_re[ipart] =  particles.position(1,ipart0+ipart) / r;
+            e_im[ipart] = -particles.position(2,ipart0+ipart) / r;
+            exp_m_theta_old[ipart0+ipart-ipart_ref] = complex<double>( e_re[ipart], e_im[ipart] );
+
+            em_re[ipart] = 1.;
+            em_im[ipart] = 0.;
+            for (unsigned int k=0; k<3;k++) {
+                Epart[k][ipart0+ipart-ipart_ref] = 0.;
+                Bpart[k][ipart0+ipart-ipart_ref] = 0.;
+            }
+        }
+
+        for (unsigned int imode = 0; imode < nmodes ; imode++){
+
+            cField2D* El = emAM->El_[imode];
+            cField2D* Er = emAM->Er_[imode];
+            cField2D* Et = emAM->Et_[imode];
+            cField2D* Bl = emAM->Bl_m[imode];
+            cField2D* Br = emAM->Br_m[imode];
+            cField2D* Bt = emAM->Bt_m[imode];
+
+            #pragma omp simd
+            for (int ipart=0 ; ipart<np_computed; ipart++ ){
+
+                // exp(-i m theta) from exp(-i (m-1) theta)
+                if (imode > 0) {
+                    double tmp   = em_re[ipart]*e_re[ipart] - em_im[ipart]*e_im[ipart];
+                    em_im[ipart] = em_re[ipart]*e_im[ipart] + em_im[ipart]*e_re[ipart];
+                    em_re[ipart] = tmp;
+                }
+
+                double* coeffxp = &(coeff[0][0][1][ipart]);
+                double* coeffxd = &(coeff[0][1][1][ipart]);
+                double* coeffyp = &(coeff[1][0][1][ipart]);
+                double* coeffyd = &(coeff[1][1][1][ipart]);
+                int ip = idxO[0];
+                int id = idxO[0] + dual[0][ipart];
+                int jp = idxO[1];
+                int jd = idxO[1] + dual[1][ipart];
+
+                complex<double> interp_res;
+                int ipart_buf = ipart0+ipart-ipart_ref;
+
+                //El(dual, primal)
+                interp_res = compute_v( coeffxd, coeffyp, El, id, jp );
+                Epart[0][ipart_buf] += real(interp_res)*em_re[ipart] - imag(interp_res)*em_im[ipart];
+                //Er(primal, dual)
+                interp_res = compute_v( coeffxp, coeffyd, Er, ip, jd );
+                Epart[1][ipart_buf] += real(interp_res)*em_re[ipart] - imag(interp_res)*em_im[ipart];
+                //Et(primal, primal)
+                interp_res = compute_v( coeffxp, coeffyp, Et, ip, jp );
+                Epart[2][ipart_buf] += real(interp_res)*em_re[ipart] - imag(interp_res)*em_im[ipart];
+                //Bl(primal, dual)
+                interp_res = compute_v( coeffxp, coeffyd, Bl, ip, jd );
+                Bpart[0][ipart_buf] += real(interp_res)*em_re[ipart] - imag(interp_res)*em_im[ipart];
+                //Br(dual, primal)
+                interp_res = compute_v( coeffxd, coeffyp, Br, id, jp );
+                Bpart[1][ipart_buf] += real(interp_res)*em_re[ipart] - imag(interp_res)*em_im[ipart];
+                //Bt(dual, dual)
+                interp_res = compute_v( coeffxd, coeffyd, Bt, id, jd );
+                Bpart[2][ipart_buf] += real(interp_res)*em_re[ipart] - imag(interp_res)*em_im[ipart];
+            }
+        }
+
+        //Translate field into the cartesian y,z coordinates
+        #pragma omp simd
+        for (int ipart=0 ; ipart<np_computed; ipart++ ){
+            int ipart_buf = ipart0+ipart-ipart_ref;
+            double tmp = e_re[ipart] * Epart[1][ipart_buf] + e_im[ipart] * Epart[2][ipart_buf];
+            Epart[2][ipart_buf] = -e_im[ipart] * Epart[1][ipart_buf] + e_re[ipart] * Epart[2][ipart_buf];
+            Epart[1][ipart_buf] = tmp;
+            tmp = e_re[ipart] * Bpart[1][ipart_buf] + e_im[ipart] * Bpart[2][ipart_buf];
+            Bpart[2][ipart_buf] = -e_im[ipart] * Bpart[1][ipart_buf] + e_re[ipart] * Bpart[2][ipart_buf];
+            Bpart[1][ipart_buf] = tmp;
+        }
+    }
+
+} // END InterpolatorAM2OrderV
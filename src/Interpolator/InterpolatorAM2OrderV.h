@@ -0,0 +1,37 @@
+#ifndef INTERPOLATORAM2ORDERV_H
+#define INTERPOLATORAM2ORDERV_H
+
+
+#include "InterpolatorAM2Order.h"
+#include "cField2D.h"
+
+
+//  --------------------------------------------------------------------------------------------------------------------
+//! Class for vectorized 2nd order interpolator for AM simulations (particles sorted per cell)
+//  --------------------------------------------------------------------------------------------------------------------
+class InterpolatorAM2OrderV : public InterpolatorAM2Order
+{
+
+public:
+    InterpolatorAM2OrderV(Params&, Patch*);
+    ~InterpolatorAM2OrderV() override final {};
+
+    // Probes and tracked particles are interpolated one by one (InterpolatorAM2Order)
+    using InterpolatorAM2Order::operator();
+    // Sorting
+    void operator() (ElectroMagn* EMfields, Particles &particles, SmileiMPI* smpi, int *istart, int *iend, int ithread, int ipart_ref = 0) override final;
+
+    //! Interpolation of the complex field f, the coefficients of each particle of the vector being stored every 32 values
+    inline std::complex<double> compute_v( double* coeffx, double* coeffy, cField2D* f, int idx, int idy) {
+        std::complex<double> interp_res(0.);
+        for (int iloc=-1 ; iloc<2 ; iloc++) {
+            for (int jloc=-1 ; jloc<2 ; jloc++) {
+                interp_res += *(coeffx+iloc*32) * *(coeffy+jloc*32) * (*f)(idx+iloc,idy+jloc);
+            }
+        }
+        return interp_res;
+    };
+
+};//END class
+
+#endif
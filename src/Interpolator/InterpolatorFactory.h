@@ -15,6 +15,7 @@
 #include "Interpolator2D2OrderV.h"
 #include "Interpolator3D2OrderV.h"
 #include "Interpolator3D4OrderV.h"
+#include "InterpolatorAM2OrderV.h"
 #endif
 
 #include "Params.h"
@@ -72,7 +73,12 @@ public:
         // AM simulation
         // ---------------
         else if ( params.geometry == "AMcylindrical" ) {
-            Interp = new InterpolatorAM2Order(params, patch);
+            if (!vectorization)
+                Interp = new InterpolatorAM2Order(params, patch);
+#ifdef _VECTO
+            else
+                Interp = new InterpolatorAM2OrderV(params, patch);
+#endif
         }
 
         else {
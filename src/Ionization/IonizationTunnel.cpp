@@ -8,6 +8,7 @@
 
 using namespace std;
 
+map<unsigned int, vector<double> > IonizationTunnel::ln_rate_tables_;
 
 
 IonizationTunnel::IonizationTunnel(Params& params, Species * species) : Ionization(params, species) {
@@ -41,6 +42,27 @@ IonizationTunnel::IonizationTunnel(Params& params, Species * species) : Ionizati
         gamma_tunnel[Z] = 2.0 * pow(2.0*Potential[Z],1.5);
     }
     
+    // Tabulation of the rates, once per atomic number
+    #pragma omp critical (IonizationTunnel_tables)
+    {
+        vector<double> &table = ln_rate_tables_[atomic_number_];
+        if( table.empty() ) {
+            table.resize( atomic_number_*table_size_ );
+            for (unsigned int Z=0 ; Z<atomic_number_ ; Z++) {
+                for (unsigned int i=0 ; i<table_size_ ; i++) {
+                    int k = min_exponent_ + (int)( i/points_per_octave_ );
+                    double m = 0.5 + (double)( i%points_per_octave_ )/( 2*points_per_octave_ );
+                    double delta = gamma_tunnel[Z] / sqrt( ldexp( m, k ) );
+                    table[Z*table_size_+i] = log(beta_tunnel[Z]) - delta*one_third + alpha_tunnel[Z]*log(delta);
+                }
+            }
+        }
+        ln_rate_ = &table;
+    }
+    
+    IonizRate_tunnel.resize(atomic_number_);
+    Dnom_tunnel.resize(atomic_number_);
+    
     DEBUG("Finished Creating the Tunnel Ionizaton class");
 
 }
@@ -50,8 +72,7 @@ IonizationTunnel::IonizationTunnel(Params& params, Species * species) : Ionizati
 void IonizationTunnel::operator() (Particles* particles, unsigned int ipart_min, unsigned int ipart_max, vector<double> *Epart, Patch* patch, Projector* Proj, int ipart_ref) {
     
     unsigned int Z, Zp1, newZ, k_times;
-    double TotalIonizPot, E, invE, factorJion, delta, ran_p, Mult, D_sum, P_sum, Pint_tunnel;
-    vector<double> IonizRate_tunnel(atomic_number_), Dnom_tunnel(atomic_number_);
+    double TotalIonizPot, E2, factorJion, ran_p, Mult, D_sum, P_sum, Pint_tunnel;
     LocalFields Jion;
     double factorJion_0 = au_to_mec2 * EC_to_au*EC_to_au * invdt;
     
@@ -60,29 +81,85 @@ void IonizationTunnel::operator() (Particles* particles, unsigned int ipart_min,
     double* Ey = &( (*Epart)[1*nparts] );
     double* Ez = &( (*Epart)[2*nparts] );
     
-    for( unsigned int ipart=ipart_min ; ipart<ipart_max; ipart++ ) {
+    int npart = (int)ipart_max - (int)ipart_min;
+    if (npart <= 0) return;
+    
+    // One random number per particle, drawn at once
+    ran_p_.resize(npart);
+    rate_dt_.resize(npart);
+    ionized_.resize(npart);
+    patch->rand_->uniform( &ran_p_[0], npart );
+    
+    // First pass (vectorized): ions ionized at least once during this timestep,
+    // i.e. electrons to be created
+    short* charge = &( particles->charge(0) );
+    double* ran = &ran_p_[0];
+    double* rate = &rate_dt_[0];
+    int* ionized = &ionized_[0];
+    int atomic_number = atomic_number_;
+    int ncandidates = 0;
+    int nionized = 0;
+    
+    #pragma omp simd reduction(+:ncandidates)
+    for( int ip=0 ; ip<npart; ip++ ) {
+        int ipart = ipart_min + ip - ipart_ref;
+        int Zs = charge[ipart_min + ip];
+        
+        // Square of the electric field normalized in atomic units
+        double E2 = EC_to_au*EC_to_au * ( Ex[ipart]*Ex[ipart] + Ey[ipart]*Ey[ipart] + Ez[ipart]*Ez[ipart] );
+        
+        // Fully ionized ions and negligible fields are skipped
+        int active = ( Zs < atomic_number ) && ( E2 >= 1e-20 );
+        double rate_dt = active ? ionization_rate( Zs, E2 )*dt : 0.;
+        
+        // The ion is ionized if 1-exp(-rate dt) exceeds ran for the last electron (single ionization),
+        // or 1-ran otherwise (start of the multiple ionization). As 1-exp(-rate dt) <= rate dt,
+        // most ions are rejected here without computing the exponential.
+        double threshold = ( Zs+1 == atomic_number ) ? ran[ip] : 1.0-ran[ip];
+        int is_candidate = active && ( rate_dt > threshold );
+        rate[ip] = rate_dt;
+        ionized[ip] = is_candidate;
+        ncandidates += is_candidate;
+    }
+    
+    // Exact test for the remaining candidates
+    for( int ip=0 ; ip<npart && ncandidates>0; ip++ ) {
+        if( !ionized[ip] ) continue;
+        ncandidates--;
+        int Zs = charge[ipart_min + ip];
+        double threshold = ( Zs+1 == atomic_number ) ? ran[ip] : 1.0-ran[ip];
+        ionized[ip] = ( 1.0-exp( -rate[ip] ) > threshold );
+        nionized += ionized[ip];
+    }
+    
+    if (nionized == 0) return;
+    
+    // All the new electrons are created at once
+    int idNew = new_electrons.size();
+    new_electrons.create_particles( nionized );
+    
+    // Second pass, on the ionized ions only: number of ionization events,
+    // ionization current and new electrons (variable weights are used)
+    for( int ip=0 ; ip<npart; ip++ ) {
+        
+        if (!ionized[ip]) continue;
+        
+        unsigned int ipart = ipart_min + ip;
         
         // Current charge state of the ion
         Z = (unsigned int)(particles->charge(ipart));
         
-        // If ion already fully ionized then skip
-        if (Z==atomic_number_) continue;
-        
-        // Absolute value of the electric field normalized in atomic units
-        E = EC_to_au * sqrt( pow(*(Ex+ipart-ipart_ref),2)
-                            +pow(*(Ey+ipart-ipart_ref),2)
-                            +pow(*(Ez+ipart-ipart_ref),2) );
-        if (E<1e-10) continue;
+        E2 = EC_to_au*EC_to_au * ( pow(*(Ex+ipart-ipart_ref),2)
+                                  +pow(*(Ey+ipart-ipart_ref),2)
+                                  +pow(*(Ez+ipart-ipart_ref),2) );
         
         // --------------------------------
         // Start of the Monte-Carlo routine
         // --------------------------------
         
-        invE = 1./E;
-        factorJion = factorJion_0 * invE*invE;
-        delta      = gamma_tunnel[Z]*invE;
-        ran_p = patch->xorshift32() * patch->xorshift32_invmax;
-        IonizRate_tunnel[Z] = beta_tunnel[Z] * exp( -delta*one_third + alpha_tunnel[Z]*log(delta));
+        factorJion = factorJion_0 / E2;
+        ran_p = ran[ip];
+        IonizRate_tunnel[Z] = rate[ip]/dt;
         
         // Total ionization potential (used to compute the ionization current)
         TotalIonizPot = 0.0;
@@ -92,12 +169,10 @@ void IonizationTunnel::operator() (Particles* particles, unsigned int ipart_min,
         Zp1=Z+1;
         
         if ( Zp1 == atomic_number_) {
-            // if ionization of the last electron: single ionization
-            // -----------------------------------------------------
-            if ( ran_p < 1.0 -exp(-IonizRate_tunnel[Z]*dt) ) {
-                TotalIonizPot += Potential[Z];
-                k_times        = 1;
-            }
+            // if ionization of the last electron: single ionization (selected in the first pass)
+            // -----------------------------------------------------------------------------------
+            TotalIonizPot += Potential[Z];
+            k_times        = 1;
             
         } else {
             // else : multiple ionization can occur in one time-step
@@ -112,9 +187,7 @@ void IonizationTunnel::operator() (Particles* particles, unsigned int ipart_min,
             //multiple ionization loop while Pint_tunnel < ran_p and still partial ionization
             while ((Pint_tunnel < ran_p) and (k_times < atomic_number_-Zp1)) {
                 newZ = Zp1+k_times;
-                delta = gamma_tunnel[newZ]*invE;
-                IonizRate_tunnel[newZ] = beta_tunnel[newZ]
-                *                        exp(-delta*one_third+alpha_tunnel[newZ]*log(delta));
+                IonizRate_tunnel[newZ] = ionization_rate( newZ, E2 );
                 D_sum = 0.0;
                 P_sum = 0.0;
                 Mult  *= IonizRate_tunnel[Z+k_times];
@@ -123,7 +196,7 @@ void IonizationTunnel::operator() (Particles* particles, unsigned int ipart_min,
                     D_sum += Dnom_tunnel[i];
                     P_sum += exp(-IonizRate_tunnel[Z+i]*dt)*Dnom_tunnel[i];
                 }
-                Dnom_tunnel[k_times+1] -= D_sum;
+                Dnom_tunnel[k_times+1]  = -D_sum;
                 P_sum                   = P_sum + Dnom_tunnel[k_times+1]*exp(-IonizRate_tunnel[newZ]*dt);
                 Pint_tunnel             = Pint_tunnel + P_sum*Mult;
                 
@@ -140,32 +213,25 @@ void IonizationTunnel::operator() (Particles* particles, unsigned int ipart_min,
         
         // Compute ionization current
         factorJion *= TotalIonizPot;
-        Jion.x = factorJion * *(Ex+ipart);
-        Jion.y = factorJion * *(Ey+ipart);
-        Jion.z = factorJion * *(Ez+ipart);
+        Jion.x = factorJion * *(Ex+ipart-ipart_ref);
+        Jion.y = factorJion * *(Ey+ipart-ipart_ref);
+        Jion.z = factorJion * *(Ez+ipart-ipart_ref);
         
         (*Proj)(patch->EMfields->Jx_, patch->EMfields->Jy_, patch->EMfields->Jz_, *particles, ipart, Jion);
         
-        // Creation of the new electrons
-        // (variable weights are used)
-        // -----------------------------
-        if (k_times !=0) {
-            new_electrons.create_particle();
-            //new_electrons.initialize( new_electrons.size()+1, new_electrons.dimension() );
-            int idNew = new_electrons.size() - 1;
-            for (unsigned int i=0; i<new_electrons.dimension(); i++) {
-                new_electrons.position(i,idNew)=particles->position(i, ipart);
-            }
-            for (unsigned int i=0; i<3; i++) {
-                new_electrons.momentum(i,idNew) = particles->momentum(i, ipart)*ionized_species_invmass;
-            }
-            new_electrons.weight(idNew)=double(k_times)*particles->weight(ipart);
-            new_electrons.charge(idNew)=-1;
-            
-            // Increase the charge of the particle
-            particles->charge(ipart) += k_times;
+        // Fill the new electron
+        for (unsigned int i=0; i<new_electrons.dimension(); i++) {
+            new_electrons.position(i,idNew)=particles->position(i, ipart);
+        }
+        for (unsigned int i=0; i<3; i++) {
+            new_electrons.momentum(i,idNew) = particles->momentum(i, ipart)*ionized_species_invmass;
         }
+        new_electrons.weight(idNew)=double(k_times)*particles->weight(ipart);
+        new_electrons.charge(idNew)=-1;
+        idNew++;
         
+        // Increase the charge of the particle
+        particles->charge(ipart) += k_times;
         
     } // Loop on particles
 }
@@ -2,7 +2,10 @@
 #define IONIZATIONTUNNEL_H
 
 #include <cmath>
+#include <cstdint>
+#include <cstring>
 
+#include <map>
 #include <vector>
 
 #include "Ionization.h"
@@ -28,6 +31,49 @@ private:
     
     double one_third;
     std::vector<double> alpha_tunnel, beta_tunnel, gamma_tunnel;
+    
+    //! Ionization rate of the charge state Z for the square E2 of the field (atomic units)
+    //! The tables are indexed with the exponent and mantissa of E2, without any log
+    inline double ionization_rate( unsigned int Z, double E2 ) const
+    {
+        // E2 = m 2^k with m in [0.5,1[
+        uint64_t bits;
+        std::memcpy( &bits, &E2, sizeof( double ) );
+        int k = (int)( ( bits >> 52 ) & 0x7ff ) - 1022;
+        bits = ( bits & 0x000fffffffffffffULL ) | 0x3fe0000000000000ULL;
+        double m;
+        std::memcpy( &m, &bits, sizeof( double ) );
+        
+        // Fields too weak to ionize
+        if( k < min_exponent_ ) {
+            return 0.;
+        }
+        // Fields beyond the table: exact rate
+        if( k >= max_exponent_ ) {
+            double delta = gamma_tunnel[Z]/sqrt( E2 );
+            return beta_tunnel[Z] * exp( -delta*one_third + alpha_tunnel[Z]*log( delta ) );
+        }
+        double x = ( m-0.5 ) * ( 2*points_per_octave_ );
+        int i = (int)x;
+        double w = x - (double)i;
+        const double *ln_rate = &( (*ln_rate_)[Z*table_size_ + (k-min_exponent_)*points_per_octave_ + i] );
+        return exp( ( 1.-w )*ln_rate[0] + w*ln_rate[1] );
+    }
+    
+    //! Logarithm of the ionization rates for each charge state, tabulated for E2 = m 2^k (atomic units)
+    //! on a uniform grid in m for each exponent k. Shared by the species of same atomic number.
+    const std::vector<double> *ln_rate_;
+    static std::map<unsigned int, std::vector<double> > ln_rate_tables_;
+    //! Range of the exponents of E2 (E from about 1e-4 to 1e4), and points per exponent
+    static const int min_exponent_ = -26;
+    static const int max_exponent_ = 27;
+    static const unsigned int points_per_octave_ = 128;
+    static const unsigned int table_size_ = (max_exponent_-min_exponent_)*points_per_octave_ + 1;
+    
+    //! Buffers reused between calls: random numbers, rates and ionized particles
+    std::vector<double> ran_p_, rate_dt_;
+    std::vector<int> ionized_;
+    std::vector<double> IonizRate_tunnel, Dnom_tunnel;
 };
 
 
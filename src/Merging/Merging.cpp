@@ -0,0 +1,33 @@
+// ----------------------------------------------------------------------------
+//! \file Merging.cpp
+//
+//! \brief This file contains the class functions for the generic class
+//!  Merging that reduces the number of macro-particles of a species.
+//
+// ----------------------------------------------------------------------------
+
+#include "Merging.h"
+
+// -----------------------------------------------------------------------------
+//! Constructor for Merging
+// input: simulation parameters & Species index
+//! \param params simulation parameters
+//! \param species Species index
+// -----------------------------------------------------------------------------
+Merging::Merging(Params& params, Species * species)
+{
+    mass_ = species->mass;
+
+    min_particles_per_cell_ = species->merge_min_particles_per_cell;
+
+    momentum_cell_size_ = species->merge_momentum_cell_size;
+
+    removed_particles = 0;
+}
+
+// -----------------------------------------------------------------------------
+//! Destructor for Merging
+// -----------------------------------------------------------------------------
+Merging::~Merging()
+{
+}
@@ -0,0 +1,72 @@
+// ----------------------------------------------------------------------------
+//! \file Merging.h
+//
+//! \brief This file contains the header for the generic class Merging
+//   that reduces the number of macro-particles of a species.
+//
+// ----------------------------------------------------------------------------
+
+#ifndef MERGING_H
+#define MERGING_H
+
+#include <vector>
+
+#include "Params.h"
+#include "Particles.h"
+#include "Species.h"
+
+//  ----------------------------------------------------------------------------
+//! Class Merging
+//  ----------------------------------------------------------------------------
+class Merging
+{
+
+    public:
+        //! Creator for Merging
+        Merging(Params& params, Species *species);
+        virtual ~Merging();
+
+        //! Overloading of () operator: merge the particles of a bin.
+        //! The particles to be removed get a null weight.
+        //! \param particles   particle object containing the particle
+        //!                    properties of the current species
+        //! \param cell_index  cell index of each particle of particles
+        //! \param istart      Index of the first particle
+        //! \param iend        Index of the last particle
+        virtual void operator() (
+                Particles &particles,
+                int * cell_index,
+                int istart,
+                int iend) = 0;
+
+        //! Return the number of particles removed since the last reset
+        unsigned int inline getRemovedParticles()
+        {
+            return removed_particles;
+        };
+
+        //! Reset the number of removed particles
+        void inline resetRemovedParticles()
+        {
+            removed_particles = 0;
+        };
+
+    protected:
+
+        //! Species mass (0 for photons)
+        double mass_;
+
+        //! Minimum number of particles in a cell for the merging to occur
+        unsigned int min_particles_per_cell_;
+
+        //! Number of momentum-space cells in each direction
+        std::vector<unsigned int> momentum_cell_size_;
+
+        //! Number of particles removed since the last reset
+        unsigned int removed_particles;
+
+    private:
+
+};//END class
+
+#endif
@@ -0,0 +1,52 @@
+// ----------------------------------------------------------------------------
+//! \file MergingFactory.h
+//
+//! \brief This file contains the header for the class MergingFactory that
+// manages the different particle merging methods.
+//
+// ----------------------------------------------------------------------------
+
+#ifndef MERGINGFACTORY_H
+#define MERGINGFACTORY_H
+
+#include "Merging.h"
+#include "MergingVranic.h"
+
+#include "Params.h"
+#include "Species.h"
+
+#include "Tools.h"
+
+//  --------------------------------------------------------------------------------------------------------------------
+//! Class MergingFactory
+//
+//  --------------------------------------------------------------------------------------------------------------------
+
+class MergingFactory {
+public:
+    //  --------------------------------------------------------------------------------------------------------------------
+    //! Create appropriate merging method for the species ispec
+    //! \param species Species
+    //! \param params Parameters
+    //  --------------------------------------------------------------------------------------------------------------------
+    static Merging* create(Params& params, Species * species) {
+        Merging* Merge = NULL;
+
+        // Assign the correct Merging method to Merge
+        if ( species->merging_method == "vranic" )
+        {
+            Merge = new MergingVranic( params, species );
+        }
+        else if ( species->merging_method != "none" )
+        {
+            ERROR( "For species " << species->name
+                                  << ": unknown merging_method `"
+                                  << species->merging_method << "`");
+        }
+
+        return Merge;
+    }
+
+};
+
+#endif
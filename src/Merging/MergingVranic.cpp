@@ -0,0 +1,198 @@
+// ----------------------------------------------------------------------------
+//! \file MergingVranic.cpp
+//
+//! \brief Functions of the class MergingVranic: merging of the macro-particles
+//!  of a cell that are close in momentum space, conserving the energy and the
+//!  momentum (M. Vranic et al., Comput. Phys. Commun. 191, 65-73 (2015)).
+//
+// ----------------------------------------------------------------------------
+
+#include "MergingVranic.h"
+
+#include <algorithm>
+#include <cmath>
+#include <tuple>
+
+// -----------------------------------------------------------------------------
+//! Constructor for MergingVranic
+//! \param params simulation parameters
+//! \param species Species index
+// -----------------------------------------------------------------------------
+MergingVranic::MergingVranic(Params& params, Species * species)
+      : Merging(params, species)
+{
+}
+
+// -----------------------------------------------------------------------------
+//! Destructor for MergingVranic
+// -----------------------------------------------------------------------------
+MergingVranic::~MergingVranic()
+{
+}
+
+// -----------------------------------------------------------------------------
+//! Overloading of the operator (): merge the particles of a bin, cell by cell.
+//! The particles to be removed get a null weight.
+//! \param particles   particle object containing the particle
+//!                    properties of the current species
+//! \param cell_index  cell index of each particle of particles
+//! \param istart      Index of the first particle
+//! \param iend        Index of the last particle
+// -----------------------------------------------------------------------------
+void MergingVranic::operator() (
+        Particles &particles,
+        int * cell_index,
+        int istart,
+        int iend)
+{
+    unsigned int npart = iend - istart;
+    if ( npart < min_particles_per_cell_ )
+        return;
+
+    // Particles of the bin grouped by cell
+    std::vector<int> index(npart);
+    for (unsigned int ip=0 ; ip<npart ; ip++)
+        index[ip] = istart + ip;
+    std::stable_sort(index.begin(), index.end(),
+        [cell_index](int a, int b) { return cell_index[a] < cell_index[b]; } );
+
+    unsigned int first = 0;
+    while ( first < npart ) {
+        unsigned int last = first + 1;
+        while ( last < npart && cell_index[index[last]] == cell_index[index[first]] )
+            last++;
+        if ( last - first >= min_particles_per_cell_ )
+            merge_cell(particles, &index[first], last - first);
+        first = last;
+    }
+}
+
+// -----------------------------------------------------------------------------
+//! Merge the particles of a cell. The momentum space is divided in
+//! momentum_cell_size_ cells along the momentum norm, the polar angle and
+//! the azimuthal angle. The particles of the same momentum cell (and of the
+//! same charge) are replaced by 2 particles carrying the total weight,
+//! momentum and energy.
+//! \param particles   particle object containing the particle properties
+//! \param index       indexes of the particles of the cell
+//! \param npart       number of particles in the cell
+// -----------------------------------------------------------------------------
+void MergingVranic::merge_cell(Particles &particles, int * index, unsigned int npart)
+{
+    particle_real* momentum_x = &( particles.momentum(0,0) );
+    particle_real* momentum_y = &( particles.momentum(1,0) );
+    particle_real* momentum_z = &( particles.momentum(2,0) );
+    particle_real* weight     = &( particles.weight(0) );
+    short* charge             = &( particles.charge(0) );
+
+    const unsigned int n_p     = momentum_cell_size_[0];
+    const unsigned int n_theta = momentum_cell_size_[1];
+    const unsigned int n_phi   = momentum_cell_size_[2];
+
+    // Momentum norm of each particle and its range in the cell
+    std::vector<double> p_norm(npart);
+    double p_min = 0., p_max = 0.;
+    for (unsigned int i=0 ; i<npart ; i++) {
+        int ip = index[i];
+        p_norm[i] = sqrt( (double)momentum_x[ip]*momentum_x[ip]
+                        + (double)momentum_y[ip]*momentum_y[ip]
+                        + (double)momentum_z[ip]*momentum_z[ip] );
+        if ( i==0 || p_norm[i] < p_min ) p_min = p_norm[i];
+        if ( i==0 || p_norm[i] > p_max ) p_max = p_norm[i];
+    }
+    double inv_dp = p_max > p_min ? n_p / (p_max - p_min) : 0.;
+
+    // Momentum cell of each particle
+    std::vector<std::tuple<unsigned int, short, int> > momentum_cell(npart);
+    for (unsigned int i=0 ; i<npart ; i++) {
+        int ip = index[i];
+        unsigned int i_p = std::min( (unsigned int)( (p_norm[i]-p_min) * inv_dp ), n_p-1 );
+        double theta = p_norm[i] > 0. ? acos( momentum_z[ip] / p_norm[i] ) : 0.;
+        double phi   = atan2( (double)momentum_y[ip], (double)momentum_x[ip] ) + M_PI;
+        unsigned int i_theta = std::min( (unsigned int)( theta * n_theta / M_PI ), n_theta-1 );
+        unsigned int i_phi   = std::min( (unsigned int)( phi * n_phi / (2.*M_PI) ), n_phi-1 );
+        momentum_cell[i] = std::make_tuple( (i_p*n_theta + i_theta)*n_phi + i_phi, charge[ip], ip );
+    }
+    std::sort( momentum_cell.begin(), momentum_cell.end() );
+
+    unsigned int first = 0;
+    while ( first < npart ) {
+        unsigned int last = first + 1;
+        while ( last < npart
+             && std::get<0>(momentum_cell[last]) == std::get<0>(momentum_cell[first])
+             && std::get<1>(momentum_cell[last]) == std::get<1>(momentum_cell[first]) )
+            last++;
+
+        if ( last - first >= min_particles_per_momentum_cell_ ) {
+
+            // Total weight, momentum and energy
+            double w_tot = 0., px_tot = 0., py_tot = 0., pz_tot = 0., e_tot = 0.;
+            for (unsigned int i=first ; i<last ; i++) {
+                int ip = std::get<2>(momentum_cell[i]);
+                double w = weight[ip];
+                double p2 = (double)momentum_x[ip]*momentum_x[ip]
+                          + (double)momentum_y[ip]*momentum_y[ip]
+                          + (double)momentum_z[ip]*momentum_z[ip];
+                w_tot  += w;
+                px_tot += w * momentum_x[ip];
+                py_tot += w * momentum_y[ip];
+                pz_tot += w * momentum_z[ip];
+                e_tot  += w * ( mass_ > 0. ? sqrt( 1. + p2 ) : sqrt( p2 ) );
+            }
+            double p_tot = sqrt( px_tot*px_tot + py_tot*py_tot + pz_tot*pz_tot );
+
+            // Momentum norm of the 2 new particles, from the mean energy
+            double e_mean = w_tot > 0. ? e_tot / w_tot : 0.;
+            double p_new  = mass_ > 0. ? sqrt( std::max( e_mean*e_mean - 1., 0. ) ) : e_mean;
+
+            if ( p_tot > 0. && p_new > 0. ) {
+
+                // The 2 new momenta are symmetric with respect to the total momentum
+                double cos_omega = std::min( p_tot / ( w_tot * p_new ), 1. );
+                double sin_omega = sqrt( 1. - cos_omega*cos_omega );
+
+                double e1_x = px_tot / p_tot;
+                double e1_y = py_tot / p_tot;
+                double e1_z = pz_tot / p_tot;
+
+                // Second direction: part of the momentum of the first particle
+                // orthogonal to the total momentum
+                int ip_a = std::get<2>(momentum_cell[first]);
+                int ip_b = std::get<2>(momentum_cell[first+1]);
+                double proj = momentum_x[ip_a]*e1_x + momentum_y[ip_a]*e1_y + momentum_z[ip_a]*e1_z;
+                double e2_x = momentum_x[ip_a] - proj*e1_x;
+                double e2_y = momentum_y[ip_a] - proj*e1_y;
+                double e2_z = momentum_z[ip_a] - proj*e1_z;
+                double e2_norm = sqrt( e2_x*e2_x + e2_y*e2_y + e2_z*e2_z );
+                if ( e2_norm <= 1.e-10 * p_new ) {
+                    // All momenta are aligned: any direction orthogonal to e1
+                    if ( fabs(e1_x) < 0.9 ) {
+                        e2_x = 0.;    e2_y = e1_z;  e2_z = -e1_y;
+                    } else {
+                        e2_x = -e1_z; e2_y = 0.;    e2_z = e1_x;
+                    }
+                    e2_norm = sqrt( e2_x*e2_x + e2_y*e2_y + e2_z*e2_z );
+                }
+                e2_x /= e2_norm;
+                e2_y /= e2_norm;
+                e2_z /= e2_norm;
+
+                // The first 2 particles of the momentum cell carry the result
+                weight[ip_a] = 0.5 * w_tot;
+                weight[ip_b] = 0.5 * w_tot;
+                momentum_x[ip_a] = p_new * ( cos_omega*e1_x + sin_omega*e2_x );
+                momentum_y[ip_a] = p_new * ( cos_omega*e1_y + sin_omega*e2_y );
+                momentum_z[ip_a] = p_new * ( cos_omega*e1_z + sin_omega*e2_z );
+                momentum_x[ip_b] = p_new * ( cos_omega*e1_x - sin_omega*e2_x );
+                momentum_y[ip_b] = p_new * ( cos_omega*e1_y - sin_omega*e2_y );
+                momentum_z[ip_b] = p_new * ( cos_omega*e1_z - sin_omega*e2_z );
+
+                // The other ones are removed
+                for (unsigned int i=first+2 ; i<last ; i++)
+                    weight[std::get<2>(momentum_cell[i])] = 0.;
+                removed_particles += last - first - 2;
+            }
+        }
+        first = last;
+    }
+}
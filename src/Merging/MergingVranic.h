@@ -0,0 +1,57 @@
+// ----------------------------------------------------------------------------
+//! \file MergingVranic.h
+//
+//! \brief Header for the class MergingVranic: merging of the macro-particles
+//!  of a cell that are close in momentum space, conserving the energy and the
+//!  momentum (M. Vranic et al., Comput. Phys. Commun. 191, 65-73 (2015)).
+//
+// ----------------------------------------------------------------------------
+
+#ifndef MERGINGVRANIC_H
+#define MERGINGVRANIC_H
+
+#include "Merging.h"
+
+//  ----------------------------------------------------------------------------
+//! Class MergingVranic
+//  ----------------------------------------------------------------------------
+class MergingVranic : public Merging
+{
+
+    public:
+
+        //! Creator for MergingVranic
+        MergingVranic(Params& params, Species * species);
+
+        //! Destructor for MergingVranic
+        ~MergingVranic();
+
+        //! Overloading of () operator: merge the particles of a bin, cell by cell.
+        //! \param particles   particle object containing the particle
+        //!                    properties of the current species
+        //! \param cell_index  cell index of each particle of particles
+        //! \param istart      Index of the first particle
+        //! \param iend        Index of the last particle
+        virtual void operator() (
+                Particles &particles,
+                int * cell_index,
+                int istart,
+                int iend);
+
+    protected:
+
+        //! Merge the particles of a cell
+        //! \param particles   particle object containing the particle properties
+        //! \param index       indexes of the particles of the cell
+        //! \param npart       number of particles in the cell
+        void merge_cell(Particles &particles, int * index, unsigned int npart);
+
+        //! Minimum number of particles in a momentum cell for the merging to occur
+        //! (they are replaced by 2 particles)
+        static const unsigned int min_particles_per_momentum_cell_ = 4;
+
+    private:
+
+};//END class
+
+#endif
@@ -364,7 +364,7 @@ void SimWindow::operate(VectorPatch& vecPatches, SmileiMPI* smpi, Params& params
 
     //Fill necessary patches with particles
 #ifdef _VECTO
-    if (params.vectorization_mode == "on")
+    if (params.vectorization_mode == "on" || params.vectorization_mode == "hybrid")
     {
         //#pragma omp master
         //{
@@ -74,12 +74,12 @@ void MultiphotonBreitWheeler::compute_thread_chiph(Particles &particles,
     double gamma;
 
     // Momentum shortcut
-    double* momentum[3];
+    particle_real* momentum[3];
     for ( int i = 0 ; i<3 ; i++ )
         momentum[i] =  &( particles.momentum(i,0) );
 
     // Optical depth for the Monte-Carlo process
-    double* chi = &( particles.chi(0));
+    particle_real* chi = &( particles.chi(0));
 
     // _______________________________________________________________
     // Computation
@@ -126,6 +126,7 @@ void MultiphotonBreitWheeler::compute_thread_chiph(Particles &particles,
 void MultiphotonBreitWheeler::operator() (Particles &particles,
         SmileiMPI* smpi,
         MultiphotonBreitWheelerTables &MultiphotonBreitWheelerTables,
+        Random * rand,
         int istart,
         int iend,
         int ithread, int ipart_ref)
@@ -152,7 +153,7 @@ void MultiphotonBreitWheeler::operator() (Particles &particles,
     double event_time;
 
     // Momentum shortcut
-    double* momentum[3];
+    particle_real* momentum[3];
     for ( int i = 0 ; i<3 ; i++ )
         momentum[i] =  &( particles.momentum(i,0) );
 
@@ -168,10 +169,10 @@ void MultiphotonBreitWheeler::operator() (Particles &particles,
     // double* weight = &( particles.weight(0) );
 
     // Optical depth for the Monte-Carlo process
-    double* tau = &( particles.tau(0));
+    particle_real* tau = &( particles.tau(0));
 
     // Quantum parameter
-    double * chiph = &( particles.chi(0));
+    particle_real * chiph = &( particles.chi(0));
 
     // Photon id
     // uint64_t * id = &( particles.id(0));
@@ -200,7 +201,16 @@ void MultiphotonBreitWheeler::operator() (Particles &particles,
                  (*(Bx+ipart-ipart_ref)),(*(By+ipart-ipart_ref)),(*(Bz+ipart-ipart_ref)) );
     }
 
-    // 2. Monte-Carlo process
+    // 2. Computation of the production rates
+    //    Vectorized, with direct-index lookups in the table T
+    if (iend > istart)
+    {
+        dNBWdt_buffer.resize(iend-istart);
+        MultiphotonBreitWheelerTables.compute_dNBWdt(&chiph[istart], &(*gamma)[istart],
+                                                     &dNBWdt_buffer[0], iend-istart);
+    }
+
+    // 3. Monte-Carlo process
     //    No vectorized
     for (int ipart=istart ; ipart<iend; ipart++ )
     {
@@ -219,7 +229,7 @@ void MultiphotonBreitWheeler::operator() (Particles &particles,
             {
              // New final optical depth to reach for emision
              while (tau[ipart] <= epsilon_tau)
-                tau[ipart] = -log(1.-Rand::uniform());
+                tau[ipart] = -log(1.-rand->uniform());
 
             }
 
@@ -228,7 +238,7 @@ void MultiphotonBreitWheeler::operator() (Particles &particles,
             else if (tau[ipart] > epsilon_tau)
             {
                 // from the cross section
-                temp = MultiphotonBreitWheelerTables.compute_dNBWdt(chiph[ipart],(*gamma)[ipart]);
+                temp = dNBWdt_buffer[ipart-istart];
 
                 // Time to decay
                 // If this time is above the remaining iteration time,
@@ -260,7 +270,8 @@ void MultiphotonBreitWheeler::operator() (Particles &particles,
                                           particles,
                                           (*gamma)[ipart],
                                           dt - event_time,
-                                          MultiphotonBreitWheelerTables);
+                                          MultiphotonBreitWheelerTables,
+                                          rand);
 
 
                     // Optical depth becomes negative meaning
@@ -284,12 +295,14 @@ void MultiphotonBreitWheeler::operator() (Particles &particles,
 //! \param MultiphotonBreitWheelerTables    Cross-section data tables
 //!                       and useful functions
 //!                       for the multiphoton Breit-Wheeler process
+//! \param rand               Random number generator of the patch
 // -----------------------------------------------------------------------------
 void MultiphotonBreitWheeler::pair_emission(int ipart,
                 Particles & particles,
                 double & gammaph,
                 double remaining_dt,
-                MultiphotonBreitWheelerTables &MultiphotonBreitWheelerTables)
+                MultiphotonBreitWheelerTables &MultiphotonBreitWheelerTables,
+                Random * rand)
 {
 
     // _______________________________________________
@@ -298,7 +311,7 @@ void MultiphotonBreitWheeler::pair_emission(int ipart,
     int      nparticles;           // Total number of particles in the temporary arrays
     int      k,i;
     double   u[3];                 // propagation direction
-    double * chi = new double[2];  // temporary quantum parameters
+    double   chi[2];               // temporary quantum parameters
     double   inv_chiph_gammaph;    // (gamma_ph - 2) / chi
     double   p;
     // Commented particles displasment while particles injection not managed  in a better way
@@ -309,7 +322,7 @@ void MultiphotonBreitWheeler::pair_emission(int ipart,
     inv_chiph_gammaph = (gammaph-2.)/particles.chi(ipart);
 
     // Get the pair quantum parameters to compute the energy
-    chi = MultiphotonBreitWheelerTables.compute_pair_chi( particles.chi(ipart));
+    MultiphotonBreitWheelerTables.compute_pair_chi( particles.chi(ipart), rand, chi );
 
     // pair propagation direction // direction of the photon
     for (k = 0 ; k<3 ; k++ ) {
@@ -394,7 +407,7 @@ void MultiphotonBreitWheeler::decayed_photon_cleaning(
     if (bmax[ibin] > bmin[ibin])
     {
         // Weight shortcut
-        double* weight = &( particles.weight(0) );
+        particle_real* weight = &( particles.weight(0) );
 
         // Index of the last existing photon (weight > 0)
         int last_photon_index;
@@ -35,12 +35,14 @@ class MultiphotonBreitWheeler
         //! \param smpi        MPI properties
         //! \param MultiphotonBreitWheelerTables Cross-section data tables and useful functions
         //                     for multiphoton Breit-Wheeler
+        //! \param rand        Random number generator of the patch
         //! \param istart      Index of the first particle
         //! \param iend        Index of the last particle
         //! \param ithread     Thread index
         void operator() (Particles &particles,
                 SmileiMPI* smpi,
                 MultiphotonBreitWheelerTables &MultiphotonBreitWheelerTables,
+                Random * rand,
                 int istart,
                 int iend,
                 int ithread, int ipart_ref = 0);
@@ -58,7 +60,7 @@ class MultiphotonBreitWheeler
         //! \param By y component of the particle magnetic field
         //! \param Bz z component of the particle magnetic field
         //#pragma omp declare simd
-        double inline compute_chiph(double & kx, double & ky, double & kz,
+        double inline compute_chiph(const double & kx, const double & ky, const double & kz,
                                     double & gamma,
                                     double & Ex, double & Ey, double & Ez,
                                     double & Bx, double & By, double & Bz)
@@ -93,11 +95,13 @@ class MultiphotonBreitWheeler
         //! \param MultiphotonBreitWheelerTables    Cross-section data tables
         //!                       and useful functions
         //!                       for the multiphoton Breit-Wheeler process
+        //! \param rand               Random number generator of the patch
         void pair_emission(int ipart,
                            Particles & particles,
                            double & gammaph,
                            double remaining_dt,
-                           MultiphotonBreitWheelerTables &MultiphotonBreitWheelerTables);
+                           MultiphotonBreitWheelerTables &MultiphotonBreitWheelerTables,
+                           Random * rand);
 
         //! Clean photons that decayed into pairs (weight <= 0)
         //! \param particles   particle object containing the particle
@@ -142,6 +146,9 @@ class MultiphotonBreitWheeler
         //! Threshold under which pair creation is not considered
         double chiph_threashold;
 
+        //! Production rates of the photons of the bin (computed at once)
+        std::vector<double> dNBWdt_buffer;
+
         // _________________________________________
         // Factors
 
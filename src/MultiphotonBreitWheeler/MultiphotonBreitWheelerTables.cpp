@@ -14,6 +14,7 @@
 #include <iomanip>
 
 #include "MultiphotonBreitWheelerTables.h"
+#include "TableCache.h"
 
 // -----------------------------------------------------------------------------
 // INITILIZATION AND DESTRUCTION
@@ -88,6 +89,9 @@ void MultiphotonBreitWheelerTables::initialization(Params& params)
 
         // Path to the databases
         PyTools::extract("table_path", table_path, "MultiphotonBreitWheeler");
+
+        // Path to the cache of the computed tables
+        PyTools::extract("table_cache_path", table_cache_path, "MultiphotonBreitWheeler");
     }
 
     // Computation of some parameters
@@ -105,6 +109,10 @@ void MultiphotonBreitWheelerTables::initialization(Params& params)
     if (params.hasMultiphotonBreitWheeler)
     {
         MESSAGE( "        table path: " << table_path);
+        if (!table_cache_path.empty())
+        {
+            MESSAGE( "        table cache path: " << table_cache_path);
+        }
 
         if (T_chiph_min >= T_chiph_max)
         {
@@ -137,61 +145,6 @@ void MultiphotonBreitWheelerTables::initialization(Params& params)
 // PHYSICAL COMPUTATION
 // -----------------------------------------------------------------------------
 
-// -----------------------------------------------------------------------------
-//! Computation of the production rate of pairs per photon
-//! \param chiph photon quantum parameter
-//! \param gamma photon normalized energy
-// -----------------------------------------------------------------------------
-double MultiphotonBreitWheelerTables::compute_dNBWdt(double chiph, double gamma)
-{
-    // ________________________________________
-    // Parameters
-
-    // Log of the photon quantum parameter chipa
-    double logchiph;
-    double logchiphm;
-    double logchiphp;
-    // Index
-    int ichiph;
-    // final value
-    double dNBWdt;
-
-    // ________________________________________
-    // Computation
-
-    logchiph = log10(chiph);
-
-    // Lower index for interpolation in the table integfochi
-    ichiph = int(floor((logchiph-T_log10_chiph_min)
-                 *T_chiph_inv_delta));
-
-     // If chiph is below the lower bound of the table
-     // An asymptotic approximation is used
-     if (ichiph < 0)
-     {
-         ichiph = 0;
-         dNBWdt = 0.46*exp(-8./(3.*chiph));
-     }
-     // If chiph is above the upper bound of the table
-     // An asymptotic approximation is used
-     else if (ichiph >= T_dim-1)
-     {
-        ichiph = T_dim-2;
-        dNBWdt = 0.38*pow(chiph,-1./3.);
-     }
-     else
-     {
-         // Upper and lower values for linear interpolation
-         logchiphm = ichiph*T_chiph_delta + T_log10_chiph_min;
-         logchiphp = logchiphm + T_chiph_delta;
-
-         // Interpolation
-         dNBWdt = (T_table[ichiph+1]*fabs(logchiph-logchiphm) +
-                 T_table[ichiph]*fabs(logchiphp - logchiph))*T_chiph_inv_delta;
-     }
-     return factor_dNBWdt*dNBWdt*chiph/gamma;
-}
-
 // -----------------------------------------------------------------------------
 //! Computation of the value T(chiph) using the approximated
 //! formula of Erber
@@ -253,11 +206,13 @@ double MultiphotonBreitWheelerTables::compute_integration_Ritus_dTdchi(double ch
 //! the multiphoton Breit-Wheeler pair creation
 //
 //! \param chiph photon quantum parameter
+//! \param rand  Random number generator of the patch
+//! \param chi   resulting electron and positron quantum parameters
 // -----------------------------------------------------------------------------
-double * MultiphotonBreitWheelerTables::compute_pair_chi(double chiph)
+void MultiphotonBreitWheelerTables::compute_pair_chi(double chiph, Random * rand,
+                                                     double * chi)
 {
     // Parameters
-    double * chi = new double[2];
     double logchiph;
     double log10_chipam, log10_chipap;
     double d;
@@ -295,7 +250,7 @@ double * MultiphotonBreitWheelerTables::compute_pair_chi(double chiph)
     // ---------------------------------------
 
     // First, we compute a random xip in [0,1[
-    xip = Rand::uniform();
+    xip = rand->uniform();
 
     // The array uses the symmetric properties of the T fonction,
     // Cases xip > or <= 0.5 are treated seperatly
@@ -322,8 +277,7 @@ double * MultiphotonBreitWheelerTables::compute_pair_chi(double chiph)
     else
     {
         // Search for the corresponding index ichipa for xip
-        ichipa = userFunctions::search_elem_in_array(
-            &xip_table[ichiph*xip_chipa_dim],xipp,xip_chipa_dim);
+        ichipa = xip_guide.search(ichiph,xipp);
     }
 
     // Delta for the chipa dimension
@@ -356,8 +310,6 @@ double * MultiphotonBreitWheelerTables::compute_pair_chi(double chiph)
         // Positron quantum parameter
         chi[1] = chiph - chi[0];
     }
-
-    return chi;
 }
 
 // -----------------------------------------------------------------------------
@@ -433,6 +385,26 @@ void MultiphotonBreitWheelerTables::compute_T_table(SmileiMPI *smpi)
     // If external tables are available, we read them
     table_exists = MultiphotonBreitWheelerTables::read_T_table(smpi);
 
+    // Else we look for them in the cache
+    TableCache cache(table_cache_path, "multiphoton_Breit_Wheeler_T");
+    cache.key(T_dim);
+    cache.key(T_chiph_min);
+    cache.key(T_chiph_max);
+    if (!table_exists && cache.read(smpi, {&T_table}, {T_dim}))
+    {
+        table_exists = true;
+
+        MESSAGE("            Reading of the cache " << cache.filename());
+        MESSAGE("            Dimension quantum parameter: " << T_dim);
+
+        // Computation of the delta
+        T_chiph_delta = (log10(T_chiph_max)
+                - T_log10_chiph_min)/(T_dim-1);
+
+        // Inverse delta
+        T_chiph_inv_delta = 1./T_chiph_delta;
+    }
+
     // Else we compute them
     if (!table_exists)
     {
@@ -522,6 +494,9 @@ void MultiphotonBreitWheelerTables::compute_T_table(SmileiMPI *smpi)
         // delete imin_table;
         delete length_table;
 
+        // Storage in the cache for the next runs
+        cache.write(smpi, {&T_table});
+
     }
 
     // Final timer
@@ -558,6 +533,31 @@ void MultiphotonBreitWheelerTables::compute_xip_table(SmileiMPI *smpi)
     // If external tables are available, we read them
     table_exists = MultiphotonBreitWheelerTables::read_xip_table(smpi);
 
+    // Else we look for them in the cache
+    TableCache cache(table_cache_path, "multiphoton_Breit_Wheeler_xip");
+    cache.key(xip_chiph_dim);
+    cache.key(xip_chipa_dim);
+    cache.key(xip_chiph_min);
+    cache.key(xip_chiph_max);
+    cache.key(xip_power);
+    cache.key(xip_threshold);
+    if (!table_exists && cache.read(smpi, {&xip_chipamin_table, &xip_table},
+                                    {xip_chiph_dim, xip_chipa_dim*xip_chiph_dim}))
+    {
+        table_exists = true;
+
+        MESSAGE("            Reading of the cache " << cache.filename());
+        MESSAGE("            Dimension photon chi: " << xip_chiph_dim);
+        MESSAGE("            Dimension particle chi: " << xip_chipa_dim);
+
+        // Computation of the delta
+        xip_chiph_delta = (log10(xip_chiph_max)
+                - xip_log10_chiph_min)/(xip_chiph_dim-1);
+
+        // Inverse of delta
+        xip_chiph_inv_delta = 1./xip_chiph_delta;
+    }
+
     // Else we compute them
     if (!table_exists)
     {
@@ -781,6 +781,9 @@ void MultiphotonBreitWheelerTables::compute_xip_table(SmileiMPI *smpi)
         delete length_table;
         delete imin_table;
 
+        // Storage in the cache for the next runs
+        cache.write(smpi, {&xip_chipamin_table, &xip_table});
+
     }
 
     t1 = MPI_Wtime();
@@ -801,6 +804,8 @@ void MultiphotonBreitWheelerTables::compute_tables(Params& params, SmileiMPI *sm
     {
         MultiphotonBreitWheelerTables::compute_T_table(smpi);
         MultiphotonBreitWheelerTables::compute_xip_table(smpi);
+        T_lookup.set(&T_table[0], T_dim, T_log10_chiph_min, T_chiph_delta);
+        xip_guide.build(&xip_table[0], xip_chiph_dim, xip_chipa_dim, xip_chipa_dim);
     }
 }
 
@@ -21,6 +21,8 @@
 #include "Params.h"
 #include "H5.h"
 #include "userFunctions.h"
+#include "Random.h"
+#include "LogTable.h"
 
 //------------------------------------------------------------------------------
 //! MutliphotonBreitWheelerTables class: holds parameters, tables and
@@ -50,7 +52,46 @@ class MultiphotonBreitWheelerTables
         //! Computation of the production rate of pairs per photon
         //! \param chiph photon quantum parameter
         //! \param gamma photon normalized energy
-        double compute_dNBWdt(double chiph, double gamma);
+        double inline compute_dNBWdt(double chiph, double gamma)
+        {
+            double T;
+            double position = T_lookup.position(chiph);
+
+            // If chiph is below the lower bound of the table
+            // An asymptotic approximation is used
+            if (position < 0.)
+            {
+                T = 0.46*exp(-8./(3.*chiph));
+            }
+            // If chiph is above the upper bound of the table
+            // An asymptotic approximation is used
+            else if (position >= T_dim-1)
+            {
+                T = 0.38*pow(chiph,-1./3.);
+            }
+            else
+            {
+                T = T_lookup.value(position);
+            }
+            return factor_dNBWdt*T*chiph/gamma;
+        };
+
+        //! Computation of the production rate of pairs for n photons
+        //! (batched over a bin)
+        //! \param chiph photon quantum parameters
+        //! \param gamma photon normalized energies
+        //! \param dNBWdt resulting production rates
+        //! \param n number of photons
+        template<typename T>
+        void compute_dNBWdt(const T * chiph, const double * gamma,
+                            double * dNBWdt, int n)
+        {
+            #pragma omp simd
+            for (int ipart=0 ; ipart < n ; ipart++)
+            {
+                dNBWdt[ipart] = compute_dNBWdt(chiph[ipart], gamma[ipart]);
+            }
+        };
 
         //! Computation of the value T(chiph) using the approximated
         //! formula of Erber
@@ -80,7 +121,9 @@ class MultiphotonBreitWheelerTables
         //! Computation of the electron and positron quantum parameters for
         //! the multiphoton Breit-Wheeler pair creation
         //! \param chiph photon quantum parameter
-        double * compute_pair_chi(double chiph);
+        //! \param rand  Random number generator of the patch
+        //! \param chi   resulting electron and positron quantum parameters
+        void compute_pair_chi(double chiph, Random * rand, double * chi);
 
         // ---------------------------------------------------------------------
         // TABLE COMPUTATION
@@ -157,13 +200,16 @@ class MultiphotonBreitWheelerTables
         //! Path to the tables
         std::string table_path;
 
+        //! Path to the cache of the computed tables (no cache if empty)
+        std::string table_cache_path;
+
         // ---------------------------------------------
         // Table T for the
         // pair creation Monte-Carlo process
         // ---------------------------------------------
 
         //! Array containing tabulated values of the function T
-        std::vector<double > T_table;
+        table_vector T_table;
 
         //! Minimum boundary of the table T
         double T_chiph_min;
@@ -186,6 +232,9 @@ class MultiphotonBreitWheelerTables
         //! This variable is true if the table is computed, false if read
         bool T_computed;
 
+        //! Direct-index lookup in the table T
+        LogTable T_lookup;
+
         // ---------------------------------------------
         // Table chipa min for xip table
         // ---------------------------------------------
@@ -193,7 +242,7 @@ class MultiphotonBreitWheelerTables
         //! Table containing the chipa min values
         //! Under this value, electron kinetic energy of the pair is
         //! considered negligible
-        std::vector<double > xip_chipamin_table;
+        table_vector xip_chipamin_table;
 
         // ---------------------------------------------
         // Table xip
@@ -203,7 +252,7 @@ class MultiphotonBreitWheelerTables
         //! that gives gives the probability for a photon to decay into pair
         //! with an electron of energy in the range \f$[0, \chi_{e^-}]\f$
         //! This enables to compute the energy repartition between the electron and the positron
-        std::vector<double> xip_table;
+        table_vector xip_table;
 
         //! Minimum boundary for chiph in the table xip and xip_chipamin
         double xip_chiph_min;
@@ -240,6 +289,9 @@ class MultiphotonBreitWheelerTables
         //! This variable is true if the table is computed, false if read
         bool xip_computed;
 
+        //! Guide for the search of the particle quantum parameter in the table xip
+        CDFGuide xip_guide;
+
         // ---------------------------------------------
         // Factors
         // ---------------------------------------------
@@ -30,7 +30,7 @@ OpenPMDparams::OpenPMDparams(Params& p):
         gridSpacing     [idim] = params->cell_length[idim];
     }
     fieldSolverParameters = "";
-    if       ( params->maxwell_sol == "Yee" ) {
+    if       ( params->maxwell_sol == "Yee" || params->maxwell_sol == "YeeTiled" ) {
         fieldSolver = "Yee";
     } else if( params->maxwell_sol == "Lehe" ) {
         fieldSolver = "Lehe";
@@ -359,6 +359,19 @@ namelist("")
     PyTools::extract("solve_poisson", solve_poisson, "Main");
     PyTools::extract("poisson_max_iteration", poisson_max_iteration, "Main");
     PyTools::extract("poisson_max_error", poisson_max_error, "Main");
+    PyTools::extract("poisson_solver", poisson_solver, "Main");
+    if (poisson_solver != "CG" && poisson_solver != "pipelined_CG" && poisson_solver != "multigrid")
+        ERROR("poisson_solver must be `CG`, `pipelined_CG` or `multigrid`");
+    PyTools::extract("poisson_preconditioner", poisson_preconditioner, "Main");
+    if (poisson_preconditioner != "none" && poisson_preconditioner != "chebyshev")
+        ERROR("poisson_preconditioner must be `none` or `chebyshev`");
+    if (poisson_solver == "multigrid" && poisson_preconditioner != "none")
+        ERROR("poisson_preconditioner cannot be used with poisson_solver = `multigrid`");
+    PyTools::extract("poisson_chebyshev_degree", poisson_chebyshev_degree, "Main");
+    if (poisson_chebyshev_degree < 1)
+        ERROR("poisson_chebyshev_degree must be at least 1");
+    if ((poisson_solver != "CG" || poisson_preconditioner != "none") && geometry == "AMcylindrical")
+        ERROR("Only poisson_solver = `CG` without poisson_preconditioner is available in AMcylindrical geometry");
     // Relativistic Poisson Solver
     PyTools::extract("solve_relativistic_poisson", solve_relativistic_poisson, "Main");
     PyTools::extract("relativistic_poisson_max_iteration", relativistic_poisson_max_iteration, "Main");
@@ -468,6 +481,12 @@ namelist("")
         WARNING( "Use default distribution : " << patch_arrangement );
     }
 
+    PyTools::extract("aggregate_field_exchanges", aggregate_field_exchanges, "Main");
+    if (aggregate_field_exchanges && geometry == "AMcylindrical")
+        aggregate_field_exchanges = false;
+
+    PyTools::extract("cost_ordered_tasks", cost_ordered_tasks, "Main");
+
 
     int total_number_of_hilbert_patches = 1;
     if (patch_arrangement == "hilbertian") {
@@ -479,6 +498,8 @@ namelist("")
     }
 
 
+    load_model = "particles";
+    load_smoothing = 0.5;
     if( PyTools::nComponents("LoadBalancing")>0 ) {
         // get parameter "every" which describes a timestep selection
         load_balancing_time_selection = new TimeSelection(
@@ -487,6 +508,12 @@ namelist("")
         PyTools::extract("cell_load"  , cell_load      , "LoadBalancing");
         PyTools::extract("frozen_particle_load", frozen_particle_load    , "LoadBalancing");
         PyTools::extract("initial_balance", initial_balance    , "LoadBalancing");
+        PyTools::extract("load_model", load_model, "LoadBalancing");
+        if( load_model != "particles" && load_model != "measured" )
+            ERROR("In block LoadBalancing, `load_model` must be \"particles\" or \"measured\"");
+        PyTools::extract("load_smoothing", load_smoothing, "LoadBalancing");
+        if( load_smoothing <= 0. || load_smoothing > 1. )
+            ERROR("In block LoadBalancing, `load_smoothing` must be in ]0,1]");
     } else {
         load_balancing_time_selection = new TimeSelection();
     }
@@ -508,16 +535,19 @@ namelist("")
     vectorization_mode = "off";
     has_adaptive_vectorization = false;
     adaptive_vecto_time_selection = nullptr;
+    cell_ordering = "standard";
+    vectorization_cost_model = "default";
     
     if( PyTools::nComponents("Vectorization")>0 ) {
         // Extraction of the vectorization mode
         PyTools::extract("mode", vectorization_mode, "Vectorization");
         if (!(vectorization_mode == "off" ||
               vectorization_mode == "on" ||
+              vectorization_mode == "hybrid" ||
               vectorization_mode == "adaptive_mixed_sort" ||
               vectorization_mode == "adaptive"))
         {
-            ERROR("In block `Vectorization`, parameter `mode` must be `off`, `on`, `adaptive`");
+            ERROR("In block `Vectorization`, parameter `mode` must be `off`, `on`, `hybrid`, `adaptive`");
         }
         else if (vectorization_mode == "adaptive_mixed_sort" || vectorization_mode == "adaptive")
         {
@@ -532,6 +562,31 @@ namelist("")
             ERROR("In block `Vectorization`, parameter `default` must be `off` or `on`");
         }
         
+        // Order of the cells (particle bins) inside each patch
+        PyTools::extract("cell_ordering", cell_ordering, "Vectorization");
+        if (!(cell_ordering == "standard" ||
+              cell_ordering == "morton"))
+        {
+            ERROR("In block `Vectorization`, parameter `cell_ordering` must be `standard` or `morton`");
+        }
+        
+        // Cost model of the adaptive mode
+        PyTools::extract("cost_model", vectorization_cost_model, "Vectorization");
+        if (!(vectorization_cost_model == "default" ||
+              vectorization_cost_model == "benchmark"))
+        {
+            ERROR("In block `Vectorization`, parameter `cost_model` must be `default` or `benchmark`");
+        }
+        PyTools::extract("cost_model_coefficients", cost_model_coefficients, "Vectorization");
+        if (cost_model_coefficients.size() != 0 && cost_model_coefficients.size() != 7)
+        {
+            ERROR("In block `Vectorization`, parameter `cost_model_coefficients` must contain 7 values");
+        }
+        if (cost_model_coefficients.size() > 0 && vectorization_cost_model == "benchmark")
+        {
+            ERROR("In block `Vectorization`, `cost_model_coefficients` cannot be used with `cost_model = \"benchmark\"`");
+        }
+        
         // In case of collisions, ensure particle sort per cell
         if( PyTools::nComponents("Collisions") > 0 ) {
             if( vectorization_mode == "adaptive_mixed_sort" ) // collisions need sorting per cell
@@ -835,9 +890,12 @@ void Params::check_consistency()
 {
     if ( vectorization_mode != "off" ) {
 
-        if ( (geometry=="1Dcartesian") || (geometry=="AMcylindrical") )
+        if ( geometry=="1Dcartesian" )
             ERROR( "Vectorized algorithms not implemented for this geometry" );
 
+        if ( (geometry=="AMcylindrical") && (vectorization_mode != "on") )
+            ERROR( "Only the vectorization mode `on` is implemented in AM geometry" );
+
         if ( (geometry=="2Dcartesian") && (interpolation_order==4) )
             ERROR( "4th order vectorized algorithms not implemented in 2D" );
 
@@ -917,8 +975,12 @@ void Params::print_init()
             MESSAGE(1,"Patches are initially homogeneously distributed between MPI ranks. (initial_balance = false) ");
         }
         MESSAGE(1,"Happens: " << load_balancing_time_selection->info());
-        MESSAGE(1,"Cell load coefficient = " << cell_load );
-        MESSAGE(1,"Frozen particle load coefficient = " << frozen_particle_load );
+        if( load_model == "measured" ) {
+            MESSAGE(1,"Patch loads measured by the patch timers (smoothing = " << load_smoothing << ")" );
+        } else {
+            MESSAGE(1,"Cell load coefficient = " << cell_load );
+            MESSAGE(1,"Frozen particle load coefficient = " << frozen_particle_load );
+        }
     }
 
     TITLE("Vectorization: ");
@@ -928,6 +990,10 @@ void Params::print_init()
         MESSAGE(1,"Default mode: " << adaptive_default_mode);
         MESSAGE(1,"Time selection: " << adaptive_vecto_time_selection->info());
     }
+    if (has_adaptive_vectorization || vectorization_mode == "hybrid")
+        MESSAGE(1,"Cost model: " << (cost_model_coefficients.size()>0 ? "namelist coefficients" : vectorization_cost_model));
+    if (vectorization_mode != "off")
+        MESSAGE(1,"Cell ordering: " << cell_ordering);
 
 }
 
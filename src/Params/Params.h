@@ -140,6 +140,13 @@ public:
     unsigned int poisson_max_iteration;
     //! Maxium poisson error tolerated
     double poisson_max_error;
+    //! Poisson solver: "CG" (conjugate gradient), "pipelined_CG" (one reduction per iteration)
+    //! or "multigrid" (conjugate gradient preconditioned by a multigrid V-cycle)
+    std::string poisson_solver;
+    //! Preconditioner of the CG and pipelined_CG Poisson solvers: "none" or "chebyshev"
+    std::string poisson_preconditioner;
+    //! Degree of the Chebyshev polynomial preconditioner (1 is the Jacobi preconditioner)
+    unsigned int poisson_chebyshev_degree;
 
     //"Relativistic" Poisson solver
     //! Do we solve "relativistic poisson problem" for relativistic species
@@ -221,6 +228,11 @@ public:
     std::vector<unsigned int> number_of_patches;
     //! Domain decomposition
     std::string patch_arrangement;
+    //! Pack the field ghost cells exchanged with each MPI neighbour in a single message,
+    //! sent through persistent requests
+    bool aggregate_field_exchanges;
+    //! Particle dynamics of the patches as OpenMP tasks, in decreasing order of their cost at the previous timestep
+    bool cost_ordered_tasks;
 
     //! Time selection for adaptive vectorization
     TimeSelection * adaptive_vecto_time_selection;
@@ -235,6 +247,10 @@ public:
     double cell_load;
     //! Load coefficient applied to a frozen particle (default = 0.1)
     double frozen_particle_load;
+    //! Estimation of the patch loads: "particles" (particle and cell counts) or "measured" (patch timers)
+    std::string load_model;
+    //! Weight of the latest measurement in the smoothed measured load (default = 0.5)
+    double load_smoothing;
     //! Return if number of patch = number of MPI process, to tune IO //ism
     bool one_patch_per_MPI;
     //! Compute an initially balanced patch distribution right from the start
@@ -244,6 +260,12 @@ public:
     std::string vectorization_mode;
     //! Initial state of the patches in adaptive mode
     std::string adaptive_default_mode;
+    //! Order in which the cells of a patch are traversed by the vectorized operators: standard, morton
+    std::string cell_ordering;
+    //! Cost model of the adaptive vectorization: default (reference fits) or benchmark (calibrated at startup)
+    std::string vectorization_cost_model;
+    //! Coefficients of the cost model given in the namelist (empty if not given)
+    std::vector<double> cost_model_coefficients;
 
     //! Tells whether there is a moving window
     bool hasWindow;
@@ -0,0 +1,220 @@
+
+#include "AggregatedExchange.h"
+
+#include <algorithm>
+#include <cstring>
+#include <map>
+
+#include "VectorPatch.h"
+#include "Field.h"
+
+using namespace std;
+
+namespace
+{
+    //! Block of a message, with its position in the message and in the local fields
+    struct Entry {
+        // Position in the message
+        unsigned int hindex, dim, side, comp;
+        // Index of the block and number of elements
+        unsigned int iblock;
+        unsigned int size;
+
+        bool operator<( const Entry &e ) const
+        {
+            if( hindex != e.hindex ) return hindex < e.hindex;
+            if( dim    != e.dim    ) return dim    < e.dim;
+            if( side   != e.side   ) return side   < e.side;
+            return comp < e.comp;
+        }
+    };
+}
+
+AggregatedExchange::AggregatedExchange( VectorPatch &vecPatches, vector<Field *> &fields, vector<unsigned int> dims, bool sum, int tag, MPI_Comm comm ) :
+    fields_( fields ),
+    sum_( sum )
+{
+    unsigned int nPatches = vecPatches.size();
+    vector<unsigned int> oversize = vecPatches( 0 )->EMfields->oversize;
+    oversize.resize( 3, 0 );
+
+    // Blocks sent to and received from each neighbouring MPI process
+    map<int, unsigned int> rank_index;
+    vector< vector<Entry> > send_entries, recv_entries;
+    recv_first_.assign( fields.size()+1, 0 );
+
+    for( unsigned int ifield=0 ; ifield<fields.size() ; ifield++ ) {
+        Patch *patch = vecPatches( ifield%nPatches );
+        Field *field = fields[ifield];
+        unsigned int n[3] = { 1, 1, 1 };
+        for( unsigned int iDim=0 ; iDim<field->dims_.size() ; iDim++ )
+            n[iDim] = field->dims_[iDim];
+
+        for( unsigned int idir=0 ; idir<dims.size() ; idir++ ) {
+            unsigned int iDim = dims[idir];
+            if( iDim >= field->dims_.size() )
+                continue;
+            unsigned int os   = oversize[iDim];
+            unsigned int dual = field->isDual_[iDim];
+            // Sum : ghost cells, shared nodes and as many cells inside the patch
+            // Exchange : ghost cells only
+            unsigned int width = sum ? 2*os+1+dual : os;
+
+            for( unsigned int iNeighbor=0 ; iNeighbor<2 ; iNeighbor++ ) {
+                if( !patch->is_a_MPI_neighbor( iDim, iNeighbor ) )
+                    continue;
+
+                int rank = patch->MPI_neighbor_[iDim][iNeighbor];
+                if( rank_index.find( rank ) == rank_index.end() ) {
+                    rank_index[rank] = ranks_.size();
+                    ranks_.push_back( rank );
+                    send_entries.resize( ranks_.size() );
+                    recv_entries.resize( ranks_.size() );
+                }
+                unsigned int irank = rank_index[rank];
+
+                Block block;
+                block.field = field;
+                for( unsigned int i=0 ; i<3 ; i++ ) {
+                    block.start[i] = 0;
+                    block.size [i] = n[i];
+                }
+                block.size[iDim] = width;
+                block.buffer = NULL;
+                unsigned int block_size = block.size[0]*block.size[1]*block.size[2];
+
+                // Same regions as in Patch::initSumField / Patch::initExchange
+                if( sum ) {
+                    block.start[iDim] = iNeighbor*( n[iDim]-width );
+                } else {
+                    block.start[iDim] = iNeighbor==0 ? os+1+dual : n[iDim]-( 2*os+1+dual );
+                }
+                Entry send = { patch->hindex, iDim, iNeighbor, ifield/nPatches, (unsigned int)send_blocks_.size(), block_size };
+                send_entries[irank].push_back( send );
+                send_blocks_.push_back( block );
+
+                block.start[iDim] = iNeighbor*( n[iDim]-width );
+                // Block of the neighbour patch, which sends its opposite side
+                Entry recv = { (unsigned int)patch->neighbor_[iDim][iNeighbor], iDim, 1-iNeighbor, ifield/nPatches, (unsigned int)recv_blocks_.size(), block_size };
+                recv_entries[irank].push_back( recv );
+                recv_blocks_.push_back( block );
+                recv_first_[ifield+1]++;
+            }
+        }
+    }
+
+    // Layout of the messages
+    send_buffers_.resize( ranks_.size() );
+    recv_buffers_.resize( ranks_.size() );
+    for( unsigned int irank=0 ; irank<ranks_.size() ; irank++ ) {
+        sort( send_entries[irank].begin(), send_entries[irank].end() );
+        sort( recv_entries[irank].begin(), recv_entries[irank].end() );
+
+        unsigned int size = 0;
+        for( unsigned int i=0 ; i<send_entries[irank].size() ; i++ )
+            size += send_entries[irank][i].size;
+        send_buffers_[irank].resize( size );
+        size = 0;
+        for( unsigned int i=0 ; i<recv_entries[irank].size() ; i++ )
+            size += recv_entries[irank][i].size;
+        recv_buffers_[irank].resize( size );
+
+        double *buffer = send_buffers_[irank].data();
+        for( unsigned int i=0 ; i<send_entries[irank].size() ; i++ ) {
+            send_blocks_[send_entries[irank][i].iblock].buffer = buffer;
+            buffer += send_entries[irank][i].size;
+        }
+        buffer = recv_buffers_[irank].data();
+        for( unsigned int i=0 ; i<recv_entries[irank].size() ; i++ ) {
+            recv_blocks_[recv_entries[irank][i].iblock].buffer = buffer;
+            buffer += recv_entries[irank][i].size;
+        }
+    }
+
+    // Blocks were created field by field, as needed for the unpacking
+    for( unsigned int ifield=0 ; ifield<fields.size() ; ifield++ )
+        recv_first_[ifield+1] += recv_first_[ifield];
+
+    // Persistent requests
+    requests_.resize( 2*ranks_.size() );
+    for( unsigned int irank=0 ; irank<ranks_.size() ; irank++ ) {
+        MPI_Recv_init( recv_buffers_[irank].data(), recv_buffers_[irank].size(), MPI_DOUBLE, ranks_[irank], tag, comm, &requests_[irank] );
+        MPI_Send_init( send_buffers_[irank].data(), send_buffers_[irank].size(), MPI_DOUBLE, ranks_[irank], tag, comm, &requests_[ranks_.size()+irank] );
+    }
+}
+
+
+AggregatedExchange::~AggregatedExchange()
+{
+    for( unsigned int i=0 ; i<requests_.size() ; i++ )
+        MPI_Request_free( &requests_[i] );
+}
+
+
+void AggregatedExchange::start()
+{
+    #pragma omp for schedule(static)
+    for( unsigned int i=0 ; i<send_blocks_.size() ; i++ )
+        pack( send_blocks_[i] );
+
+    #pragma omp single
+    {
+        if( requests_.size() > 0 )
+            MPI_Startall( requests_.size(), &requests_[0] );
+    }
+}
+
+
+void AggregatedExchange::finalize()
+{
+    #pragma omp single
+    {
+        if( requests_.size() > 0 )
+            MPI_Waitall( requests_.size(), &requests_[0], MPI_STATUSES_IGNORE );
+    }
+
+    #pragma omp for schedule(static)
+    for( unsigned int ifield=0 ; ifield<fields_.size() ; ifield++ )
+        for( unsigned int i=recv_first_[ifield] ; i<recv_first_[ifield+1] ; i++ )
+            unpack( recv_blocks_[i], sum_ );
+}
+
+
+void AggregatedExchange::pack( Block &block )
+{
+    unsigned int n1 = block.field->dims_.size()>1 ? block.field->dims_[1] : 1;
+    unsigned int n2 = block.field->dims_.size()>2 ? block.field->dims_[2] : 1;
+    double *buffer = block.buffer;
+    // Contiguous along the last two dimensions when the block spans the last one
+    unsigned int run  = block.size[2] == n2 ? block.size[1]*n2 : block.size[2];
+    unsigned int nrun = block.size[2] == n2 ? 1 : block.size[1];
+    for( unsigned int i=0 ; i<block.size[0] ; i++ ) {
+        for( unsigned int j=0 ; j<nrun ; j++ ) {
+            memcpy( buffer, &( block.field->data_[( ( block.start[0]+i )*n1 + block.start[1]+j )*n2 + block.start[2]] ), run*sizeof( double ) );
+            buffer += run;
+        }
+    }
+}
+
+
+void AggregatedExchange::unpack( Block &block, bool sum )
+{
+    unsigned int n1 = block.field->dims_.size()>1 ? block.field->dims_[1] : 1;
+    unsigned int n2 = block.field->dims_.size()>2 ? block.field->dims_[2] : 1;
+    double *buffer = block.buffer;
+    unsigned int run  = block.size[2] == n2 ? block.size[1]*n2 : block.size[2];
+    unsigned int nrun = block.size[2] == n2 ? 1 : block.size[1];
+    for( unsigned int i=0 ; i<block.size[0] ; i++ ) {
+        for( unsigned int j=0 ; j<nrun ; j++ ) {
+            double *data = &( block.field->data_[( ( block.start[0]+i )*n1 + block.start[1]+j )*n2 + block.start[2]] );
+            if( sum ) {
+                #pragma omp simd
+                for( unsigned int k=0 ; k<run ; k++ )
+                    data[k] += buffer[k];
+            } else {
+                memcpy( data, buffer, run*sizeof( double ) );
+            }
+            buffer += run;
+        }
+    }
+}
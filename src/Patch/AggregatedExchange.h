@@ -0,0 +1,74 @@
+#ifndef AGGREGATEDEXCHANGE_H
+#define AGGREGATEDEXCHANGE_H
+
+#include <mpi.h>
+#include <vector>
+
+class VectorPatch;
+class Field;
+
+//! MPI part of the synchronization of a list of fields (components x patches), aggregated per
+//! neighbouring MPI process.
+//!
+//! The boundaries of all the patches sent to a given MPI process are packed in one contiguous
+//! buffer and sent in a single message, through persistent requests (MPI_Send_init/MPI_Recv_init).
+//! The blocks of a message are ordered by (hindex of the sending patch, direction, side, component)
+//! so that both processes agree on the layout without any negotiation.
+//!
+//! The exchange is only valid for a given distribution of the patches: VectorPatch deletes all
+//! the instances when the patches move between MPI processes (load balancing, moving window).
+//! The exchanges between patches of the same MPI process remain handled by SyncVectorPatch.
+//!
+//! start() and finalize() must be called by all the threads of the OpenMP region (or outside of it).
+class AggregatedExchange
+{
+public:
+    //! \param fields   nComp components of the patches of vecPatches, component by component
+    //! \param dims     directions exchanged together
+    //! \param sum      if true, the received boundaries are summed (SyncVectorPatch::sum), else they
+    //!                 replace the ghost cells (SyncVectorPatch::exchange_...)
+    //! \param tag      MPI tag of the messages
+    AggregatedExchange( VectorPatch &vecPatches, std::vector<Field *> &fields, std::vector<unsigned int> dims, bool sum, int tag, MPI_Comm comm );
+    ~AggregatedExchange();
+
+    //! True if the exchange was built for this list of fields
+    inline bool isBuiltFor( std::vector<Field *> &fields )
+    {
+        return fields == fields_;
+    }
+
+    //! Pack the boundaries and start the communications
+    void start();
+    //! Wait for the communications and unpack the ghost cells
+    void finalize();
+
+private:
+    //! Region of a field copied to / from a buffer
+    struct Block {
+        Field *field;
+        unsigned int start[3];
+        unsigned int size[3];
+        double *buffer;
+    };
+
+    //! Copy the block from the field to its buffer
+    static void pack( Block &block );
+    //! Copy (or add if sum) the buffer of the block to the field
+    static void unpack( Block &block, bool sum );
+
+    std::vector<Field *> fields_;
+    bool sum_;
+
+    //! Neighbouring MPI processes, and one buffer per process and per way
+    std::vector<int> ranks_;
+    std::vector< std::vector<double> > send_buffers_, recv_buffers_;
+    //! Persistent requests: receptions then sends
+    std::vector<MPI_Request> requests_;
+
+    std::vector<Block> send_blocks_;
+    //! Received blocks, ordered by field; those of field i are recv_blocks_[recv_first_[i]:recv_first_[i+1]]
+    std::vector<Block> recv_blocks_;
+    std::vector<unsigned int> recv_first_;
+};
+
+#endif
@@ -84,6 +84,11 @@ void Patch::initStep1(Params& params)
     //Pcoordinates.resize(nDim_fields_);
     Pcoordinates.resize( 2 );
 
+    load_timer = 0.;
+    load_timer_steps = 0;
+    measured_load = -1.;
+    dynamics_time = 0.;
+
     nbNeighbors_ = 2;
     neighbor_.resize(nDim_fields_);
     tmp_neighbor_.resize(nDim_fields_);
@@ -102,13 +107,8 @@ void Patch::initStep1(Params& params)
     for ( int iDim = 0 ; iDim < nDim_fields_; iDim++ )
         oversize[iDim] = params.oversize[iDim];
 
-    // Initialize the state of the random number generator
-    xorshift32_state = params.random_seed;
-    // Ensure that the random seed is different for each patch
-    xorshift32_state += rand();
-    // zero is not acceptable for xorshift
-    if( xorshift32_state==0 )
-        xorshift32_state = 1073741824;
+    // Initialize the random number generator, the patch Hindex is part of its key
+    rand_ = new Random( params.random_seed );
 }
 
 
@@ -332,6 +332,8 @@ Patch::~Patch() {
 
     delete probesInterp;
 
+    delete rand_;
+
     for(unsigned int i=0; i<probes.size(); i++)
         delete probes[i];
 
@@ -395,7 +397,6 @@ void Patch::cleanMPIBuffers(int ispec, Params& params)
     for (int iDim=0 ; iDim < ndim ; iDim++){
         for (int iNeighbor=0 ; iNeighbor<nbNeighbors_ ; iNeighbor++) {
             vecSpecies[ispec]->MPIbuff.partRecv[iDim][iNeighbor].clear();//resize(0,ndim);
-            vecSpecies[ispec]->MPIbuff.partSend[iDim][iNeighbor].clear();//resize(0,ndim);
             vecSpecies[ispec]->MPIbuff.part_index_send[iDim][iNeighbor].clear();
             //vecSpecies[ispec]->MPIbuff.part_index_send[iDim][iNeighbor].resize(0);
             vecSpecies[ispec]->MPIbuff.part_index_recv_sz[iDim][iNeighbor] = 0;
@@ -420,7 +421,6 @@ void Patch::initExchParticles(SmileiMPI* smpi, int ispec, Params& params)
     for (int iDim=0 ; iDim < ndim ; iDim++){
         for (int iNeighbor=0 ; iNeighbor<nbNeighbors_ ; iNeighbor++) {
             vecSpecies[ispec]->MPIbuff.partRecv[iDim][iNeighbor].clear();//resize(0,ndim);
-            vecSpecies[ispec]->MPIbuff.partSend[iDim][iNeighbor].clear();//resize(0,ndim);
             vecSpecies[ispec]->MPIbuff.part_index_send[iDim][iNeighbor].resize(0);
             vecSpecies[ispec]->MPIbuff.part_index_recv_sz[iDim][iNeighbor] = 0;
         }
@@ -496,77 +496,10 @@ void Patch::initExchParticles(SmileiMPI* smpi, int ispec, Params& params)
 
 
 // ---------------------------------------------------------------------------------------------------------------------
-// For direction iDim, start exchange of number of particles
-//   - vecPatch : used for intra-MPI process comm (direct copy using Particels::cp_particles)
-//   - smpi     : inhereted from previous SmileiMPI::exchangeParticles()
-// ---------------------------------------------------------------------------------------------------------------------
-void Patch::exchNbrOfParticles(SmileiMPI* smpi, int ispec, Params& params, int iDim, VectorPatch * vecPatch)
-{
-    int h0 = (*vecPatch)(0)->hindex;
-    /********************************************************************************/
-    // Exchange number of particles to exchange to establish or not a communication
-    /********************************************************************************/
-    for (int iNeighbor=0 ; iNeighbor<nbNeighbors_ ; iNeighbor++) {
-        if (neighbor_[iDim][iNeighbor]!=MPI_PROC_NULL) {
-            vecSpecies[ispec]->MPIbuff.part_index_send_sz[iDim][iNeighbor] = (vecSpecies[ispec]->MPIbuff.part_index_send[iDim][iNeighbor]).size();
-
-            if (is_a_MPI_neighbor(iDim, iNeighbor)) {
-                //If neighbour is MPI ==> I send him the number of particles I'll send later.
-                int local_hindex = hindex - vecPatch->refHindex_;
-                int tag = buildtag( local_hindex, iDim+1, iNeighbor+3 );
-                MPI_Isend( &(vecSpecies[ispec]->MPIbuff.part_index_send_sz[iDim][iNeighbor]), 1, MPI_INT, MPI_neighbor_[iDim][iNeighbor], tag, MPI_COMM_WORLD, &(vecSpecies[ispec]->MPIbuff.srequest[iDim][iNeighbor]) );
-            }
-            else {
-                //Else, I directly set the receive size to the correct value.
-                (*vecPatch)( neighbor_[iDim][iNeighbor]- h0 )->vecSpecies[ispec]->MPIbuff.part_index_recv_sz[iDim][(iNeighbor+1)%2] = vecSpecies[ispec]->MPIbuff.part_index_send_sz[iDim][iNeighbor];
-            }
-        } // END of Send
-
-        if (neighbor_[iDim][(iNeighbor+1)%2]!=MPI_PROC_NULL) {
-            if (is_a_MPI_neighbor(iDim, (iNeighbor+1)%2)) {
-                //If other neighbour is MPI ==> I receive the number of particles I'll receive later.
-                int local_hindex = neighbor_[iDim][(iNeighbor+1)%2] - smpi->patch_refHindexes[ MPI_neighbor_[iDim][(iNeighbor+1)%2] ];
-                int tag = buildtag( local_hindex, iDim+1, iNeighbor+3 );
-                MPI_Irecv( &(vecSpecies[ispec]->MPIbuff.part_index_recv_sz[iDim][(iNeighbor+1)%2]), 1, MPI_INT, MPI_neighbor_[iDim][(iNeighbor+1)%2], tag, MPI_COMM_WORLD, &(vecSpecies[ispec]->MPIbuff.rrequest[iDim][(iNeighbor+1)%2]) );
-            }
-        }
-    }//end loop on nb_neighbors.
-
-} // exchNbrOfParticles(... iDim)
-
-
-void Patch::endNbrOfParticles(SmileiMPI* smpi, int ispec, Params& params, int iDim, VectorPatch * vecPatch)
-{
-    Particles &cuParticles = (*vecSpecies[ispec]->particles);
-
-    /********************************************************************************/
-    // Wait for end of communications over number of particles
-    /********************************************************************************/
-    for (int iNeighbor=0 ; iNeighbor<nbNeighbors_ ; iNeighbor++) {
-        MPI_Status sstat    [2];
-        MPI_Status rstat    [2];
-        if (neighbor_[iDim][iNeighbor]!=MPI_PROC_NULL) {
-            if (is_a_MPI_neighbor(iDim, iNeighbor))
-                MPI_Wait( &(vecSpecies[ispec]->MPIbuff.srequest[iDim][iNeighbor]), &(sstat[iNeighbor]) );
-        }
-        if (neighbor_[iDim][(iNeighbor+1)%2]!=MPI_PROC_NULL) {
-            if (is_a_MPI_neighbor(iDim, (iNeighbor+1)%2))  {
-                MPI_Wait( &(vecSpecies[ispec]->MPIbuff.rrequest[iDim][(iNeighbor+1)%2]), &(rstat[(iNeighbor+1)%2]) );
-                if (vecSpecies[ispec]->MPIbuff.part_index_recv_sz[iDim][(iNeighbor+1)%2]!=0) {
-                    //If I receive particles over MPI, I initialize my receive buffer with the appropriate size.
-                    vecSpecies[ispec]->MPIbuff.partRecv[iDim][(iNeighbor+1)%2].initialize( vecSpecies[ispec]->MPIbuff.part_index_recv_sz[iDim][(iNeighbor+1)%2], cuParticles);
-                }
-            }
-        }
-    }
-
-} // END endNbrOfParticles(... iDim)
-
-
-// ---------------------------------------------------------------------------------------------------------------------
-// For direction iDim, finalize receive of number of particles and really send particles
+// For direction iDim, apply periodicity to the particles to send and fill the send buffers
 //   - vecPatch : used for intra-MPI process comm (direct copy using Particels::cp_particles)
 //   - smpi     : used smpi->periods_
+// Particles sent to another MPI process are packed in a contiguous byte buffer (reused from one exchange to the next)
 // ---------------------------------------------------------------------------------------------------------------------
 void Patch::prepareParticles(SmileiMPI* smpi, int ispec, Params& params, int iDim, VectorPatch * vecPatch)
 {
@@ -580,112 +513,89 @@ void Patch::prepareParticles(SmileiMPI* smpi, int ispec, Params& params, int iDi
 
         // n_part_send : number of particles to send to current neighbor
         n_part_send = (vecSpecies[ispec]->MPIbuff.part_index_send[iDim][iNeighbor]).size();
-        if ( (neighbor_[iDim][iNeighbor]!=MPI_PROC_NULL) && (n_part_send!=0) ) {
-            // Enabled periodicity
-            if (smpi->periods_[iDim]==1) {
-                for (int iPart=0 ; iPart<n_part_send ; iPart++) {
-                    if ( ( iNeighbor==0 ) &&  (Pcoordinates[iDim] == 0 ) &&( cuParticles.position(iDim,vecSpecies[ispec]->MPIbuff.part_index_send[iDim][iNeighbor][iPart]) < 0. ) ) {
-                        cuParticles.position(iDim,vecSpecies[ispec]->MPIbuff.part_index_send[iDim][iNeighbor][iPart])     += x_max;
-                    }
-                    else if ( ( iNeighbor==1 ) &&  (Pcoordinates[iDim] == params.number_of_patches[iDim]-1 ) && ( cuParticles.position(iDim,vecSpecies[ispec]->MPIbuff.part_index_send[iDim][iNeighbor][iPart]) >= x_max ) ) {
-                        cuParticles.position(iDim,vecSpecies[ispec]->MPIbuff.part_index_send[iDim][iNeighbor][iPart])     -= x_max;
-                    }
+        vecSpecies[ispec]->MPIbuff.part_index_send_sz[iDim][iNeighbor] = n_part_send;
+        if (neighbor_[iDim][iNeighbor]==MPI_PROC_NULL)
+            continue;
+
+        // Enabled periodicity
+        if ( (smpi->periods_[iDim]==1) && (n_part_send!=0) ) {
+            for (int iPart=0 ; iPart<n_part_send ; iPart++) {
+                if ( ( iNeighbor==0 ) &&  (Pcoordinates[iDim] == 0 ) &&( cuParticles.position(iDim,vecSpecies[ispec]->MPIbuff.part_index_send[iDim][iNeighbor][iPart]) < 0. ) ) {
+                    cuParticles.position(iDim,vecSpecies[ispec]->MPIbuff.part_index_send[iDim][iNeighbor][iPart])     += x_max;
+                }
+                else if ( ( iNeighbor==1 ) &&  (Pcoordinates[iDim] == params.number_of_patches[iDim]-1 ) && ( cuParticles.position(iDim,vecSpecies[ispec]->MPIbuff.part_index_send[iDim][iNeighbor][iPart]) >= x_max ) ) {
+                    cuParticles.position(iDim,vecSpecies[ispec]->MPIbuff.part_index_send[iDim][iNeighbor][iPart])     -= x_max;
                 }
             }
-            // Send particles
-            if (is_a_MPI_neighbor(iDim, iNeighbor)) {
-                // If MPI comm, first copy particles in the sendbuffer
-                for (int iPart=0 ; iPart<n_part_send ; iPart++)
-                    cuParticles.cp_particle(vecSpecies[ispec]->MPIbuff.part_index_send[iDim][iNeighbor][iPart], vecSpecies[ispec]->MPIbuff.partSend[iDim][iNeighbor]);
-            }
-            else {
-                //If not MPI comm, copy particles directly in the receive buffer
-                for (int iPart=0 ; iPart<n_part_send ; iPart++)
-                    cuParticles.cp_particle( vecSpecies[ispec]->MPIbuff.part_index_send[iDim][iNeighbor][iPart],((*vecPatch)( neighbor_[iDim][iNeighbor]- h0 )->vecSpecies[ispec]->MPIbuff.partRecv[iDim][(iNeighbor+1)%2]) );
-            }
-        } // END of Send
+        }
+        if (is_a_MPI_neighbor(iDim, iNeighbor)) {
+            // If MPI comm, pack all the properties of the particles in the send buffer (sent even if empty)
+            cuParticles.pack_parts( vecSpecies[ispec]->MPIbuff.part_index_send[iDim][iNeighbor].data(), n_part_send, vecSpecies[ispec]->MPIbuff.partSendBuffer[iDim][iNeighbor] );
+        }
+        else {
+            //If not MPI comm, copy particles directly in the receive buffer
+            Species* neighborSpecies = (*vecPatch)( neighbor_[iDim][iNeighbor]- h0 )->vecSpecies[ispec];
+            neighborSpecies->MPIbuff.part_index_recv_sz[iDim][(iNeighbor+1)%2] = n_part_send;
+            for (int iPart=0 ; iPart<n_part_send ; iPart++)
+                cuParticles.cp_particle( vecSpecies[ispec]->MPIbuff.part_index_send[iDim][iNeighbor][iPart], neighborSpecies->MPIbuff.partRecv[iDim][(iNeighbor+1)%2] );
+        }
 
     } // END for iNeighbor
 
 } // END prepareParticles(... iDim)
 
 
+// ---------------------------------------------------------------------------------------------------------------------
+// For direction iDim, send the buffers of particles to the MPI neighbours
+// The number of particles is given by the size of the message: no prior exchange of the number of particles
+// ---------------------------------------------------------------------------------------------------------------------
 void Patch::exchParticles(SmileiMPI* smpi, int ispec, Params& params, int iDim, VectorPatch * vecPatch)
 {
-    int n_part_send, n_part_recv;
-
     for (int iNeighbor=0 ; iNeighbor<nbNeighbors_ ; iNeighbor++) {
-
-        // n_part_send : number of particles to send to current neighbor
-        n_part_send = (vecSpecies[ispec]->MPIbuff.part_index_send[iDim][iNeighbor]).size();
-        if ( (neighbor_[iDim][iNeighbor]!=MPI_PROC_NULL) && (n_part_send!=0) ) {
-            // Send particles
-            if (is_a_MPI_neighbor(iDim, iNeighbor)) {
-                // Then send particles
-                int local_hindex = hindex - vecPatch->refHindex_;
-                int tag = buildtag( local_hindex, iDim+1, iNeighbor+3 );
-                vecSpecies[ispec]->typePartSend[(iDim*2)+iNeighbor] = smpi->createMPIparticles( &(vecSpecies[ispec]->MPIbuff.partSend[iDim][iNeighbor]) );
-                MPI_Isend( &((vecSpecies[ispec]->MPIbuff.partSend[iDim][iNeighbor]).position(0,0)), 1, vecSpecies[ispec]->typePartSend[(iDim*2)+iNeighbor], MPI_neighbor_[iDim][iNeighbor], tag, MPI_COMM_WORLD, &(vecSpecies[ispec]->MPIbuff.srequest[iDim][iNeighbor]) );
-            }
-        } // END of Send
-
-        n_part_recv = vecSpecies[ispec]->MPIbuff.part_index_recv_sz[iDim][(iNeighbor+1)%2];
-        if ( (neighbor_[iDim][(iNeighbor+1)%2]!=MPI_PROC_NULL) && (n_part_recv!=0) ) {
-            if (is_a_MPI_neighbor(iDim, (iNeighbor+1)%2)) {
-                // If MPI comm, receive particles in the recv buffer previously initialized.
-                vecSpecies[ispec]->typePartRecv[(iDim*2)+iNeighbor] = smpi->createMPIparticles( &(vecSpecies[ispec]->MPIbuff.partRecv[iDim][(iNeighbor+1)%2]) );
-                int local_hindex = neighbor_[iDim][(iNeighbor+1)%2] - smpi->patch_refHindexes[ MPI_neighbor_[iDim][(iNeighbor+1)%2] ];
-                int tag = buildtag( local_hindex, iDim+1, iNeighbor+3 );
-                MPI_Irecv( &((vecSpecies[ispec]->MPIbuff.partRecv[iDim][(iNeighbor+1)%2]).position(0,0)), 1, vecSpecies[ispec]->typePartRecv[(iDim*2)+iNeighbor], MPI_neighbor_[iDim][(iNeighbor+1)%2], tag, MPI_COMM_WORLD, &(vecSpecies[ispec]->MPIbuff.rrequest[iDim][(iNeighbor+1)%2]) );
-            }
-
-        } // END of Recv
-
+        if ( (neighbor_[iDim][iNeighbor]!=MPI_PROC_NULL) && is_a_MPI_neighbor(iDim, iNeighbor) ) {
+            std::vector<char> &buffer = vecSpecies[ispec]->MPIbuff.partSendBuffer[iDim][iNeighbor];
+            int local_hindex = hindex - vecPatch->refHindex_;
+            int tag = buildtag( local_hindex, iDim+1, iNeighbor+3 );
+            MPI_Isend( buffer.data(), buffer.size(), MPI_BYTE, MPI_neighbor_[iDim][iNeighbor], tag, smpi->getParticleExchangeComm(), &(vecSpecies[ispec]->MPIbuff.srequest[iDim][iNeighbor]) );
+        }
     } // END for iNeighbor
 
 } // END exchParticles(... iDim)
 
 
 // ---------------------------------------------------------------------------------------------------------------------
-// For direction iDim, finalize receive of particles, temporary store particles if diagonalParticles
-// And store recv particles at their definitive place.
-// Call Patch::cleanup_sent_particles
-//   - vecPatch : used for intra-MPI process comm (direct copy using Particels::cp_particles)
-//   - smpi     : used smpi->periods_
+// For direction iDim, receive the particles of the MPI neighbours and unpack them in the receive buffers
+// Wait for the end of the sends
 // ---------------------------------------------------------------------------------------------------------------------
 void Patch::finalizeExchParticles(SmileiMPI* smpi, int ispec, Params& params, int iDim, VectorPatch * vecPatch)
 {
+    Particles &cuParticles = (*vecSpecies[ispec]->particles);
+    unsigned int packed_size = cuParticles.packed_size();
 
-#ifdef  __DETAILED_TIMERS
-    double timer;
-#endif
-
-    int n_part_send, n_part_recv;
-
-    /********************************************************************************/
-    // Wait for end of communications over Particles
-    /********************************************************************************/
     for (int iNeighbor=0 ; iNeighbor<nbNeighbors_ ; iNeighbor++) {
-        MPI_Status sstat    [2];
-        MPI_Status rstat    [2];
-
-        n_part_send = vecSpecies[ispec]->MPIbuff.part_index_send[iDim][iNeighbor].size();
-        n_part_recv = vecSpecies[ispec]->MPIbuff.part_index_recv_sz[iDim][(iNeighbor+1)%2];
-
-        if ( (neighbor_[iDim][iNeighbor]!=MPI_PROC_NULL) && (n_part_send!=0) ) {
-            if (is_a_MPI_neighbor(iDim, iNeighbor)) {
-                MPI_Wait( &(vecSpecies[ispec]->MPIbuff.srequest[iDim][iNeighbor]), &(sstat[iNeighbor]) );
-                MPI_Type_free( &(vecSpecies[ispec]->typePartSend[(iDim*2)+iNeighbor]) );
-            }
-        }
-        if ( (neighbor_[iDim][(iNeighbor+1)%2]!=MPI_PROC_NULL) && (n_part_recv!=0) ) {
-            if (is_a_MPI_neighbor(iDim, (iNeighbor+1)%2)) {
-                MPI_Wait( &(vecSpecies[ispec]->MPIbuff.rrequest[iDim][(iNeighbor+1)%2]), &(rstat[(iNeighbor+1)%2]) );
-                MPI_Type_free( &(vecSpecies[ispec]->typePartRecv[(iDim*2)+iNeighbor]) );
+        if ( (neighbor_[iDim][(iNeighbor+1)%2]!=MPI_PROC_NULL) && is_a_MPI_neighbor(iDim, (iNeighbor+1)%2) ) {
+            // Size of the message, then reception in the byte buffer
+            int local_hindex = neighbor_[iDim][(iNeighbor+1)%2] - smpi->patch_refHindexes[ MPI_neighbor_[iDim][(iNeighbor+1)%2] ];
+            int tag = buildtag( local_hindex, iDim+1, iNeighbor+3 );
+            MPI_Message message;
+            MPI_Status status;
+            MPI_Mprobe( MPI_neighbor_[iDim][(iNeighbor+1)%2], tag, smpi->getParticleExchangeComm(), &message, &status );
+            int size;
+            MPI_Get_count( &status, MPI_BYTE, &size );
+            std::vector<char> &buffer = vecSpecies[ispec]->MPIbuff.partRecvBuffer[iDim][(iNeighbor+1)%2];
+            buffer.resize( size );
+            MPI_Mrecv( buffer.data(), size, MPI_BYTE, &message, MPI_STATUS_IGNORE );
+
+            unsigned int n_part_recv = size / packed_size;
+            vecSpecies[ispec]->MPIbuff.part_index_recv_sz[iDim][(iNeighbor+1)%2] = n_part_recv;
+            if (n_part_recv!=0) {
+                vecSpecies[ispec]->MPIbuff.partRecv[iDim][(iNeighbor+1)%2].initialize( n_part_recv, cuParticles );
+                vecSpecies[ispec]->MPIbuff.partRecv[iDim][(iNeighbor+1)%2].unpack_parts( buffer.data(), n_part_recv );
             }
         }
     }
-}
+
+} // END finalizeExchParticles(... iDim)
 
 void Patch::cornersParticles(SmileiMPI* smpi, int ispec, Params& params, int iDim, VectorPatch * vecPatch)
 {
@@ -699,7 +609,14 @@ void Patch::cornersParticles(SmileiMPI* smpi, int ispec, Params& params, int iDi
 
     /********************************************************************************/
     // Wait for end of communications over Particles
+    // (the sends are completed once all the patches received their particles:
+    // waiting for them in finalizeExchParticles could deadlock with large messages)
     /********************************************************************************/
+    for (int iNeighbor=0 ; iNeighbor<nbNeighbors_ ; iNeighbor++) {
+        if ( (neighbor_[iDim][iNeighbor]!=MPI_PROC_NULL) && is_a_MPI_neighbor(iDim, iNeighbor) )
+            MPI_Wait( &(vecSpecies[ispec]->MPIbuff.srequest[iDim][iNeighbor]), MPI_STATUS_IGNORE );
+    }
+
     for (int iNeighbor=0 ; iNeighbor<nbNeighbors_ ; iNeighbor++) {
 
         n_part_recv = vecSpecies[ispec]->MPIbuff.part_index_recv_sz[iDim][(iNeighbor+1)%2];
@@ -815,8 +732,8 @@ void Patch::cleanParticlesOverhead(Params& params)
             for ( int iNeighbor=0 ; iNeighbor<nbNeighbors_ ; iNeighbor++ ) {
                 vecSpecies[ispec]->MPIbuff.partRecv[idim][iNeighbor].clear();
                 vecSpecies[ispec]->MPIbuff.partRecv[idim][iNeighbor].shrink_to_fit(ndim);
-                vecSpecies[ispec]->MPIbuff.partSend[idim][iNeighbor].clear();
-                vecSpecies[ispec]->MPIbuff.partSend[idim][iNeighbor].shrink_to_fit(ndim);
+                vector<char>().swap( vecSpecies[ispec]->MPIbuff.partSendBuffer[idim][iNeighbor] );
+                vector<char>().swap( vecSpecies[ispec]->MPIbuff.partRecvBuffer[idim][iNeighbor] );
                 vecSpecies[ispec]->MPIbuff.part_index_send[idim][iNeighbor].clear();
                 vector<int>(vecSpecies[ispec]->MPIbuff.part_index_send[idim][iNeighbor]).swap(vecSpecies[ispec]->MPIbuff.part_index_send[idim][iNeighbor]);
             }
@@ -12,6 +12,7 @@
 #include "PartWall.h"
 #include "Interpolator.h"
 #include "Projector.h"
+#include "Random.h"
 
 class DomainDecomposition;
 class Collisions;
@@ -29,6 +30,8 @@ class Patch
     friend class SimWindow;
     friend class SyncVectorPatch;
     friend class AsyncMPIbuffers;
+    friend class PoissonMultigrid;
+    friend class AggregatedExchange;
 public:
     //! Constructor for Patch
     Patch(Params& params, SmileiMPI* smpi, DomainDecomposition* domain_decomposition, unsigned int ipatch, unsigned int n_moved);
@@ -90,20 +93,18 @@ public:
     //! Timers for the patch
     std::vector<double> patch_timers;
 #endif
+
+    //! Time spent in the patch computations since the last load balancing
+    double load_timer;
+    //! Number of timesteps accumulated in load_timer
+    unsigned int load_timer_steps;
+    //! Smoothed measured load of the patch (time per timestep), negative if never measured
+    double measured_load;
+    //! Time spent in the particle dynamics of the patch at the last timestep (orders the tasks of VectorPatch::dynamics)
+    double dynamics_time;
     
-	//! Random number generator
-    inline uint32_t xorshift32()
-    {
-        /* Algorithm "xor" from p. 4 of Marsaglia, "Xorshift RNGs" */
-        xorshift32_state ^= xorshift32_state << 13;
-        xorshift32_state ^= xorshift32_state >> 17;
-        xorshift32_state ^= xorshift32_state << 5;
-        return xorshift32_state;
-    }
-    //! State of the random number generator
-    uint32_t xorshift32_state;
-    //! Inverse of the maximum value of the random number generator
-    const double xorshift32_invmax = 1./4294967296.;
+    //! Random number generator of the patch, shared by its species and collisions
+    Random* rand_;
     
     // MPI exchange/sum methods for particles/fields
     //   - fields communication specified per geometry (pure virtual)
@@ -113,17 +114,13 @@ public:
     void cleanMPIBuffers(int ispec, Params& params);
     //! manage Idx of particles per direction,
     void initExchParticles(SmileiMPI* smpi, int ispec, Params& params);
-    //! init comm  nbr of particles
-    void exchNbrOfParticles(SmileiMPI* smpi, int ispec, Params& params, int iDim, VectorPatch* vecPatch);
-    //! finalize comm / nbr of particles, init exch / particles
-    void endNbrOfParticles(SmileiMPI* smpi, int ispec, Params& params, int iDim, VectorPatch* vecPatch);
-    //! extract particles from main data structure to buffers, init exch / particles
+    //! apply periodicity, pack particles sent over MPI in byte buffers, copy the others in the neighbours' receive buffers
     void prepareParticles(SmileiMPI* smpi, int ispec, Params& params, int iDim, VectorPatch* vecPatch);
-    //! effective exchange of particles   
+    //! init exch / particles (one message per MPI neighbour, its size giving the number of particles)
     void exchParticles(SmileiMPI* smpi, int ispec, Params& params, int iDim, VectorPatch* vecPatch);
-    //! finalize exch / particles
+    //! finalize exch / particles, unpack received particles
     void finalizeExchParticles(SmileiMPI* smpi, int ispec, Params& params, int iDim, VectorPatch* vecPatch);
-    //! Treat diagonalParticles
+    //! Wait for the sends, treat diagonalParticles
     void cornersParticles(SmileiMPI* smpi, int ispec, Params& params, int iDim, VectorPatch* vecPatch);
     //! inject particles received in main data structure and particles sorting
     void injectParticles(SmileiMPI* smpi, int ispec, Params& params, VectorPatch* vecPatch);
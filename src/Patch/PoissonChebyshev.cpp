@@ -0,0 +1,65 @@
+
+#include "PoissonChebyshev.h"
+
+#include "VectorPatch.h"
+#include "Field.h"
+
+using namespace std;
+
+PoissonChebyshev::PoissonChebyshev( Params &params, VectorPatch &vecPatches, double gamma_mean )
+    : PoissonPreconditioner( params, vecPatches, gamma_mean )
+{
+    degree_     = params.poisson_chebyshev_degree;
+    lambda_max_ = 2.;
+    lambda_min_ = lambda_max_/(double)( degree_*degree_ );
+
+    res_ = newFields( vecPatches );
+    d_   = newFields( vecPatches );
+    Ad_  = newFields( vecPatches );
+}
+
+
+PoissonChebyshev::~PoissonChebyshev()
+{
+    deleteFields( res_ );
+    deleteFields( d_ );
+    deleteFields( Ad_ );
+}
+
+
+void PoissonChebyshev::precondition( VectorPatch &vecPatches, SmileiMPI *smpi, vector<Field *> &in, vector<Field *> &out )
+{
+    // Chebyshev iteration on D^-1 A out = D^-1 in, starting from out = 0
+    double theta = 0.5*( lambda_max_ + lambda_min_ );
+    double delta = 0.5*( lambda_max_ - lambda_min_ );
+    // Degree 1 is the Jacobi preconditioner
+    double sigma = degree_>1 ? theta/delta : 0.;
+    double rho   = degree_>1 ? 1./sigma : 0.;
+
+    for( unsigned int ipatch=0; ipatch<in.size(); ipatch++ ) {
+        double *pin  = &( *in  [ipatch] )( 0 );
+        double *pout = &( *out [ipatch] )( 0 );
+        double *pres = &( *res_[ipatch] )( 0 );
+        double *pd   = &( *d_  [ipatch] )( 0 );
+        for( unsigned int idx=0; idx<in[ipatch]->globalDims_; idx++ ) {
+            pres[idx] = pin[idx]/diag_;
+            pd  [idx] = pres[idx]/theta;
+            pout[idx] = 0.;
+        }
+    }
+
+    for( unsigned int k=1; k<degree_; k++ ) {
+        axpy( out, 1., d_ );
+        laplacian( vecPatches, smpi, d_, Ad_ );
+        axpy( res_, -1./diag_, Ad_ );
+        double rho_new = 1./( 2.*sigma - rho );
+        for( unsigned int ipatch=0; ipatch<in.size(); ipatch++ ) {
+            double *pres = &( *res_[ipatch] )( 0 );
+            double *pd   = &( *d_  [ipatch] )( 0 );
+            for( unsigned int idx=0; idx<in[ipatch]->globalDims_; idx++ )
+                pd[idx] = rho_new*rho*pd[idx] + 2.*rho_new/delta*pres[idx];
+        }
+        rho = rho_new;
+    }
+    axpy( out, 1., d_ );
+}
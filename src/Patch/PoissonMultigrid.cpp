@@ -0,0 +1,504 @@
+
+#include "PoissonMultigrid.h"
+
+#include <cmath>
+
+#include "VectorPatch.h"
+#include "SyncVectorPatch.h"
+#include "DomainDecomposition.h"
+#include "Field.h"
+#include "Tools.h"
+
+using namespace std;
+
+// Copy plane q (along iDim) of a, ghost cells of the other dimensions included, into buf
+static void pack_plane( const double *a, unsigned int ext[3], unsigned int iDim, unsigned int q, double *buf )
+{
+    unsigned int stride[3] = { ext[1]*ext[2], ext[2], 1 };
+    unsigned int d1 = (iDim+1)%3, d2 = (iDim+2)%3;
+    unsigned int n = 0;
+    for( unsigned int i1=0; i1<ext[d1]; i1++ )
+        for( unsigned int i2=0; i2<ext[d2]; i2++ )
+            buf[n++] = a[q*stride[iDim] + i1*stride[d1] + i2*stride[d2]];
+}
+
+// Copy buf into plane q (along iDim) of a
+static void unpack_plane( double *a, unsigned int ext[3], unsigned int iDim, unsigned int q, const double *buf )
+{
+    unsigned int stride[3] = { ext[1]*ext[2], ext[2], 1 };
+    unsigned int d1 = (iDim+1)%3, d2 = (iDim+2)%3;
+    unsigned int n = 0;
+    for( unsigned int i1=0; i1<ext[d1]; i1++ )
+        for( unsigned int i2=0; i2<ext[d2]; i2++ )
+            a[q*stride[iDim] + i1*stride[d1] + i2*stride[d2]] = buf[n++];
+}
+
+
+PoissonMultigrid::PoissonMultigrid( Params &params, VectorPatch &vecPatches, double gamma_mean )
+    : PoissonPreconditioner( params, vecPatches, gamma_mean )
+{
+    omega_    = 2.*ndim_/(2.*ndim_+1.);
+    nsmooth_  = 2;
+
+    // Finest level: the n_space nodes owned by each patch
+    n_.push_back( vector<unsigned int>( params.n_space.begin(), params.n_space.begin()+ndim_ ) );
+    level_coef_.push_back( coef_ );
+
+    // Coarser levels, as long as all the patch sizes can be halved
+    while( true ) {
+        bool can_coarsen = true;
+        for( unsigned int iDim=0; iDim<ndim_; iDim++ )
+            if( n_.back()[iDim]%2 != 0 ) can_coarsen = false;
+        if( !can_coarsen ) break;
+        vector<unsigned int> n( ndim_ );
+        vector<double> coef( ndim_ );
+        for( unsigned int iDim=0; iDim<ndim_; iDim++ ) {
+            n[iDim]    = n_.back()[iDim]/2;
+            coef[iDim] = level_coef_.back()[iDim]*0.25;
+        }
+        n_.push_back( n );
+        level_coef_.push_back( coef );
+    }
+    nlevels_ = n_.size()-1;
+
+    // Arrays of each level
+    u_.resize( n_.size() );
+    f_.resize( n_.size() );
+    w_.resize( n_.size() );
+    for( unsigned int level=0; level<n_.size(); level++ ) {
+        unsigned int ext[3];
+        extents( level, ext );
+        u_[level].resize( vecPatches.size(), vector<double>( ext[0]*ext[1]*ext[2], 0. ) );
+        f_[level].resize( vecPatches.size(), vector<double>( ext[0]*ext[1]*ext[2], 0. ) );
+        w_[level].resize( vecPatches.size(), vector<double>( ext[0]*ext[1]*ext[2], 0. ) );
+    }
+
+    // Coarse problem on the whole domain
+    coarse_n_.resize( ndim_ );
+    periodic_.resize( ndim_ );
+    unsigned int coarse_size = 1;
+    bool all_periodic = true;
+    for( unsigned int iDim=0; iDim<ndim_; iDim++ ) {
+        coarse_n_[iDim] = params.number_of_patches[iDim]*n_[nlevels_][iDim];
+        coarse_size *= coarse_n_[iDim];
+        periodic_[iDim] = ( params.EM_BCs[iDim][0] == "periodic" );
+        all_periodic = all_periodic && periodic_[iDim];
+    }
+    // A fully periodic Laplacian is singular: keep the coarse problem invertible
+    if( all_periodic ) periodic_[0] = false;
+    if( coarse_size > (1<<20) )
+        WARNING( "Multigrid Poisson solver: the coarse grid holds " << coarse_size << " nodes. Use patch sizes with larger powers of 2." );
+
+    patch_coordinates_.resize( params.tot_number_of_patches );
+    for( unsigned int h=0; h<params.tot_number_of_patches; h++ )
+        patch_coordinates_[h] = vecPatches.domain_decomposition_->getDomainCoordinates( h );
+
+    int nranks;
+    MPI_Comm_size( MPI_COMM_WORLD, &nranks );
+    int coarse_count = vecPatches.size();
+    for( unsigned int iDim=0; iDim<ndim_; iDim++ ) coarse_count *= n_[nlevels_][iDim];
+    coarse_counts_.resize( nranks );
+    coarse_displs_.resize( nranks, 0 );
+    MPI_Allgather( &coarse_count, 1, MPI_INT, &coarse_counts_[0], 1, MPI_INT, MPI_COMM_WORLD );
+    for( int irk=1; irk<nranks; irk++ )
+        coarse_displs_[irk] = coarse_displs_[irk-1] + coarse_counts_[irk-1];
+}
+
+
+void PoissonMultigrid::extents( unsigned int level, unsigned int ext[3] )
+{
+    for( unsigned int iDim=0; iDim<3; iDim++ )
+        ext[iDim] = iDim<ndim_ ? n_[level][iDim]+2 : 1;
+}
+
+
+void PoissonMultigrid::exchange( unsigned int level, vector<vector<double> > &a, VectorPatch &vecPatches, SmileiMPI *smpi )
+{
+    unsigned int ext[3];
+    extents( level, ext );
+    int h0 = vecPatches( 0 )->hindex;
+
+    // One dimension after the other, so that the corners are filled too
+    for( unsigned int iDim=0; iDim<ndim_; iDim++ ) {
+        unsigned int plane_size = ext[0]*ext[1]*ext[2]/ext[iDim];
+        unsigned int last = n_[level][iDim];
+        vector<vector<double> > sendbuf, recvbuf;
+        vector<unsigned int> recv_patch, recv_side;
+        vector<MPI_Request> requests;
+        sendbuf.reserve( 2*vecPatches.size() );
+        recvbuf.reserve( 2*vecPatches.size() );
+        requests.reserve( 4*vecPatches.size() );
+
+        for( unsigned int ipatch=0; ipatch<vecPatches.size(); ipatch++ ) {
+            Patch *patch = vecPatches( ipatch );
+            for( int side=0; side<2; side++ ) {
+                int hneighbor = patch->neighbor_[iDim][side];
+                unsigned int ghost = side==0 ? 0 : last+1;
+                if( hneighbor == MPI_PROC_NULL ) {
+                    // Homogeneous Dirichlet condition on the boundaries of the domain
+                    vector<double> zero( plane_size, 0. );
+                    unpack_plane( &a[ipatch][0], ext, iDim, ghost, &zero[0] );
+                } else if( patch->MPI_neighbor_[iDim][side] == patch->MPI_me_ ) {
+                    vector<double> plane( plane_size );
+                    pack_plane( &a[hneighbor-h0][0], ext, iDim, side==0 ? last : 1, &plane[0] );
+                    unpack_plane( &a[ipatch][0], ext, iDim, ghost, &plane[0] );
+                } else {
+                    int rank = patch->MPI_neighbor_[iDim][side];
+                    sendbuf.push_back( vector<double>( plane_size ) );
+                    pack_plane( &a[ipatch][0], ext, iDim, side==0 ? 1 : last, &sendbuf.back()[0] );
+                    requests.push_back( MPI_Request() );
+                    MPI_Isend( &sendbuf.back()[0], plane_size, MPI_DOUBLE, rank, ( patch->hindex*3+iDim )*2+side, MPI_COMM_WORLD, &requests.back() );
+                    recvbuf.push_back( vector<double>( plane_size ) );
+                    recv_patch.push_back( ipatch );
+                    recv_side.push_back( side );
+                    requests.push_back( MPI_Request() );
+                    MPI_Irecv( &recvbuf.back()[0], plane_size, MPI_DOUBLE, rank, ( hneighbor*3+iDim )*2+1-side, MPI_COMM_WORLD, &requests.back() );
+                }
+            }
+        }
+
+        if( requests.size() > 0 )
+            MPI_Waitall( requests.size(), &requests[0], MPI_STATUSES_IGNORE );
+        for( unsigned int irecv=0; irecv<recvbuf.size(); irecv++ )
+            unpack_plane( &a[recv_patch[irecv]][0], ext, iDim, recv_side[irecv]==0 ? 0 : last+1, &recvbuf[irecv][0] );
+    }
+}
+
+
+void PoissonMultigrid::smooth( unsigned int level, VectorPatch &vecPatches, SmileiMPI *smpi )
+{
+    exchange( level, u_[level], vecPatches, smpi );
+
+    unsigned int ext[3], stride[3], hi[3];
+    extents( level, ext );
+    stride[0] = ext[1]*ext[2];
+    stride[1] = ext[2];
+    stride[2] = 1;
+    for( unsigned int iDim=0; iDim<3; iDim++ ) hi[iDim] = iDim<ndim_ ? n_[level][iDim] : 0;
+    unsigned int lo = 1;
+    double diag = 0.;
+    for( unsigned int iDim=0; iDim<ndim_; iDim++ ) diag -= 2.*level_coef_[level][iDim];
+
+    for( unsigned int ipatch=0; ipatch<vecPatches.size(); ipatch++ ) {
+        double *u = &u_[level][ipatch][0];
+        double *f = &f_[level][ipatch][0];
+        double *w = &w_[level][ipatch][0];
+        for( unsigned int i=lo; i<=hi[0]; i++ ) {
+            for( unsigned int j=(ndim_>1?lo:0); j<=hi[1]; j++ ) {
+                for( unsigned int k=(ndim_>2?lo:0); k<=hi[2]; k++ ) {
+                    unsigned int idx = i*stride[0] + j*stride[1] + k;
+                    double Au = 0.;
+                    for( unsigned int iDim=0; iDim<ndim_; iDim++ )
+                        Au += level_coef_[level][iDim]*( u[idx+stride[iDim]] + u[idx-stride[iDim]] - 2.*u[idx] );
+                    w[idx] = u[idx] + omega_*( f[idx] - Au )/diag;
+                }
+            }
+        }
+        for( unsigned int i=lo; i<=hi[0]; i++ )
+            for( unsigned int j=(ndim_>1?lo:0); j<=hi[1]; j++ )
+                for( unsigned int k=(ndim_>2?lo:0); k<=hi[2]; k++ )
+                    u[i*stride[0] + j*stride[1] + k] = w[i*stride[0] + j*stride[1] + k];
+    }
+}
+
+
+void PoissonMultigrid::residual( unsigned int level, VectorPatch &vecPatches, SmileiMPI *smpi )
+{
+    exchange( level, u_[level], vecPatches, smpi );
+
+    unsigned int ext[3], stride[3], hi[3];
+    extents( level, ext );
+    stride[0] = ext[1]*ext[2];
+    stride[1] = ext[2];
+    stride[2] = 1;
+    for( unsigned int iDim=0; iDim<3; iDim++ ) hi[iDim] = iDim<ndim_ ? n_[level][iDim] : 0;
+    unsigned int lo = 1;
+
+    for( unsigned int ipatch=0; ipatch<vecPatches.size(); ipatch++ ) {
+        double *u = &u_[level][ipatch][0];
+        double *f = &f_[level][ipatch][0];
+        double *w = &w_[level][ipatch][0];
+        for( unsigned int i=lo; i<=hi[0]; i++ ) {
+            for( unsigned int j=(ndim_>1?lo:0); j<=hi[1]; j++ ) {
+                for( unsigned int k=(ndim_>2?lo:0); k<=hi[2]; k++ ) {
+                    unsigned int idx = i*stride[0] + j*stride[1] + k;
+                    double Au = 0.;
+                    for( unsigned int iDim=0; iDim<ndim_; iDim++ )
+                        Au += level_coef_[level][iDim]*( u[idx+stride[iDim]] + u[idx-stride[iDim]] - 2.*u[idx] );
+                    w[idx] = f[idx] - Au;
+                }
+            }
+        }
+    }
+
+    // The restriction needs the residual of the neighbours
+    exchange( level, w_[level], vecPatches, smpi );
+}
+
+
+void PoissonMultigrid::restrict_residual( unsigned int level )
+{
+    unsigned int ext[3], cext[3], stride[3], cstride[3], hi[3];
+    extents( level, ext );
+    extents( level+1, cext );
+    stride[0] = ext[1]*ext[2];
+    stride[1] = ext[2];
+    stride[2] = 1;
+    cstride[0] = cext[1]*cext[2];
+    cstride[1] = cext[2];
+    cstride[2] = 1;
+    for( unsigned int iDim=0; iDim<3; iDim++ ) hi[iDim] = iDim<ndim_ ? n_[level+1][iDim] : 0;
+    int omax[3];
+    for( unsigned int iDim=0; iDim<3; iDim++ ) omax[iDim] = iDim<ndim_ ? 1 : 0;
+    const double weight[3] = { 0.25, 0.5, 0.25 };
+
+    // Full weighting: coarse node I sits on fine node 2I
+    for( unsigned int ipatch=0; ipatch<f_[level+1].size(); ipatch++ ) {
+        double *w  = &w_[level][ipatch][0];
+        double *fc = &f_[level+1][ipatch][0];
+        for( unsigned int I=1; I<=hi[0]; I++ ) {
+            for( unsigned int J=(ndim_>1?1:0); J<=hi[1]; J++ ) {
+                for( unsigned int K=(ndim_>2?1:0); K<=hi[2]; K++ ) {
+                    unsigned int i = 2*I-1;
+                    unsigned int j = ndim_>1 ? 2*J-1 : 0;
+                    unsigned int k = ndim_>2 ? 2*K-1 : 0;
+                    double sum = 0.;
+                    for( int oi=-omax[0]; oi<=omax[0]; oi++ ) {
+                        for( int oj=-omax[1]; oj<=omax[1]; oj++ ) {
+                            for( int ok=-omax[2]; ok<=omax[2]; ok++ ) {
+                                double wt = ( omax[0] ? weight[oi+1] : 1. )
+                                    *       ( omax[1] ? weight[oj+1] : 1. )
+                                    *       ( omax[2] ? weight[ok+1] : 1. );
+                                sum += wt * w[(i+oi)*stride[0] + (j+oj)*stride[1] + (k+ok)];
+                            }
+                        }
+                    }
+                    fc[I*cstride[0] + J*cstride[1] + K] = sum;
+                }
+            }
+        }
+    }
+}
+
+
+void PoissonMultigrid::prolongate( unsigned int level )
+{
+    unsigned int ext[3], cext[3], stride[3], cstride[3], hi[3];
+    extents( level, ext );
+    extents( level+1, cext );
+    stride[0] = ext[1]*ext[2];
+    stride[1] = ext[2];
+    stride[2] = 1;
+    cstride[0] = cext[1]*cext[2];
+    cstride[1] = cext[2];
+    cstride[2] = 1;
+    for( unsigned int iDim=0; iDim<3; iDim++ ) hi[iDim] = iDim<ndim_ ? n_[level][iDim] : 0;
+
+    // Linear interpolation: fine node 2I gets coarse node I, fine node 2I+1 the mean of I and I+1
+    for( unsigned int ipatch=0; ipatch<u_[level].size(); ipatch++ ) {
+        double *u  = &u_[level][ipatch][0];
+        double *uc = &u_[level+1][ipatch][0];
+        for( unsigned int i=1; i<=hi[0]; i++ ) {
+            unsigned int I = (i-1)/2+1, oi = (i-1)%2;
+            for( unsigned int j=(ndim_>1?1:0); j<=hi[1]; j++ ) {
+                unsigned int J = ndim_>1 ? (j-1)/2+1 : 0, oj = ndim_>1 ? (j-1)%2 : 0;
+                for( unsigned int k=(ndim_>2?1:0); k<=hi[2]; k++ ) {
+                    unsigned int K = ndim_>2 ? (k-1)/2+1 : 0, ok = ndim_>2 ? (k-1)%2 : 0;
+                    double sum = 0.;
+                    for( unsigned int di=0; di<=oi; di++ )
+                        for( unsigned int dj=0; dj<=oj; dj++ )
+                            for( unsigned int dk=0; dk<=ok; dk++ )
+                                sum += uc[(I+di)*cstride[0] + (J+dj)*cstride[1] + (K+dk)];
+                    u[i*stride[0] + j*stride[1] + k] += sum / (double)( (1+oi)*(1+oj)*(1+ok) );
+                }
+            }
+        }
+    }
+}
+
+
+void PoissonMultigrid::coarse_solve( VectorPatch &vecPatches )
+{
+    unsigned int level = nlevels_;
+    unsigned int ext[3], stride[3], n[3], N[3], Nstride[3];
+    extents( level, ext );
+    stride[0] = ext[1]*ext[2];
+    stride[1] = ext[2];
+    stride[2] = 1;
+    for( unsigned int iDim=0; iDim<3; iDim++ ) {
+        n[iDim] = iDim<ndim_ ? n_[level][iDim] : 1;
+        N[iDim] = iDim<ndim_ ? coarse_n_[iDim] : 1;
+    }
+    Nstride[0] = N[1]*N[2];
+    Nstride[1] = N[2];
+    Nstride[2] = 1;
+    unsigned int Ntot = N[0]*N[1]*N[2];
+    unsigned int nloc = n[0]*n[1]*n[2];
+    unsigned int off = ext[0]>1 ? 1 : 0; // ghost offset along used dimensions
+
+    // Gather the sources of all patches, ordered by hindex
+    vector<double> local( vecPatches.size()*nloc ), all( Ntot );
+    for( unsigned int ipatch=0; ipatch<vecPatches.size(); ipatch++ )
+        for( unsigned int i=0; i<n[0]; i++ )
+            for( unsigned int j=0; j<n[1]; j++ )
+                for( unsigned int k=0; k<n[2]; k++ )
+                    local[ipatch*nloc + (i*n[1]+j)*n[2]+k] = f_[level][ipatch][(i+off)*stride[0] + (j+(ndim_>1))*stride[1] + (k+(ndim_>2))];
+    MPI_Allgatherv( &local[0], local.size(), MPI_DOUBLE, &all[0], &coarse_counts_[0], &coarse_displs_[0], MPI_DOUBLE, MPI_COMM_WORLD );
+
+    vector<double> b( Ntot ), x( Ntot, 0. ), r( Ntot ), p( Ntot ), Ap( Ntot );
+    for( unsigned int h=0; h<patch_coordinates_.size(); h++ ) {
+        unsigned int c[3] = { 0, 0, 0 };
+        for( unsigned int iDim=0; iDim<ndim_; iDim++ ) c[iDim] = patch_coordinates_[h][iDim]*n[iDim];
+        for( unsigned int i=0; i<n[0]; i++ )
+            for( unsigned int j=0; j<n[1]; j++ )
+                for( unsigned int k=0; k<n[2]; k++ )
+                    b[(c[0]+i)*Nstride[0] + (c[1]+j)*Nstride[1] + c[2]+k] = all[h*nloc + (i*n[1]+j)*n[2]+k];
+    }
+
+    // Conjugate gradient on the coarse grid, solved redundantly by all ranks
+    double rr = 0.;
+    for( unsigned int idx=0; idx<Ntot; idx++ ) {
+        r[idx] = b[idx];
+        p[idx] = b[idx];
+        rr += b[idx]*b[idx];
+    }
+    double rr_max = 1.e-24*rr;
+    for( unsigned int iteration=0; iteration<10*Ntot && rr>rr_max; iteration++ ) {
+        double pAp = 0.;
+        for( unsigned int i=0; i<N[0]; i++ ) {
+            for( unsigned int j=0; j<N[1]; j++ ) {
+                for( unsigned int k=0; k<N[2]; k++ ) {
+                    unsigned int ijk[3] = { i, j, k };
+                    unsigned int idx = i*Nstride[0] + j*Nstride[1] + k;
+                    double Apv = 0.;
+                    for( unsigned int iDim=0; iDim<ndim_; iDim++ ) {
+                        double pm = 0., pp = 0.;
+                        if( ijk[iDim] > 0 )               pm = p[idx-Nstride[iDim]];
+                        else if( periodic_[iDim] )        pm = p[idx+(N[iDim]-1)*Nstride[iDim]];
+                        if( ijk[iDim] < N[iDim]-1 )       pp = p[idx+Nstride[iDim]];
+                        else if( periodic_[iDim] )        pp = p[idx-(N[iDim]-1)*Nstride[iDim]];
+                        Apv += level_coef_[level][iDim]*( pm + pp - 2.*p[idx] );
+                    }
+                    Ap[idx] = Apv;
+                    pAp += p[idx]*Apv;
+                }
+            }
+        }
+        double alpha = rr/pAp;
+        double rr_new = 0.;
+        for( unsigned int idx=0; idx<Ntot; idx++ ) {
+            x[idx] += alpha*p[idx];
+            r[idx] -= alpha*Ap[idx];
+            rr_new += r[idx]*r[idx];
+        }
+        for( unsigned int idx=0; idx<Ntot; idx++ )
+            p[idx] = r[idx] + rr_new/rr*p[idx];
+        rr = rr_new;
+    }
+
+    // Scatter the solution to the local patches, ghost layer included
+    for( unsigned int ipatch=0; ipatch<vecPatches.size(); ipatch++ ) {
+        unsigned int h = vecPatches( ipatch )->hindex;
+        int c[3] = { 0, 0, 0 };
+        for( unsigned int iDim=0; iDim<ndim_; iDim++ ) c[iDim] = patch_coordinates_[h][iDim]*n[iDim] - 1;
+        double *u = &u_[level][ipatch][0];
+        for( unsigned int i=0; i<ext[0]; i++ ) {
+            for( unsigned int j=0; j<ext[1]; j++ ) {
+                for( unsigned int k=0; k<ext[2]; k++ ) {
+                    int g[3] = { c[0]+(int)i, c[1]+(int)j, c[2]+(int)k };
+                    bool outside = false;
+                    for( unsigned int iDim=0; iDim<ndim_; iDim++ ) {
+                        if( g[iDim] < 0 || g[iDim] >= (int)N[iDim] ) {
+                            if( periodic_[iDim] ) g[iDim] = ( g[iDim] + N[iDim] ) % N[iDim];
+                            else outside = true;
+                        }
+                    }
+                    u[i*stride[0] + j*stride[1] + k] = outside ? 0. : x[g[0]*Nstride[0] + g[1]*Nstride[1] + g[2]];
+                }
+            }
+        }
+    }
+}
+
+
+void PoissonMultigrid::vcycle( unsigned int level, VectorPatch &vecPatches, SmileiMPI *smpi )
+{
+    if( level == nlevels_ ) {
+        coarse_solve( vecPatches );
+        return;
+    }
+
+    for( unsigned int ipatch=0; ipatch<u_[level].size(); ipatch++ )
+        fill( u_[level][ipatch].begin(), u_[level][ipatch].end(), 0. );
+    for( unsigned int ismooth=0; ismooth<nsmooth_; ismooth++ )
+        smooth( level, vecPatches, smpi );
+
+    residual( level, vecPatches, smpi );
+    restrict_residual( level );
+    vcycle( level+1, vecPatches, smpi );
+    // The coarse solve fills the ghost cells itself
+    if( level+1 < nlevels_ )
+        exchange( level+1, u_[level+1], vecPatches, smpi );
+    prolongate( level );
+
+    for( unsigned int ismooth=0; ismooth<nsmooth_; ismooth++ )
+        smooth( level, vecPatches, smpi );
+}
+
+
+void PoissonMultigrid::precondition( VectorPatch &vecPatches, SmileiMPI *smpi, vector<Field *> &in, vector<Field *> &out )
+{
+    unsigned int ext[3], stride[3], n[3];
+    extents( 0, ext );
+    stride[0] = ext[1]*ext[2];
+    stride[1] = ext[2];
+    stride[2] = 1;
+    for( unsigned int iDim=0; iDim<3; iDim++ ) n[iDim] = iDim<ndim_ ? n_[0][iDim] : 1;
+    unsigned int g[3];
+    for( unsigned int iDim=0; iDim<3; iDim++ ) g[iDim] = iDim<ndim_ ? 1 : 0;
+
+    // Source of the finest level: the input on the nodes owned by each patch
+    for( unsigned int ipatch=0; ipatch<vecPatches.size(); ipatch++ ) {
+        Field *r = in[ipatch];
+        unsigned int rny = r->dims_.size()>1 ? r->dims_[1] : 1;
+        unsigned int rnz = r->dims_.size()>2 ? r->dims_[2] : 1;
+        for( unsigned int i=0; i<n[0]; i++ )
+            for( unsigned int j=0; j<n[1]; j++ )
+                for( unsigned int k=0; k<n[2]; k++ )
+                    f_[0][ipatch][(i+g[0])*stride[0] + (j+g[1])*stride[1] + k+g[2]]
+                        = ( *r )( ( (i+oversize_[0])*rny + j+oversize_[1] )*rnz + k+oversize_[2] );
+    }
+
+    if( nlevels_ == 0 ) {
+        coarse_solve( vecPatches );
+    } else {
+        vcycle( 0, vecPatches, smpi );
+        // Ghost layer needed for the nodes shared with the next patch
+        exchange( 0, u_[0], vecPatches, smpi );
+    }
+
+    for( unsigned int ipatch=0; ipatch<vecPatches.size(); ipatch++ ) {
+        Patch *patch = vecPatches( ipatch );
+        Field *r = in[ipatch];
+        Field *z = out[ipatch];
+        unsigned int rnx = r->dims_[0];
+        unsigned int rny = r->dims_.size()>1 ? r->dims_[1] : 1;
+        unsigned int rnz = r->dims_.size()>2 ? r->dims_[2] : 1;
+        // Nodes not covered by the multigrid levels (beyond the boundaries of the domain): Jacobi
+        for( unsigned int idx=0; idx<r->globalDims_; idx++ )
+            ( *z )( idx ) = ( *r )( idx )/diag_;
+        // Nodes owned by the patch, and nodes shared with its upper neighbours
+        unsigned int hi[3];
+        for( unsigned int iDim=0; iDim<3; iDim++ ) {
+            hi[iDim] = oversize_[iDim] + n[iDim] - 1;
+            if( iDim<ndim_ && patch->neighbor_[iDim][1] != MPI_PROC_NULL ) hi[iDim]++;
+        }
+        for( unsigned int i=oversize_[0]; i<=hi[0] && i<rnx; i++ )
+            for( unsigned int j=oversize_[1]; j<=hi[1] && j<rny; j++ )
+                for( unsigned int k=oversize_[2]; k<=hi[2] && k<rnz; k++ )
+                    ( *z )( ( i*rny + j )*rnz + k ) = u_[0][ipatch][(i-oversize_[0]+g[0])*stride[0] + (j-oversize_[1]+g[1])*stride[1] + k-oversize_[2]+g[2]];
+    }
+
+    // Ghost cells of z from the neighbouring patches
+    PoissonPreconditioner::exchange( vecPatches, smpi, out );
+}
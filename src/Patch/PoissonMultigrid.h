@@ -0,0 +1,65 @@
+#ifndef POISSONMULTIGRID_H
+#define POISSONMULTIGRID_H
+
+#include <vector>
+
+#include "PoissonPreconditioner.h"
+
+//! Geometric multigrid preconditioner of the Poisson conjugate gradient (Cartesian geometries).
+//!
+//! Each patch owns the n_space primal nodes starting at its origin. Levels are obtained by
+//! halving these nodes inside every patch, as long as the patch size allows it. Smoothing
+//! (weighted Jacobi), full-weighting restriction and linear prolongation use a 1-node ghost
+//! layer exchanged between neighbouring patches, inside or across MPI ranks. The coarsest
+//! level, whose patches hold very few nodes, is gathered on every rank and solved there.
+//! One symmetric V-cycle is applied per CG iteration (M^-1 stays symmetric).
+class PoissonMultigrid : public PoissonPreconditioner
+{
+public:
+    //! Build the levels for the current patch distribution
+    //! \param gamma_mean Lorentz factor of the relativistic Poisson problem (1 for the standard problem)
+    PoissonMultigrid( Params &params, VectorPatch &vecPatches, double gamma_mean );
+    ~PoissonMultigrid() {};
+
+    //! One V-cycle: out = M^-1 in
+    void precondition( VectorPatch &vecPatches, SmileiMPI *smpi, std::vector<Field *> &in, std::vector<Field *> &out ) override;
+
+private:
+    //! Number of levels below the finest
+    unsigned int nlevels_;
+    //! Owned nodes per patch along each dimension, for each level
+    std::vector<std::vector<unsigned int> > n_;
+    //! 1/h^2 along each dimension, for each level
+    std::vector<std::vector<double> > level_coef_;
+    //! Solution, source and work arrays (with a ghost layer) for each level and patch
+    std::vector<std::vector<std::vector<double> > > u_, f_, w_;
+    //! Relaxation factor of the Jacobi smoother, number of pre and post smoothing sweeps
+    double omega_;
+    unsigned int nsmooth_;
+
+    //! Coarse problem: global node counts, periodicity, patch coordinates of every hindex
+    std::vector<unsigned int> coarse_n_;
+    std::vector<bool> periodic_;
+    std::vector<std::vector<unsigned int> > patch_coordinates_;
+    //! Number of coarse values held by each rank (for the gather)
+    std::vector<int> coarse_counts_, coarse_displs_;
+
+    //! Sizes of the arrays of a level, ghost layer included (1 for unused dimensions)
+    void extents( unsigned int level, unsigned int ext[3] );
+    //! Fill the ghost layer of the arrays of a level from the neighbouring patches (0 on non-periodic boundaries)
+    void exchange( unsigned int level, std::vector<std::vector<double> > &a, VectorPatch &vecPatches, SmileiMPI *smpi );
+    //! Weighted Jacobi sweep on u (ghosts of u must be up to date)
+    void smooth( unsigned int level, VectorPatch &vecPatches, SmileiMPI *smpi );
+    //! w = f - A u
+    void residual( unsigned int level, VectorPatch &vecPatches, SmileiMPI *smpi );
+    //! f(level+1) = full-weighting restriction of w(level)
+    void restrict_residual( unsigned int level );
+    //! u(level) += linear interpolation of u(level+1)
+    void prolongate( unsigned int level );
+    //! Solve the coarsest level on the whole domain
+    void coarse_solve( VectorPatch &vecPatches );
+    //! V-cycle starting at level
+    void vcycle( unsigned int level, VectorPatch &vecPatches, SmileiMPI *smpi );
+};
+
+#endif
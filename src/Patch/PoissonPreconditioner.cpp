@@ -0,0 +1,142 @@
+
+#include "PoissonPreconditioner.h"
+
+#include "VectorPatch.h"
+#include "SyncVectorPatch.h"
+#include "Field1D.h"
+#include "Field2D.h"
+#include "Field3D.h"
+
+using namespace std;
+
+PoissonPreconditioner::PoissonPreconditioner( Params &params, VectorPatch &vecPatches, double gamma_mean )
+{
+    ndim_     = params.nDim_field;
+    oversize_ = params.oversize;
+    oversize_.resize( 3, 0 );
+
+    coef_.resize( ndim_ );
+    diag_ = 0.;
+    for( unsigned int iDim=0; iDim<ndim_; iDim++ ) {
+        coef_[iDim] = 1./( params.cell_length[iDim]*params.cell_length[iDim] );
+    }
+    coef_[0] /= gamma_mean*gamma_mean;
+    for( unsigned int iDim=0; iDim<ndim_; iDim++ ) {
+        diag_ -= 2.*coef_[iDim];
+    }
+}
+
+
+void PoissonPreconditioner::precondition( VectorPatch &vecPatches, SmileiMPI *smpi, vector<Field *> &in, vector<Field *> &out )
+{
+    for( unsigned int ipatch=0; ipatch<in.size(); ipatch++ )
+        out[ipatch]->copyFrom( in[ipatch] );
+}
+
+
+vector<Field *> PoissonPreconditioner::newFields( VectorPatch &vecPatches )
+{
+    vector<Field *> fields;
+    for( unsigned int ipatch=0; ipatch<vecPatches.size(); ipatch++ ) {
+        Field *r = vecPatches( ipatch )->EMfields->r_;
+        if( ndim_ == 1 )      fields.push_back( new Field1D( r->dims_ ) );
+        else if( ndim_ == 2 ) fields.push_back( new Field2D( r->dims_ ) );
+        else                  fields.push_back( new Field3D( r->dims_ ) );
+    }
+    return fields;
+}
+
+
+void PoissonPreconditioner::deleteFields( vector<Field *> &fields )
+{
+    for( unsigned int ipatch=0; ipatch<fields.size(); ipatch++ )
+        delete fields[ipatch];
+    fields.clear();
+}
+
+
+void PoissonPreconditioner::laplacian( VectorPatch &vecPatches, SmileiMPI *smpi, vector<Field *> &in, vector<Field *> &out )
+{
+    for( unsigned int ipatch=0; ipatch<in.size(); ipatch++ ) {
+        unsigned int n[3] = { 1, 1, 1 };
+        for( unsigned int iDim=0; iDim<ndim_; iDim++ ) n[iDim] = in[ipatch]->dims_[iDim];
+        unsigned int stride[3] = { n[1]*n[2], n[2], 1 };
+        double *a = &( *in[ipatch] )( 0 );
+        double *b = &( *out[ipatch] )( 0 );
+        // Nodes beyond the arrays count as zero (Dirichlet condition on the non-periodic boundaries,
+        // ghost cells replaced by the exchange otherwise), as in EMfields->compute_Ap
+        for( unsigned int i=0; i<n[0]; i++ ) {
+            for( unsigned int j=0; j<n[1]; j++ ) {
+                for( unsigned int k=0; k<n[2]; k++ ) {
+                    unsigned int ijk[3] = { i, j, k };
+                    unsigned int idx = i*stride[0] + j*stride[1] + k;
+                    double Aa = diag_*a[idx];
+                    for( unsigned int iDim=0; iDim<ndim_; iDim++ ) {
+                        if( ijk[iDim] > 0 )         Aa += coef_[iDim]*a[idx-stride[iDim]];
+                        if( ijk[iDim] < n[iDim]-1 ) Aa += coef_[iDim]*a[idx+stride[iDim]];
+                    }
+                    b[idx] = Aa;
+                }
+            }
+        }
+    }
+
+    SyncVectorPatch::exchange_along_all_directions_noomp          ( out, vecPatches, smpi );
+    SyncVectorPatch::finalize_exchange_along_all_directions_noomp ( out, vecPatches );
+}
+
+
+void PoissonPreconditioner::exchange( VectorPatch &vecPatches, SmileiMPI *smpi, vector<Field *> &fields )
+{
+    // The directions are exchanged together:
+    // the corners of the ghost cells are only up to date after one pass per dimension.
+    for( unsigned int iDim=0; iDim<ndim_; iDim++ ) {
+        SyncVectorPatch::exchange_along_all_directions_noomp          ( fields, vecPatches, smpi );
+        SyncVectorPatch::finalize_exchange_along_all_directions_noomp ( fields, vecPatches );
+    }
+}
+
+
+double PoissonPreconditioner::dot( VectorPatch &vecPatches, vector<Field *> &a, vector<Field *> &b )
+{
+    double sum = 0.;
+    for( unsigned int ipatch=0; ipatch<vecPatches.size(); ipatch++ ) {
+        ElectroMagn *EMfields = vecPatches( ipatch )->EMfields;
+        unsigned int ny = a[ipatch]->dims_.size()>1 ? a[ipatch]->dims_[1] : 1;
+        unsigned int nz = a[ipatch]->dims_.size()>2 ? a[ipatch]->dims_[2] : 1;
+        unsigned int lo[3] = { 0, 0, 0 }, hi[3] = { 0, 0, 0 };
+        for( unsigned int iDim=0; iDim<ndim_; iDim++ ) {
+            lo[iDim] = EMfields->index_min_p_[iDim];
+            hi[iDim] = EMfields->index_max_p_[iDim];
+        }
+        for( unsigned int i=lo[0]; i<=hi[0]; i++ )
+            for( unsigned int j=lo[1]; j<=hi[1]; j++ )
+                for( unsigned int k=lo[2]; k<=hi[2]; k++ ) {
+                    unsigned int idx = ( i*ny + j )*nz + k;
+                    sum += ( *a[ipatch] )( idx ) * ( *b[ipatch] )( idx );
+                }
+    }
+    return sum;
+}
+
+
+void PoissonPreconditioner::xpby( vector<Field *> &y, vector<Field *> &x, double beta )
+{
+    for( unsigned int ipatch=0; ipatch<y.size(); ipatch++ ) {
+        double *py = &( *y[ipatch] )( 0 );
+        double *px = &( *x[ipatch] )( 0 );
+        for( unsigned int idx=0; idx<y[ipatch]->globalDims_; idx++ )
+            py[idx] = px[idx] + beta*py[idx];
+    }
+}
+
+
+void PoissonPreconditioner::axpy( vector<Field *> &y, double alpha, vector<Field *> &x )
+{
+    for( unsigned int ipatch=0; ipatch<y.size(); ipatch++ ) {
+        double *py = &( *y[ipatch] )( 0 );
+        double *px = &( *x[ipatch] )( 0 );
+        for( unsigned int idx=0; idx<y[ipatch]->globalDims_; idx++ )
+            py[idx] += alpha*px[idx];
+    }
+}
@@ -0,0 +1,55 @@
+#ifndef POISSONPRECONDITIONER_H
+#define POISSONPRECONDITIONER_H
+
+#include <vector>
+
+#include "Params.h"
+#include "SmileiMPI.h"
+
+class VectorPatch;
+class Field;
+
+//! Preconditioner of the Poisson conjugate gradient (Cartesian geometries), and the vector
+//! operations shared by the preconditioned and pipelined variants of the solver.
+//!
+//! The work fields have the layout of EMfields->r_ in each patch. Scalar products only account
+//! for the nodes of the Poisson problem (EMfields->index_min_p_ to index_max_p_).
+class PoissonPreconditioner
+{
+public:
+    //! \param gamma_mean Lorentz factor of the relativistic Poisson problem (1 for the standard problem)
+    PoissonPreconditioner( Params &params, VectorPatch &vecPatches, double gamma_mean );
+    virtual ~PoissonPreconditioner() {};
+
+    //! out = M^-1 in in all patches, ghost cells of out included (M = identity here)
+    virtual void precondition( VectorPatch &vecPatches, SmileiMPI *smpi, std::vector<Field *> &in, std::vector<Field *> &out );
+
+    //! New work fields (zero), one per patch
+    std::vector<Field *> newFields( VectorPatch &vecPatches );
+    static void deleteFields( std::vector<Field *> &fields );
+
+    //! out = A in, ghost cells of out exchanged as for EMfields->Ap_
+    void laplacian( VectorPatch &vecPatches, SmileiMPI *smpi, std::vector<Field *> &in, std::vector<Field *> &out );
+
+    //! Local part of the scalar product a.b
+    double dot( VectorPatch &vecPatches, std::vector<Field *> &a, std::vector<Field *> &b );
+    //! y = x + beta y
+    static void xpby( std::vector<Field *> &y, std::vector<Field *> &x, double beta );
+    //! y = y + alpha x
+    static void axpy( std::vector<Field *> &y, double alpha, std::vector<Field *> &x );
+
+protected:
+    //! Number of dimensions
+    unsigned int ndim_;
+    //! 1/h^2 along each dimension (the x one divided by gamma_mean^2)
+    std::vector<double> coef_;
+    //! Diagonal of A
+    double diag_;
+    //! Ghost cells of the fields
+    std::vector<unsigned int> oversize_;
+
+    //! Fill all the ghost cells of the fields, corners included
+    void exchange( VectorPatch &vecPatches, SmileiMPI *smpi, std::vector<Field *> &fields );
+};
+
+#endif
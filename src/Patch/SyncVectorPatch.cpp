@@ -4,6 +4,7 @@
 #include <vector>
 
 #include "VectorPatch.h"
+#include "AggregatedExchange.h"
 #include "Params.h"
 #include "SmileiMPI.h"
 
@@ -23,14 +24,7 @@ void SyncVectorPatch::exchangeParticles(VectorPatch& vecPatches, int ispec, Para
     }
 
     // Init comm in direction 0
-#ifndef _NO_MPI_TM
-    #pragma omp for schedule(runtime)
-#else
-    #pragma omp single
-#endif
-    for (unsigned int ipatch=0 ; ipatch<vecPatches.size() ; ipatch++) {
-        vecPatches(ipatch)->exchNbrOfParticles(smpi, ispec, params, 0, &vecPatches);
-    }
+    SyncVectorPatch::initExchangeParticles( vecPatches, ispec, 0, params, smpi );
 }
 
 
@@ -40,15 +34,7 @@ void SyncVectorPatch::finalize_and_sort_parts(VectorPatch& vecPatches, int ispec
     
     // Per direction
     for (unsigned int iDim=1 ; iDim<params.nDim_field ; iDim++) {
-#ifndef _NO_MPI_TM
-        #pragma omp for schedule(runtime)
-#else
-    #pragma omp single
-#endif
-        for (unsigned int ipatch=0 ; ipatch<vecPatches.size() ; ipatch++) {
-            vecPatches(ipatch)->exchNbrOfParticles(smpi, ispec, params, iDim, &vecPatches);
-        }
-
+        SyncVectorPatch::initExchangeParticles( vecPatches, ispec, iDim, params, smpi );
         SyncVectorPatch::finalizeExchangeParticles( vecPatches, ispec, iDim, params, smpi, timers, itime);
     }
 
@@ -91,22 +77,13 @@ void SyncVectorPatch::finalize_and_sort_parts(VectorPatch& vecPatches, int ispec
 }
 
 
-void SyncVectorPatch::finalizeExchangeParticles(VectorPatch& vecPatches, int ispec, int iDim, Params &params, SmileiMPI* smpi, Timers &timers, int itime)
+void SyncVectorPatch::initExchangeParticles(VectorPatch& vecPatches, int ispec, int iDim, Params &params, SmileiMPI* smpi)
 {
-#ifndef _NO_MPI_TM
-    #pragma omp for schedule(runtime)
-#else
-    #pragma omp single
-#endif
-    for (unsigned int ipatch=0 ; ipatch<vecPatches.size() ; ipatch++) {
-        vecPatches(ipatch)->endNbrOfParticles(smpi, ispec, params, iDim, &vecPatches);
-    }
-    
     #pragma omp for schedule(runtime)
     for (unsigned int ipatch=0 ; ipatch<vecPatches.size() ; ipatch++) {
         vecPatches(ipatch)->prepareParticles(smpi, ispec, params, iDim, &vecPatches);
     }
-    
+
 #ifndef _NO_MPI_TM
     #pragma omp for schedule(runtime)
 #else
@@ -115,7 +92,11 @@ void SyncVectorPatch::finalizeExchangeParticles(VectorPatch& vecPatches, int isp
     for (unsigned int ipatch=0 ; ipatch<vecPatches.size() ; ipatch++) {
         vecPatches(ipatch)->exchParticles(smpi, ispec, params, iDim, &vecPatches);
     }
+}
 
+
+void SyncVectorPatch::finalizeExchangeParticles(VectorPatch& vecPatches, int ispec, int iDim, Params &params, SmileiMPI* smpi, Timers &timers, int itime)
+{
 #ifndef _NO_MPI_TM
     #pragma omp for schedule(runtime)
 #else
@@ -210,14 +191,18 @@ void SyncVectorPatch::sum( std::vector<Field*> fields, VectorPatch& vecPatches,
     // Sum per direction :
 
     // iDim = 0, initialize comms : Isend/Irecv
+    if ( vecPatches.aggregate_field_exchanges_ ) {
+        vecPatches.aggregatedExchange( fields, vector<unsigned int>( 1, 0 ), true, smpi )->start();
+    } else {
 #ifndef _NO_MPI_TM
-    #pragma omp for schedule(static)
+        #pragma omp for schedule(static)
 #else
-    #pragma omp single
+        #pragma omp single
 #endif
-    for (unsigned int ifield=0 ; ifield<fields.size() ; ifield++) {
-        unsigned int ipatch = ifield%nPatches;
-        vecPatches(ipatch)->initSumField( fields[ifield], 0, smpi );
+        for (unsigned int ifield=0 ; ifield<fields.size() ; ifield++) {
+            unsigned int ipatch = ifield%nPatches;
+            vecPatches(ipatch)->initSumField( fields[ifield], 0, smpi );
+        }
     }
 
     // iDim = 0, local
@@ -247,14 +232,18 @@ void SyncVectorPatch::sum( std::vector<Field*> fields, VectorPatch& vecPatches,
     }
 
     // iDim = 0, finalize (waitall)
+    if ( vecPatches.aggregate_field_exchanges_ ) {
+        vecPatches.aggregatedExchange( fields, vector<unsigned int>( 1, 0 ), true, NULL )->finalize();
+    } else {
 #ifndef _NO_MPI_TM
-    #pragma omp for schedule(static)
+        #pragma omp for schedule(static)
 #else
-    #pragma omp single
+        #pragma omp single
 #endif
-    for (unsigned int ifield=0 ; ifield<fields.size() ; ifield++){
-        unsigned int ipatch = ifield%nPatches;
-        vecPatches(ipatch)->finalizeSumField( fields[ifield], 0 );
+        for (unsigned int ifield=0 ; ifield<fields.size() ; ifield++){
+            unsigned int ipatch = ifield%nPatches;
+            vecPatches(ipatch)->finalizeSumField( fields[ifield], 0 );
+        }
     }
     // END iDim = 0 sync
     // -----------------
@@ -264,14 +253,18 @@ void SyncVectorPatch::sum( std::vector<Field*> fields, VectorPatch& vecPatches,
         // Sum per direction :
 
         // iDim = 1, initialize comms : Isend/Irecv
+        if ( vecPatches.aggregate_field_exchanges_ ) {
+            vecPatches.aggregatedExchange( fields, vector<unsigned int>( 1, 1 ), true, smpi )->start();
+        } else {
 #ifndef _NO_MPI_TM
-        #pragma omp for schedule(static)
+            #pragma omp for schedule(static)
 #else
-        #pragma omp single
+            #pragma omp single
 #endif
-        for (unsigned int ifield=0 ; ifield<fields.size() ; ifield++) {
-            unsigned int ipatch = ifield%nPatches;
-            vecPatches(ipatch)->initSumField( fields[ifield], 1, smpi );
+            for (unsigned int ifield=0 ; ifield<fields.size() ; ifield++) {
+                unsigned int ipatch = ifield%nPatches;
+                vecPatches(ipatch)->initSumField( fields[ifield], 1, smpi );
+            }
         }
 
         // iDim = 1, local
@@ -305,14 +298,18 @@ void SyncVectorPatch::sum( std::vector<Field*> fields, VectorPatch& vecPatches,
         }
 
         // iDim = 1, finalize (waitall)
+        if ( vecPatches.aggregate_field_exchanges_ ) {
+            vecPatches.aggregatedExchange( fields, vector<unsigned int>( 1, 1 ), true, NULL )->finalize();
+        } else {
 #ifndef _NO_MPI_TM
-        #pragma omp for schedule(static)
+            #pragma omp for schedule(static)
 #else
-        #pragma omp single
+            #pragma omp single
 #endif
-        for (unsigned int ifield=0 ; ifield<fields.size() ; ifield++){
-            unsigned int ipatch = ifield%nPatches;
-            vecPatches(ipatch)->finalizeSumField( fields[ifield], 1 );
+            for (unsigned int ifield=0 ; ifield<fields.size() ; ifield++){
+                unsigned int ipatch = ifield%nPatches;
+                vecPatches(ipatch)->finalizeSumField( fields[ifield], 1 );
+            }
         }
         // END iDim = 1 sync
         // -----------------
@@ -322,14 +319,18 @@ void SyncVectorPatch::sum( std::vector<Field*> fields, VectorPatch& vecPatches,
             // Sum per direction :
 
             // iDim = 2, initialize comms : Isend/Irecv
+            if ( vecPatches.aggregate_field_exchanges_ ) {
+                vecPatches.aggregatedExchange( fields, vector<unsigned int>( 1, 2 ), true, smpi )->start();
+            } else {
 #ifndef _NO_MPI_TM
-            #pragma omp for schedule(static)
+                #pragma omp for schedule(static)
 #else
-            #pragma omp single
+                #pragma omp single
 #endif
-            for (unsigned int ifield=0 ; ifield<fields.size() ; ifield++) {
-                unsigned int ipatch = ifield%nPatches;
-                vecPatches(ipatch)->initSumField( fields[ifield], 2, smpi );
+                for (unsigned int ifield=0 ; ifield<fields.size() ; ifield++) {
+                    unsigned int ipatch = ifield%nPatches;
+                    vecPatches(ipatch)->initSumField( fields[ifield], 2, smpi );
+                }
             }
 
             // iDim = 2 local
@@ -365,14 +366,18 @@ void SyncVectorPatch::sum( std::vector<Field*> fields, VectorPatch& vecPatches,
             }
 
             // iDim = 2, complete non local sync through MPIfinalize (waitall)
+            if ( vecPatches.aggregate_field_exchanges_ ) {
+                vecPatches.aggregatedExchange( fields, vector<unsigned int>( 1, 2 ), true, NULL )->finalize();
+            } else {
 #ifndef _NO_MPI_TM
-            #pragma omp for schedule(static)
+                #pragma omp for schedule(static)
 #else
-            #pragma omp single
+                #pragma omp single
 #endif
-            for (unsigned int ifield=0 ; ifield<fields.size() ; ifield++){
-                unsigned int ipatch = ifield%nPatches;
-                vecPatches(ipatch)->finalizeSumField( fields[ifield], 2 );
+                for (unsigned int ifield=0 ; ifield<fields.size() ; ifield++){
+                    unsigned int ipatch = ifield%nPatches;
+                    vecPatches(ipatch)->finalizeSumField( fields[ifield], 2 );
+                }
             }
             // END iDim = 2 sync
             // -----------------
@@ -619,16 +624,20 @@ void SyncVectorPatch::sum_all_components( std::vector<Field*>& fields, VectorPat
 
     // iDim = 0, initialize comms : Isend/Irecv
     unsigned int nPatchMPIx = vecPatches.MPIxIdx.size();
+    if ( vecPatches.aggregate_field_exchanges_ ) {
+        vecPatches.aggregatedExchange( fields, vector<unsigned int>( 1, 0 ), true, smpi )->start();
+    } else {
 #ifndef _NO_MPI_TM
-    #pragma omp for schedule(static)
+        #pragma omp for schedule(static)
 #else
-    #pragma omp single
+        #pragma omp single
 #endif
-    for (unsigned int ifield=0 ; ifield<nPatchMPIx ; ifield++) {
-        unsigned int ipatch = vecPatches.MPIxIdx[ifield];
-        vecPatches(ipatch)->initSumField( vecPatches.densitiesMPIx[ifield             ], 0, smpi ); // Jx
-        vecPatches(ipatch)->initSumField( vecPatches.densitiesMPIx[ifield+  nPatchMPIx], 0, smpi ); // Jy
-        vecPatches(ipatch)->initSumField( vecPatches.densitiesMPIx[ifield+2*nPatchMPIx], 0, smpi ); // Jz
+        for (unsigned int ifield=0 ; ifield<nPatchMPIx ; ifield++) {
+            unsigned int ipatch = vecPatches.MPIxIdx[ifield];
+            vecPatches(ipatch)->initSumField( vecPatches.densitiesMPIx[ifield             ], 0, smpi ); // Jx
+            vecPatches(ipatch)->initSumField( vecPatches.densitiesMPIx[ifield+  nPatchMPIx], 0, smpi ); // Jy
+            vecPatches(ipatch)->initSumField( vecPatches.densitiesMPIx[ifield+2*nPatchMPIx], 0, smpi ); // Jz
+        }
     }
     // iDim = 0, local
     int nFieldLocalx = vecPatches.densitiesLocalx.size()/3;
@@ -663,16 +672,20 @@ void SyncVectorPatch::sum_all_components( std::vector<Field*>& fields, VectorPat
     }
 
     // iDim = 0, finalize (waitall)
+    if ( vecPatches.aggregate_field_exchanges_ ) {
+        vecPatches.aggregatedExchange( fields, vector<unsigned int>( 1, 0 ), true, NULL )->finalize();
+    } else {
 #ifndef _NO_MPI_TM
-    #pragma omp for schedule(static)
+        #pragma omp for schedule(static)
 #else
-    #pragma omp single
+        #pragma omp single
 #endif
-    for (unsigned int ifield=0 ; ifield<nPatchMPIx ; ifield++) {
-        unsigned int ipatch = vecPatches.MPIxIdx[ifield];
-        vecPatches(ipatch)->finalizeSumField( vecPatches.densitiesMPIx[ifield             ], 0 ); // Jx
-        vecPatches(ipatch)->finalizeSumField( vecPatches.densitiesMPIx[ifield+nPatchMPIx  ], 0 ); // Jy
-        vecPatches(ipatch)->finalizeSumField( vecPatches.densitiesMPIx[ifield+2*nPatchMPIx], 0 ); // Jz
+        for (unsigned int ifield=0 ; ifield<nPatchMPIx ; ifield++) {
+            unsigned int ipatch = vecPatches.MPIxIdx[ifield];
+            vecPatches(ipatch)->finalizeSumField( vecPatches.densitiesMPIx[ifield             ], 0 ); // Jx
+            vecPatches(ipatch)->finalizeSumField( vecPatches.densitiesMPIx[ifield+nPatchMPIx  ], 0 ); // Jy
+            vecPatches(ipatch)->finalizeSumField( vecPatches.densitiesMPIx[ifield+2*nPatchMPIx], 0 ); // Jz
+        }
     }
     // END iDim = 0 sync
     // -----------------
@@ -683,16 +696,20 @@ void SyncVectorPatch::sum_all_components( std::vector<Field*>& fields, VectorPat
 
         // iDim = 1, initialize comms : Isend/Irecv
         unsigned int nPatchMPIy = vecPatches.MPIyIdx.size();
+        if ( vecPatches.aggregate_field_exchanges_ ) {
+            vecPatches.aggregatedExchange( fields, vector<unsigned int>( 1, 1 ), true, smpi )->start();
+        } else {
 #ifndef _NO_MPI_TM
-        #pragma omp for schedule(static)
+            #pragma omp for schedule(static)
 #else
-        #pragma omp single
+            #pragma omp single
 #endif
-        for (unsigned int ifield=0 ; ifield<nPatchMPIy ; ifield++) {
-            unsigned int ipatch = vecPatches.MPIyIdx[ifield];
-            vecPatches(ipatch)->initSumField( vecPatches.densitiesMPIy[ifield             ], 1, smpi ); // Jx
-            vecPatches(ipatch)->initSumField( vecPatches.densitiesMPIy[ifield+nPatchMPIy  ], 1, smpi ); // Jy
-            vecPatches(ipatch)->initSumField( vecPatches.densitiesMPIy[ifield+2*nPatchMPIy], 1, smpi ); // Jz
+            for (unsigned int ifield=0 ; ifield<nPatchMPIy ; ifield++) {
+                unsigned int ipatch = vecPatches.MPIyIdx[ifield];
+                vecPatches(ipatch)->initSumField( vecPatches.densitiesMPIy[ifield             ], 1, smpi ); // Jx
+                vecPatches(ipatch)->initSumField( vecPatches.densitiesMPIy[ifield+nPatchMPIy  ], 1, smpi ); // Jy
+                vecPatches(ipatch)->initSumField( vecPatches.densitiesMPIy[ifield+2*nPatchMPIy], 1, smpi ); // Jz
+            }
         }
 
         // iDim = 1,
@@ -732,16 +749,20 @@ void SyncVectorPatch::sum_all_components( std::vector<Field*>& fields, VectorPat
         }
 
         // iDim = 1, finalize (waitall)
+        if ( vecPatches.aggregate_field_exchanges_ ) {
+            vecPatches.aggregatedExchange( fields, vector<unsigned int>( 1, 1 ), true, NULL )->finalize();
+        } else {
 #ifndef _NO_MPI_TM
-        #pragma omp for schedule(static)
+            #pragma omp for schedule(static)
 #else
-        #pragma omp single
+            #pragma omp single
 #endif
-        for (unsigned int ifield=0 ; ifield<nPatchMPIy ; ifield=ifield+1) {
-            unsigned int ipatch = vecPatches.MPIyIdx[ifield];
-            vecPatches(ipatch)->finalizeSumField( vecPatches.densitiesMPIy[ifield             ], 1 ); // Jx
-            vecPatches(ipatch)->finalizeSumField( vecPatches.densitiesMPIy[ifield+nPatchMPIy  ], 1 ); // Jy
-            vecPatches(ipatch)->finalizeSumField( vecPatches.densitiesMPIy[ifield+2*nPatchMPIy], 1 ); // Jz
+            for (unsigned int ifield=0 ; ifield<nPatchMPIy ; ifield=ifield+1) {
+                unsigned int ipatch = vecPatches.MPIyIdx[ifield];
+                vecPatches(ipatch)->finalizeSumField( vecPatches.densitiesMPIy[ifield             ], 1 ); // Jx
+                vecPatches(ipatch)->finalizeSumField( vecPatches.densitiesMPIy[ifield+nPatchMPIy  ], 1 ); // Jy
+                vecPatches(ipatch)->finalizeSumField( vecPatches.densitiesMPIy[ifield+2*nPatchMPIy], 1 ); // Jz
+            }
         }
         // END iDim = 1 sync
         // -----------------
@@ -752,16 +773,20 @@ void SyncVectorPatch::sum_all_components( std::vector<Field*>& fields, VectorPat
 
             // iDim = 2, initialize comms : Isend/Irecv
             unsigned int nPatchMPIz = vecPatches.MPIzIdx.size();
+            if ( vecPatches.aggregate_field_exchanges_ ) {
+                vecPatches.aggregatedExchange( fields, vector<unsigned int>( 1, 2 ), true, smpi )->start();
+            } else {
 #ifndef _NO_MPI_TM
-            #pragma omp for schedule(static)
+                #pragma omp for schedule(static)
 #else
-            #pragma omp single
+                #pragma omp single
 #endif
-            for (unsigned int ifield=0 ; ifield<nPatchMPIz ; ifield++) {
-                unsigned int ipatch = vecPatches.MPIzIdx[ifield];
-                vecPatches(ipatch)->initSumField( vecPatches.densitiesMPIz[ifield             ], 2, smpi ); // Jx
-                vecPatches(ipatch)->initSumField( vecPatches.densitiesMPIz[ifield+nPatchMPIz  ], 2, smpi ); // Jy
-                vecPatches(ipatch)->initSumField( vecPatches.densitiesMPIz[ifield+2*nPatchMPIz], 2, smpi ); // Jz
+                for (unsigned int ifield=0 ; ifield<nPatchMPIz ; ifield++) {
+                    unsigned int ipatch = vecPatches.MPIzIdx[ifield];
+                    vecPatches(ipatch)->initSumField( vecPatches.densitiesMPIz[ifield             ], 2, smpi ); // Jx
+                    vecPatches(ipatch)->initSumField( vecPatches.densitiesMPIz[ifield+nPatchMPIz  ], 2, smpi ); // Jy
+                    vecPatches(ipatch)->initSumField( vecPatches.densitiesMPIz[ifield+2*nPatchMPIz], 2, smpi ); // Jz
+                }
             }
 
             // iDim = 2 local
@@ -804,16 +829,20 @@ void SyncVectorPatch::sum_all_components( std::vector<Field*>& fields, VectorPat
             }
 
             // iDim = 2, complete non local sync through MPIfinalize (waitall)
+            if ( vecPatches.aggregate_field_exchanges_ ) {
+                vecPatches.aggregatedExchange( fields, vector<unsigned int>( 1, 2 ), true, NULL )->finalize();
+            } else {
 #ifndef _NO_MPI_TM
-            #pragma omp for schedule(static)
+                #pragma omp for schedule(static)
 #else
-            #pragma omp single
+                #pragma omp single
 #endif
-            for (unsigned int ifield=0 ; ifield<nPatchMPIz ; ifield=ifield+1) {
-                unsigned int ipatch = vecPatches.MPIzIdx[ifield];
-                vecPatches(ipatch)->finalizeSumField( vecPatches.densitiesMPIz[ifield             ], 2 ); // Jx
-                vecPatches(ipatch)->finalizeSumField( vecPatches.densitiesMPIz[ifield+nPatchMPIz  ], 2 ); // Jy
-                vecPatches(ipatch)->finalizeSumField( vecPatches.densitiesMPIz[ifield+2*nPatchMPIz], 2 ); // Jz
+                for (unsigned int ifield=0 ; ifield<nPatchMPIz ; ifield=ifield+1) {
+                    unsigned int ipatch = vecPatches.MPIzIdx[ifield];
+                    vecPatches(ipatch)->finalizeSumField( vecPatches.densitiesMPIz[ifield             ], 2 ); // Jx
+                    vecPatches(ipatch)->finalizeSumField( vecPatches.densitiesMPIz[ifield+nPatchMPIz  ], 2 ); // Jy
+                    vecPatches(ipatch)->finalizeSumField( vecPatches.densitiesMPIz[ifield+2*nPatchMPIz], 2 ); // Jz
+                }
             }
             // END iDim = 2 sync
             // -----------------
@@ -1050,15 +1079,23 @@ void SyncVectorPatch::exchangeEnvChi( Params& params, VectorPatch& vecPatches, S
 // timers and itime were here introduced for debugging
 void SyncVectorPatch::exchange_along_all_directions( std::vector<Field*> fields, VectorPatch& vecPatches, SmileiMPI* smpi )
 {
-    for ( unsigned int iDim=0 ; iDim<fields[0]->dims_.size() ; iDim++ ) {
+    if ( vecPatches.aggregate_field_exchanges_ ) {
+        // All directions in the same messages
+        vector<unsigned int> dims;
+        for ( unsigned int iDim=0 ; iDim<fields[0]->dims_.size() ; iDim++ )
+            dims.push_back( iDim );
+        vecPatches.aggregatedExchange( fields, dims, false, smpi )->start();
+    } else {
+        for ( unsigned int iDim=0 ; iDim<fields[0]->dims_.size() ; iDim++ ) {
 #ifndef _NO_MPI_TM
-        #pragma omp for schedule(static)
+            #pragma omp for schedule(static)
 #else
-        #pragma omp single
+            #pragma omp single
 #endif
-        for (unsigned int ipatch=0 ; ipatch<fields.size() ; ipatch++)
-            vecPatches(ipatch)->initExchange( fields[ipatch], iDim, smpi );
-    } // End for iDim
+            for (unsigned int ipatch=0 ; ipatch<fields.size() ; ipatch++)
+                vecPatches(ipatch)->initExchange( fields[ipatch], iDim, smpi );
+        } // End for iDim
+    }
 
 
     unsigned int nx_, ny_(1), nz_(1), h0, oversize[3], n_space[3], gsp[3];
@@ -1130,15 +1167,22 @@ void SyncVectorPatch::exchange_along_all_directions( std::vector<Field*> fields,
 // MPI_Wait for all communications initialised in exchange_along_all_directions
 void SyncVectorPatch::finalize_exchange_along_all_directions( std::vector<Field*> fields, VectorPatch& vecPatches )
 {
-    for ( unsigned int iDim=0 ; iDim<fields[0]->dims_.size() ; iDim++ ) {
+    if ( vecPatches.aggregate_field_exchanges_ ) {
+        vector<unsigned int> dims;
+        for ( unsigned int iDim=0 ; iDim<fields[0]->dims_.size() ; iDim++ )
+            dims.push_back( iDim );
+        vecPatches.aggregatedExchange( fields, dims, false, NULL )->finalize();
+    } else {
+        for ( unsigned int iDim=0 ; iDim<fields[0]->dims_.size() ; iDim++ ) {
 #ifndef _NO_MPI_TM
-        #pragma omp for schedule(static)
+            #pragma omp for schedule(static)
 #else
-        #pragma omp single
+            #pragma omp single
 #endif
-        for (unsigned int ipatch=0 ; ipatch<fields.size() ; ipatch++)
-            vecPatches(ipatch)->finalizeExchange( fields[ipatch], iDim );
-    } // End for iDim
+            for (unsigned int ipatch=0 ; ipatch<fields.size() ; ipatch++)
+                vecPatches(ipatch)->finalizeExchange( fields[ipatch], iDim );
+        } // End for iDim
+    }
 
 }
 
@@ -1355,21 +1399,29 @@ void SyncVectorPatch::exchange_synchronized_per_direction( std::vector<Field*> f
     if (fields[0]->dims_.size()>2) {
 
         // Dimension 2
+        if ( vecPatches.aggregate_field_exchanges_ ) {
+            vecPatches.aggregatedExchange( fields, vector<unsigned int>( 1, 2 ), false, smpi )->start();
+        } else {
 #ifndef _NO_MPI_TM
-        #pragma omp for schedule(static)
+            #pragma omp for schedule(static)
 #else
-        #pragma omp single
+            #pragma omp single
 #endif
-        for (unsigned int ipatch=0 ; ipatch<fields.size() ; ipatch++)
-            vecPatches(ipatch)->initExchange( fields[ipatch], 2, smpi );
+            for (unsigned int ipatch=0 ; ipatch<fields.size() ; ipatch++)
+                vecPatches(ipatch)->initExchange( fields[ipatch], 2, smpi );
+        }
 
+        if ( vecPatches.aggregate_field_exchanges_ ) {
+            vecPatches.aggregatedExchange( fields, vector<unsigned int>( 1, 2 ), false, NULL )->finalize();
+        } else {
 #ifndef _NO_MPI_TM
-        #pragma omp for schedule(static)
+            #pragma omp for schedule(static)
 #else
-        #pragma omp single
+            #pragma omp single
 #endif
-        for (unsigned int ipatch=0 ; ipatch<fields.size() ; ipatch++)
-            vecPatches(ipatch)->finalizeExchange( fields[ipatch], 2 );
+            for (unsigned int ipatch=0 ; ipatch<fields.size() ; ipatch++)
+                vecPatches(ipatch)->finalizeExchange( fields[ipatch], 2 );
+        }
 
         #pragma omp for schedule(static) private(pt1,pt2)
         for (unsigned int ipatch=0 ; ipatch<fields.size() ; ipatch++) {
@@ -1396,21 +1448,29 @@ void SyncVectorPatch::exchange_synchronized_per_direction( std::vector<Field*> f
     }
 
     // Dimension 1
+    if ( vecPatches.aggregate_field_exchanges_ ) {
+        vecPatches.aggregatedExchange( fields, vector<unsigned int>( 1, 1 ), false, smpi )->start();
+    } else {
 #ifndef _NO_MPI_TM
-    #pragma omp for schedule(static)
+        #pragma omp for schedule(static)
 #else
-    #pragma omp single
+        #pragma omp single
 #endif
-    for (unsigned int ipatch=0 ; ipatch<fields.size() ; ipatch++)
-        vecPatches(ipatch)->initExchange( fields[ipatch], 1, smpi );
+        for (unsigned int ipatch=0 ; ipatch<fields.size() ; ipatch++)
+            vecPatches(ipatch)->initExchange( fields[ipatch], 1, smpi );
+    }
 
+    if ( vecPatches.aggregate_field_exchanges_ ) {
+        vecPatches.aggregatedExchange( fields, vector<unsigned int>( 1, 1 ), false, NULL )->finalize();
+    } else {
 #ifndef _NO_MPI_TM
-    #pragma omp for schedule(static)
+        #pragma omp for schedule(static)
 #else
-    #pragma omp single
+        #pragma omp single
 #endif
-    for (unsigned int ipatch=0 ; ipatch<fields.size() ; ipatch++)
-        vecPatches(ipatch)->finalizeExchange( fields[ipatch], 1 );
+        for (unsigned int ipatch=0 ; ipatch<fields.size() ; ipatch++)
+            vecPatches(ipatch)->finalizeExchange( fields[ipatch], 1 );
+    }
 
     #pragma omp for schedule(static) private(pt1,pt2)
     for (unsigned int ipatch=0 ; ipatch<fields.size() ; ipatch++) {
@@ -1433,21 +1493,29 @@ void SyncVectorPatch::exchange_synchronized_per_direction( std::vector<Field*> f
     } // End for( ipatch )
 
     // Dimension 0
+    if ( vecPatches.aggregate_field_exchanges_ ) {
+        vecPatches.aggregatedExchange( fields, vector<unsigned int>( 1, 0 ), false, smpi )->start();
+    } else {
 #ifndef _NO_MPI_TM
-    #pragma omp for schedule(static)
+        #pragma omp for schedule(static)
 #else
-    #pragma omp single
+        #pragma omp single
 #endif
-    for (unsigned int ipatch=0 ; ipatch<fields.size() ; ipatch++)
-        vecPatches(ipatch)->initExchange( fields[ipatch], 0, smpi );
+        for (unsigned int ipatch=0 ; ipatch<fields.size() ; ipatch++)
+            vecPatches(ipatch)->initExchange( fields[ipatch], 0, smpi );
+    }
 
+    if ( vecPatches.aggregate_field_exchanges_ ) {
+        vecPatches.aggregatedExchange( fields, vector<unsigned int>( 1, 0 ), false, NULL )->finalize();
+    } else {
 #ifndef _NO_MPI_TM
-    #pragma omp for schedule(static)
+        #pragma omp for schedule(static)
 #else
-    #pragma omp single
+        #pragma omp single
 #endif
-    for (unsigned int ipatch=0 ; ipatch<fields.size() ; ipatch++)
-        vecPatches(ipatch)->finalizeExchange( fields[ipatch], 0 );
+        for (unsigned int ipatch=0 ; ipatch<fields.size() ; ipatch++)
+            vecPatches(ipatch)->finalizeExchange( fields[ipatch], 0 );
+    }
 
 
 
@@ -1478,15 +1546,19 @@ void SyncVectorPatch::exchange_synchronized_per_direction( std::vector<Field*> f
 void SyncVectorPatch::exchange_all_components_along_X( std::vector<Field*>& fields, VectorPatch& vecPatches, SmileiMPI* smpi )
 {
     unsigned int nMPIx = vecPatches.MPIxIdx.size();
+    if ( vecPatches.aggregate_field_exchanges_ ) {
+        vecPatches.aggregatedExchange( fields, vector<unsigned int>( 1, 0 ), false, smpi )->start();
+    } else {
 #ifndef _NO_MPI_TM
-    #pragma omp for schedule(static)
+        #pragma omp for schedule(static)
 #else
-    #pragma omp single
+        #pragma omp single
 #endif
-    for (unsigned int ifield=0 ; ifield<nMPIx ; ifield++) {
-        unsigned int ipatch = vecPatches.MPIxIdx[ifield];
-        vecPatches(ipatch)->initExchange( vecPatches.B_MPIx[ifield      ], 0, smpi ); // By
-        vecPatches(ipatch)->initExchange( vecPatches.B_MPIx[ifield+nMPIx], 0, smpi ); // Bz
+        for (unsigned int ifield=0 ; ifield<nMPIx ; ifield++) {
+            unsigned int ipatch = vecPatches.MPIxIdx[ifield];
+            vecPatches(ipatch)->initExchange( vecPatches.B_MPIx[ifield      ], 0, smpi ); // By
+            vecPatches(ipatch)->initExchange( vecPatches.B_MPIx[ifield+nMPIx], 0, smpi ); // Bz
+        }
     }
 
 
@@ -1536,15 +1608,19 @@ void SyncVectorPatch::exchange_all_components_along_X( std::vector<Field*>& fiel
 void SyncVectorPatch::finalize_exchange_all_components_along_X( std::vector<Field*>& fields, VectorPatch& vecPatches )
 {
     unsigned int nMPIx = vecPatches.MPIxIdx.size();
+    if ( vecPatches.aggregate_field_exchanges_ ) {
+        vecPatches.aggregatedExchange( fields, vector<unsigned int>( 1, 0 ), false, NULL )->finalize();
+    } else {
 #ifndef _NO_MPI_TM
-    #pragma omp for schedule(static)
+        #pragma omp for schedule(static)
 #else
-    #pragma omp single
+        #pragma omp single
 #endif
-    for (unsigned int ifield=0 ; ifield<nMPIx ; ifield++) {
-        unsigned int ipatch = vecPatches.MPIxIdx[ifield];
-        vecPatches(ipatch)->finalizeExchange( vecPatches.B_MPIx[ifield      ], 0 ); // By
-        vecPatches(ipatch)->finalizeExchange( vecPatches.B_MPIx[ifield+nMPIx], 0 ); // Bz
+        for (unsigned int ifield=0 ; ifield<nMPIx ; ifield++) {
+            unsigned int ipatch = vecPatches.MPIxIdx[ifield];
+            vecPatches(ipatch)->finalizeExchange( vecPatches.B_MPIx[ifield      ], 0 ); // By
+            vecPatches(ipatch)->finalizeExchange( vecPatches.B_MPIx[ifield+nMPIx], 0 ); // Bz
+        }
     }
 }
 
@@ -1559,15 +1635,19 @@ void SyncVectorPatch::finalize_exchange_all_components_along_X( std::vector<Fiel
 void SyncVectorPatch::exchange_all_components_along_Y( std::vector<Field*>& fields, VectorPatch& vecPatches, SmileiMPI* smpi )
 {
     unsigned int nMPIy = vecPatches.MPIyIdx.size();
+    if ( vecPatches.aggregate_field_exchanges_ ) {
+        vecPatches.aggregatedExchange( fields, vector<unsigned int>( 1, 1 ), false, smpi )->start();
+    } else {
 #ifndef _NO_MPI_TM
-    #pragma omp for schedule(static)
+        #pragma omp for schedule(static)
 #else
-    #pragma omp single
+        #pragma omp single
 #endif
-    for (unsigned int ifield=0 ; ifield<nMPIy ; ifield++) {
-        unsigned int ipatch = vecPatches.MPIyIdx[ifield];
-        vecPatches(ipatch)->initExchange( vecPatches.B1_MPIy[ifield      ], 1, smpi );   // Bx
-        vecPatches(ipatch)->initExchange( vecPatches.B1_MPIy[ifield+nMPIy], 1, smpi ); // Bz
+        for (unsigned int ifield=0 ; ifield<nMPIy ; ifield++) {
+            unsigned int ipatch = vecPatches.MPIyIdx[ifield];
+            vecPatches(ipatch)->initExchange( vecPatches.B1_MPIy[ifield      ], 1, smpi );   // Bx
+            vecPatches(ipatch)->initExchange( vecPatches.B1_MPIy[ifield+nMPIy], 1, smpi ); // Bz
+        }
     }
 
     unsigned int h0, oversize, n_space;
@@ -1619,15 +1699,19 @@ void SyncVectorPatch::exchange_all_components_along_Y( std::vector<Field*>& fiel
 void SyncVectorPatch::finalize_exchange_all_components_along_Y( std::vector<Field*>& fields, VectorPatch& vecPatches )
 {
     unsigned int nMPIy = vecPatches.MPIyIdx.size();
+    if ( vecPatches.aggregate_field_exchanges_ ) {
+        vecPatches.aggregatedExchange( fields, vector<unsigned int>( 1, 1 ), false, NULL )->finalize();
+    } else {
 #ifndef _NO_MPI_TM
-    #pragma omp for schedule(static)
+        #pragma omp for schedule(static)
 #else
-    #pragma omp single
+        #pragma omp single
 #endif
-    for (unsigned int ifield=0 ; ifield<nMPIy ; ifield++) {
-        unsigned int ipatch = vecPatches.MPIyIdx[ifield];
-        vecPatches(ipatch)->finalizeExchange( vecPatches.B1_MPIy[ifield      ], 1 ); // By
-        vecPatches(ipatch)->finalizeExchange( vecPatches.B1_MPIy[ifield+nMPIy], 1 ); // Bz
+        for (unsigned int ifield=0 ; ifield<nMPIy ; ifield++) {
+            unsigned int ipatch = vecPatches.MPIyIdx[ifield];
+            vecPatches(ipatch)->finalizeExchange( vecPatches.B1_MPIy[ifield      ], 1 ); // By
+            vecPatches(ipatch)->finalizeExchange( vecPatches.B1_MPIy[ifield+nMPIy], 1 ); // Bz
+        }
     }
 
 
@@ -1644,15 +1728,19 @@ void SyncVectorPatch::finalize_exchange_all_components_along_Y( std::vector<Fiel
 void SyncVectorPatch::exchange_all_components_along_Z( std::vector<Field*> fields, VectorPatch& vecPatches, SmileiMPI* smpi )
 {
     unsigned int nMPIz = vecPatches.MPIzIdx.size();
+    if ( vecPatches.aggregate_field_exchanges_ ) {
+        vecPatches.aggregatedExchange( fields, vector<unsigned int>( 1, 2 ), false, smpi )->start();
+    } else {
 #ifndef _NO_MPI_TM
-    #pragma omp for schedule(static)
+        #pragma omp for schedule(static)
 #else
-    #pragma omp single
+        #pragma omp single
 #endif
-    for (unsigned int ifield=0 ; ifield<nMPIz ; ifield++) {
-        unsigned int ipatch = vecPatches.MPIzIdx[ifield];
-        vecPatches(ipatch)->initExchange( vecPatches.B2_MPIz[ifield],       2, smpi ); // Bx
-        vecPatches(ipatch)->initExchange( vecPatches.B2_MPIz[ifield+nMPIz], 2, smpi ); // By
+        for (unsigned int ifield=0 ; ifield<nMPIz ; ifield++) {
+            unsigned int ipatch = vecPatches.MPIzIdx[ifield];
+            vecPatches(ipatch)->initExchange( vecPatches.B2_MPIz[ifield],       2, smpi ); // Bx
+            vecPatches(ipatch)->initExchange( vecPatches.B2_MPIz[ifield+nMPIz], 2, smpi ); // By
+        }
     }
 
     unsigned int h0, oversize, n_space;
@@ -1702,15 +1790,19 @@ void SyncVectorPatch::exchange_all_components_along_Z( std::vector<Field*> field
 void SyncVectorPatch::finalize_exchange_all_components_along_Z( std::vector<Field*> fields, VectorPatch& vecPatches )
 {
     unsigned int nMPIz = vecPatches.MPIzIdx.size();
+    if ( vecPatches.aggregate_field_exchanges_ ) {
+        vecPatches.aggregatedExchange( fields, vector<unsigned int>( 1, 2 ), false, NULL )->finalize();
+    } else {
 #ifndef _NO_MPI_TM
-    #pragma omp for schedule(static)
+        #pragma omp for schedule(static)
 #else
-    #pragma omp single
+        #pragma omp single
 #endif
-    for (unsigned int ifield=0 ; ifield<nMPIz ; ifield++) {
-        unsigned int ipatch = vecPatches.MPIzIdx[ifield];
-        vecPatches(ipatch)->finalizeExchange( vecPatches.B2_MPIz[ifield      ], 2 ); // Bx
-        vecPatches(ipatch)->finalizeExchange( vecPatches.B2_MPIz[ifield+nMPIz], 2 ); // By
+        for (unsigned int ifield=0 ; ifield<nMPIz ; ifield++) {
+            unsigned int ipatch = vecPatches.MPIzIdx[ifield];
+            vecPatches(ipatch)->finalizeExchange( vecPatches.B2_MPIz[ifield      ], 2 ); // Bx
+            vecPatches(ipatch)->finalizeExchange( vecPatches.B2_MPIz[ifield+nMPIz], 2 ); // By
+        }
     }
 
 }
@@ -1724,13 +1816,17 @@ void SyncVectorPatch::finalize_exchange_all_components_along_Z( std::vector<Fiel
 
 void SyncVectorPatch::exchange_along_X( std::vector<Field*> fields, VectorPatch& vecPatches, SmileiMPI* smpi )
 {
+    if ( vecPatches.aggregate_field_exchanges_ ) {
+        vecPatches.aggregatedExchange( fields, vector<unsigned int>( 1, 0 ), false, smpi )->start();
+    } else {
 #ifndef _NO_MPI_TM
-    #pragma omp for schedule(static)
+        #pragma omp for schedule(static)
 #else
-    #pragma omp single
+        #pragma omp single
 #endif
-    for (unsigned int ipatch=0 ; ipatch<fields.size() ; ipatch++)
-        vecPatches(ipatch)->initExchange( fields[ipatch], 0, smpi );
+        for (unsigned int ipatch=0 ; ipatch<fields.size() ; ipatch++)
+            vecPatches(ipatch)->initExchange( fields[ipatch], 0, smpi );
+    }
 
     unsigned int ny_(1), nz_(1), h0, oversize, n_space, gsp;
     double *pt1,*pt2;
@@ -1770,25 +1866,33 @@ void SyncVectorPatch::exchange_along_X( std::vector<Field*> fields, VectorPatch&
 
 void SyncVectorPatch::finalize_exchange_along_X( std::vector<Field*> fields, VectorPatch& vecPatches )
 {
+    if ( vecPatches.aggregate_field_exchanges_ ) {
+        vecPatches.aggregatedExchange( fields, vector<unsigned int>( 1, 0 ), false, NULL )->finalize();
+    } else {
 #ifndef _NO_MPI_TM
-    #pragma omp for schedule(static)
+        #pragma omp for schedule(static)
 #else
-    #pragma omp single
+        #pragma omp single
 #endif
-    for (unsigned int ipatch=0 ; ipatch<fields.size() ; ipatch++)
-        vecPatches(ipatch)->finalizeExchange( fields[ipatch], 0 );
+        for (unsigned int ipatch=0 ; ipatch<fields.size() ; ipatch++)
+            vecPatches(ipatch)->finalizeExchange( fields[ipatch], 0 );
+    }
 
 }
 
 void SyncVectorPatch::exchange_along_Y( std::vector<Field*> fields, VectorPatch& vecPatches, SmileiMPI* smpi )
 {
+    if ( vecPatches.aggregate_field_exchanges_ ) {
+        vecPatches.aggregatedExchange( fields, vector<unsigned int>( 1, 1 ), false, smpi )->start();
+    } else {
 #ifndef _NO_MPI_TM
-    #pragma omp for schedule(static)
+        #pragma omp for schedule(static)
 #else
-    #pragma omp single
+        #pragma omp single
 #endif
-    for (unsigned int ipatch=0 ; ipatch<fields.size() ; ipatch++)
-        vecPatches(ipatch)->initExchange( fields[ipatch], 1, smpi );
+        for (unsigned int ipatch=0 ; ipatch<fields.size() ; ipatch++)
+            vecPatches(ipatch)->initExchange( fields[ipatch], 1, smpi );
+    }
 
     unsigned int nx_, ny_, nz_(1), h0, oversize, n_space, gsp;
     double *pt1,*pt2;
@@ -1827,25 +1931,33 @@ void SyncVectorPatch::exchange_along_Y( std::vector<Field*> fields, VectorPatch&
 
 void SyncVectorPatch::finalize_exchange_along_Y( std::vector<Field*> fields, VectorPatch& vecPatches )
 {
+    if ( vecPatches.aggregate_field_exchanges_ ) {
+        vecPatches.aggregatedExchange( fields, vector<unsigned int>( 1, 1 ), false, NULL )->finalize();
+    } else {
 #ifndef _NO_MPI_TM
-    #pragma omp for schedule(static)
+        #pragma omp for schedule(static)
 #else
-    #pragma omp single
+        #pragma omp single
 #endif
-    for (unsigned int ipatch=0 ; ipatch<fields.size() ; ipatch++)
-        vecPatches(ipatch)->finalizeExchange( fields[ipatch], 1 );
+        for (unsigned int ipatch=0 ; ipatch<fields.size() ; ipatch++)
+            vecPatches(ipatch)->finalizeExchange( fields[ipatch], 1 );
+    }
 
 }
 
 void SyncVectorPatch::exchange_along_Z( std::vector<Field*> fields, VectorPatch& vecPatches, SmileiMPI* smpi )
 {
+    if ( vecPatches.aggregate_field_exchanges_ ) {
+        vecPatches.aggregatedExchange( fields, vector<unsigned int>( 1, 2 ), false, smpi )->start();
+    } else {
 #ifndef _NO_MPI_TM
-    #pragma omp for schedule(static)
+        #pragma omp for schedule(static)
 #else
-    #pragma omp single
+        #pragma omp single
 #endif
-    for (unsigned int ipatch=0 ; ipatch<fields.size() ; ipatch++)
-        vecPatches(ipatch)->initExchange( fields[ipatch], 2, smpi );
+        for (unsigned int ipatch=0 ; ipatch<fields.size() ; ipatch++)
+            vecPatches(ipatch)->initExchange( fields[ipatch], 2, smpi );
+    }
 
     unsigned int nx_, ny_, nz_, h0, oversize, n_space, gsp;
     double *pt1,*pt2;
@@ -1883,12 +1995,16 @@ void SyncVectorPatch::exchange_along_Z( std::vector<Field*> fields, VectorPatch&
 
 void SyncVectorPatch::finalize_exchange_along_Z( std::vector<Field*> fields, VectorPatch& vecPatches )
 {
+    if ( vecPatches.aggregate_field_exchanges_ ) {
+        vecPatches.aggregatedExchange( fields, vector<unsigned int>( 1, 2 ), false, NULL )->finalize();
+    } else {
 #ifndef _NO_MPI_TM
-    #pragma omp for schedule(static)
+        #pragma omp for schedule(static)
 #else
-    #pragma omp single
+        #pragma omp single
 #endif
-    for (unsigned int ipatch=0 ; ipatch<fields.size() ; ipatch++)
-        vecPatches(ipatch)->finalizeExchange( fields[ipatch], 2 );
+        for (unsigned int ipatch=0 ; ipatch<fields.size() ; ipatch++)
+            vecPatches(ipatch)->finalizeExchange( fields[ipatch], 2 );
+    }
 
 }
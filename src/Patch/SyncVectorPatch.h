@@ -16,6 +16,7 @@ public :
     //! Particles synchronization
     static void exchangeParticles(VectorPatch& vecPatches, int ispec, Params &params, SmileiMPI* smpi, Timers &timers, int itime);
     static void finalize_and_sort_parts(VectorPatch& vecPatches, int ispec, Params &params, SmileiMPI* smpi, Timers &timers, int itime);
+    static void initExchangeParticles(VectorPatch& vecPatches, int ispec, int iDim, Params &params, SmileiMPI* smpi);
     static void finalizeExchangeParticles(VectorPatch& vecPatches, int ispec, int iDim, Params &params, SmileiMPI* smpi, Timers &timers, int itime);
 
     //! Densities synchronization
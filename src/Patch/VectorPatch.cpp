@@ -4,7 +4,10 @@
 #include <iostream>
 #include <iomanip>
 #include <fstream>
+#include <sstream>
+#include <functional>
 #include <cstring>
+#include <algorithm>
 #include <math.h>
 //#include <string>
 
@@ -12,6 +15,8 @@
 #include "DomainDecompositionFactory.h"
 #include "PatchesFactory.h"
 #include "Species.h"
+#include "SpeciesV.h"
+#include "SpeciesMetrics.h"
 #include "Particles.h"
 #include "PeekAtSpecies.h"
 #include "SimWindow.h"
@@ -20,6 +25,9 @@
 #include "LaserEnvelope.h"
 
 #include "SyncVectorPatch.h"
+#include "PoissonMultigrid.h"
+#include "PoissonChebyshev.h"
+#include "AggregatedExchange.h"
 #include "interface.h"
 #include "Timers.h"
 
@@ -29,12 +37,16 @@ using namespace std;
 VectorPatch::VectorPatch()
 {
     domain_decomposition_ = NULL ;
+    aggregate_field_exchanges_ = false;
+    cost_ordered_tasks_ = false;
 }
 
 
 VectorPatch::VectorPatch( Params& params )
 {
     domain_decomposition_ = DomainDecompositionFactory::create( params );
+    aggregate_field_exchanges_ = params.aggregate_field_exchanges;
+    cost_ordered_tasks_ = params.cost_ordered_tasks;
 }
 
 
@@ -49,6 +61,8 @@ void VectorPatch::close(SmileiMPI * smpiData)
 {
     closeAllDiags( smpiData );
 
+    clearAggregatedExchanges();
+
 
     if ( diag_timers.size() )
         MESSAGE( "\n\tDiagnostics profile :" );
@@ -173,6 +187,75 @@ void VectorPatch::createDiags(Params& params, SmileiMPI* smpi, OpenPMDparams& op
 // ---------------------------------------------------------------------------------------------------------------------
 // ---------------------------------------------------------------------------------------------------------------------
 
+// ---------------------------------------------------------------------------------------------------------------------
+// Set the cost model used by the adaptive vectorization to choose between scalar and vectorized operators
+//   - coefficients given in the namelist
+//   - or fit on micro-benchmarks of the operators, averaged over the MPI processes
+// ---------------------------------------------------------------------------------------------------------------------
+void VectorPatch::calibrate_vectorization( Params& params, SmileiMPI* smpi )
+{
+    if( ! params.cost_model_coefficients.empty() ) {
+        SpeciesMetrics::set_coefficients( params.cost_model_coefficients );
+        return;
+    }
+    if( params.vectorization_cost_model != "benchmark" ) {
+        return;
+    }
+
+    TITLE("Calibrating the cost model of the adaptive vectorization");
+
+    vector<double> particles_per_cell = { 1, 2, 3, 4, 6, 8, 12, 16, 24, 32, 48, 64, 96, 128, 192, 256 };
+    vector<double> vecto_time ( particles_per_cell.size(), 0. );
+    vector<double> scalar_time( particles_per_cell.size(), 0. );
+
+    // First species with moving charged particles, in the first patch
+    int nbenchmarks = 0;
+    if( size() > 0 ) {
+        for( unsigned int ispec=0 ; ispec<(*this)(0)->vecSpecies.size() ; ispec++ ) {
+            SpeciesV* spec = dynamic_cast<SpeciesV*>( species(0, ispec) );
+            if( spec && spec->mass > 0 && ! spec->particles->is_test ) {
+                spec->benchmark_operators( params, (*this)(0), smpi, particles_per_cell, vecto_time, scalar_time );
+                nbenchmarks = 1;
+                break;
+            }
+        }
+    }
+
+    MPI_Allreduce( MPI_IN_PLACE, &nbenchmarks, 1, MPI_INT, MPI_SUM, smpi->getGlobalComm() );
+    if( nbenchmarks == 0 ) {
+        WARNING("No species to calibrate the cost model of the vectorization: the default model is used");
+        return;
+    }
+    MPI_Allreduce( MPI_IN_PLACE, &vecto_time [0], vecto_time .size(), MPI_DOUBLE, MPI_SUM, smpi->getGlobalComm() );
+    MPI_Allreduce( MPI_IN_PLACE, &scalar_time[0], scalar_time.size(), MPI_DOUBLE, MPI_SUM, smpi->getGlobalComm() );
+
+    SpeciesMetrics::fit_coefficients( particles_per_cell, vecto_time, scalar_time );
+    vector<double> coefficients = SpeciesMetrics::get_coefficients();
+
+    ostringstream list("");
+    list << setprecision(8) << "[";
+    for( unsigned int i=0 ; i<coefficients.size() ; i++ ) {
+        list << ( i>0 ? ", " : "" ) << coefficients[i];
+    }
+    list << "]";
+    MESSAGE(1, "Fitted on " << nbenchmarks << " process(es): cost_model_coefficients = " << list.str());
+
+    // Written to reuse the coefficients in the namelist of the next simulations
+    if( smpi->isMaster() ) {
+        ofstream output_file( "vectorization_cost_model.txt" );
+        output_file << "# Time per particle (s) of the operators (interpolation, push, projection)" << endl;
+        output_file << "# particles_per_cell scalar vectorized" << endl;
+        for( unsigned int i=0 ; i<particles_per_cell.size() ; i++ ) {
+            output_file << particles_per_cell[i] << " "
+                        << scalar_time[i]/nbenchmarks << " "
+                        << vecto_time[i]/nbenchmarks << endl;
+        }
+        output_file << "# In the block Vectorization of the namelist:" << endl;
+        output_file << "# cost_model_coefficients = " << list.str() << endl;
+        output_file.close();
+    }
+}
+
 // ---------------------------------------------------------------------------------------------------------------------
 // Configure all patches for the new time step
 // ---------------------------------------------------------------------------------------------------------------------
@@ -286,52 +369,27 @@ void VectorPatch::dynamics(Params& params,
     diag_flag = needsRhoJsNow(itime);
 
     timers.particles.restart();
-    ostringstream t;
-    #pragma omp for schedule(runtime)
-    for (unsigned int ipatch=0 ; ipatch<(*this).size() ; ipatch++) {
-        (*this)(ipatch)->EMfields->restartRhoJ();
-        //MESSAGE("restart rhoj");
-        for (unsigned int ispec=0 ; ispec<(*this)(ipatch)->vecSpecies.size() ; ispec++) {
-            if ( (*this)(ipatch)->vecSpecies[ispec]->isProj(time_dual, simWindow) || diag_flag  ) {
-                // Dynamics with vectorized operators
-                if (((*this)(ipatch)->vecSpecies[ispec]->vectorized_operators)&&(!(*this)(ipatch)->vecSpecies[ispec]->ponderomotive_dynamics))
-                {
-                    species(ipatch, ispec)->dynamics(time_dual, ispec,
-                                                     emfields(ipatch),
-                                                     params, diag_flag, partwalls(ipatch),
-                                                     (*this)(ipatch), smpi,
-                                                     RadiationTables,
-                                                     MultiphotonBreitWheelerTables,
-                                                     localDiags);
-                }
-                // Dynamics with scalar operators
-                else
-                {
-                    if ( (params.vectorization_mode == "adaptive") && (!(*this)(ipatch)->vecSpecies[ispec]->ponderomotive_dynamics) )
-                    {
-                        species(ipatch, ispec)->scalar_dynamics(time_dual, ispec,
-                                                      emfields(ipatch),
-                                                      params, diag_flag, partwalls(ipatch),
-                                                      (*this)(ipatch), smpi,
-                                                      RadiationTables,
-                                                      MultiphotonBreitWheelerTables,
-                                                      localDiags);
-                    }
-                    else if (!(*this)(ipatch)->vecSpecies[ispec]->ponderomotive_dynamics)
-                    {
-                        species(ipatch, ispec)->Species::dynamics(time_dual, ispec,
-                                                         emfields(ipatch),
-                                                         params, diag_flag, partwalls(ipatch),
-                                                         (*this)(ipatch), smpi,
-                                                         RadiationTables,
-                                                         MultiphotonBreitWheelerTables,
-                                                         localDiags);
-                    }
-                } // end if condition on envelope dynamics
-            } // end if condition on species
-        } // end loop on species
-        //MESSAGE("species dynamics");
-    } // end loop on patches
+    if ( cost_ordered_tasks_ ) {
+        // One task per patch, the most expensive patches (at the previous timestep) first:
+        // the threads picking the last tasks balance the load
+        #pragma omp single
+        {
+            vector<pair<double, unsigned int> > order( (*this).size() );
+            for (unsigned int ipatch=0 ; ipatch<(*this).size() ; ipatch++)
+                order[ipatch] = make_pair( -(*this)(ipatch)->dynamics_time, ipatch );
+            stable_sort( order.begin(), order.end() );
+            for (unsigned int i=0 ; i<order.size() ; i++) {
+                unsigned int ipatch = order[i].second;
+                #pragma omp task firstprivate(ipatch) shared(params, RadiationTables, MultiphotonBreitWheelerTables)
+                dynamicsPatch( ipatch, params, smpi, simWindow, RadiationTables, MultiphotonBreitWheelerTables, time_dual, itime );
+            }
+        } // the tasks are completed at the barrier ending the single region
+    }
+    else {
+        #pragma omp for schedule(runtime)
+        for (unsigned int ipatch=0 ; ipatch<(*this).size() ; ipatch++)
+            dynamicsPatch( ipatch, params, smpi, simWindow, RadiationTables, MultiphotonBreitWheelerTables, time_dual, itime );
+    }
 
 
     timers.particles.update( params.printNow( itime ) );
@@ -360,6 +418,72 @@ void VectorPatch::dynamics(Params& params,
 #endif
 } // END dynamics
 
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Particle dynamics of all the species of a patch (restartRhoJ(s) and dynamics), timed for the load balancing
+// ---------------------------------------------------------------------------------------------------------------------
+void VectorPatch::dynamicsPatch(unsigned int ipatch,
+                                Params& params,
+                                SmileiMPI* smpi,
+                                SimWindow* simWindow,
+                                RadiationTables & RadiationTables,
+                                MultiphotonBreitWheelerTables & MultiphotonBreitWheelerTables,
+                                double time_dual, int itime)
+{
+    double load_timer = MPI_Wtime();
+    (*this)(ipatch)->EMfields->restartRhoJ();
+    //MESSAGE("restart rhoj");
+    for (unsigned int ispec=0 ; ispec<(*this)(ipatch)->vecSpecies.size() ; ispec++) {
+        // Merging of the macro-particles, before their dynamics
+        if ( species(ipatch, ispec)->Merge
+          && time_dual > species(ipatch, ispec)->time_frozen
+          && species(ipatch, ispec)->merging_time_selection->theTimeIsNow(itime) )
+            species(ipatch, ispec)->merge_particles(params);
+        if ( (*this)(ipatch)->vecSpecies[ispec]->isProj(time_dual, simWindow) || diag_flag  ) {
+            // Dynamics with vectorized operators
+            if (((*this)(ipatch)->vecSpecies[ispec]->vectorized_operators)&&(!(*this)(ipatch)->vecSpecies[ispec]->ponderomotive_dynamics))
+            {
+                species(ipatch, ispec)->dynamics(time_dual, ispec,
+                                                 emfields(ipatch),
+                                                 params, diag_flag, partwalls(ipatch),
+                                                 (*this)(ipatch), smpi,
+                                                 RadiationTables,
+                                                 MultiphotonBreitWheelerTables,
+                                                 localDiags);
+            }
+            // Dynamics with scalar operators
+            else
+            {
+                if ( (params.vectorization_mode == "adaptive") && (!(*this)(ipatch)->vecSpecies[ispec]->ponderomotive_dynamics) )
+                {
+                    species(ipatch, ispec)->scalar_dynamics(time_dual, ispec,
+                                                  emfields(ipatch),
+                                                  params, diag_flag, partwalls(ipatch),
+                                                  (*this)(ipatch), smpi,
+                                                  RadiationTables,
+                                                  MultiphotonBreitWheelerTables,
+                                                  localDiags);
+                }
+                else if (!(*this)(ipatch)->vecSpecies[ispec]->ponderomotive_dynamics)
+                {
+                    species(ipatch, ispec)->Species::dynamics(time_dual, ispec,
+                                                     emfields(ipatch),
+                                                     params, diag_flag, partwalls(ipatch),
+                                                     (*this)(ipatch), smpi,
+                                                     RadiationTables,
+                                                     MultiphotonBreitWheelerTables,
+                                                     localDiags);
+                }
+            } // end if condition on envelope dynamics
+        } // end if condition on species
+    } // end loop on species
+    //MESSAGE("species dynamics");
+    // Accumulate the patch time for the measured load balancing
+    (*this)(ipatch)->dynamics_time = MPI_Wtime() - load_timer;
+    (*this)(ipatch)->load_timer += (*this)(ipatch)->dynamics_time;
+    (*this)(ipatch)->load_timer_steps++;
+} // END dynamicsPatch
+
 // ---------------------------------------------------------------------------------------------------------------------
 // For all patches, project charge and current densities with standard scheme for diag purposes at t=0
 // ---------------------------------------------------------------------------------------------------------------------
@@ -637,8 +761,22 @@ void VectorPatch::solveMaxwell(Params& params, SimWindow* simWindow, int itime,
         SyncVectorPatch::exchangeJ( params, (*this), smpi );
         SyncVectorPatch::finalizeexchangeJ( params, (*this) );
     }
+    // With several MPI processes, the cells of B sent to the neighbours are computed first, so that
+    // the exchange is in flight while Faraday is solved in the rest of the patches
+    bool split = smpi->getSize() > 1 && !params.full_B_exchange && !params.is_spectral
+                 && params.geometry != "AMcylindrical" && (*this)(0)->EMfields->MaxwellFaradaySolver_->isSplittable();
+    // Number of dual nodes and cells sent by SyncVectorPatch::exchangeB (up to 2*oversize+1+isDual from each side)
+    unsigned int n_d[3] = { 1, 1, 1 }, border[3] = { 0, 0, 0 };
+    for (unsigned int iDim=0 ; iDim<params.nDim_field ; iDim++) {
+        n_d[iDim]    = params.n_space[iDim]*params.global_factor[iDim]+2+2*params.oversize[iDim];
+        border[iDim] = 2*params.oversize[iDim]+2;
+        if ( n_d[iDim] < 2*border[iDim] )
+            split = false;
+    }
+
     #pragma omp for schedule(static)
     for (unsigned int ipatch=0 ; ipatch<(*this).size() ; ipatch++){
+        double load_timer = MPI_Wtime();
         if (!params.is_spectral) {
             // Saving magnetic fields (to compute centered fields used in the particle pusher)
             // Stores B at time n in B_m.
@@ -649,12 +787,30 @@ void VectorPatch::solveMaxwell(Params& params, SimWindow* simWindow, int itime,
         (*(*this)(ipatch)->EMfields->MaxwellAmpereSolver_)((*this)(ipatch)->EMfields);
         //MESSAGE("SOLVE MAXWELL AMPERE");
         // Computes Bx_, By_, Bz_ at time n+1 on interior points.
-        //for (unsigned int ipatch=0 ; ipatch<(*this).size() ; ipatch++) {
-        (*(*this)(ipatch)->EMfields->MaxwellFaradaySolver_)((*this)(ipatch)->EMfields);
+        if ( !split ) {
+            (*(*this)(ipatch)->EMfields->MaxwellFaradaySolver_)((*this)(ipatch)->EMfields);
+        }
+        else {
+            // Slabs of width border on both sides of each dimension, without the cells of the
+            // previous dimensions' slabs
+            for (unsigned int iDim=0 ; iDim<params.nDim_field ; iDim++) {
+                for (unsigned int iside=0 ; iside<2 ; iside++) {
+                    unsigned int imin[3], imax[3];
+                    for (unsigned int jDim=0 ; jDim<3 ; jDim++) {
+                        imin[jDim] = jDim<iDim ? border[jDim] : 0;
+                        imax[jDim] = jDim<iDim ? n_d[jDim]-border[jDim] : n_d[jDim];
+                    }
+                    imin[iDim] = iside==0 ? 0 : n_d[iDim]-border[iDim];
+                    imax[iDim] = iside==0 ? border[iDim] : n_d[iDim];
+                    (*this)(ipatch)->EMfields->MaxwellFaradaySolver_->solveBox( (*this)(ipatch)->EMfields, imin, imax );
+                }
+            }
+        }
         //MESSAGE("SOLVE MAXWELL FARADAY");
+        (*this)(ipatch)->load_timer += MPI_Wtime() - load_timer;
     }
     //Synchronize B fields between patches.
-    timers.maxwell.update( params.printNow( itime ) );
+    timers.maxwell.update( !split && params.printNow( itime ) );
 
 
     timers.syncField.restart();
@@ -671,6 +827,23 @@ void VectorPatch::solveMaxwell(Params& params, SimWindow* simWindow, int itime,
     }
     timers.syncField.update(  params.printNow( itime ) );
 
+    if ( split ) {
+        timers.maxwell.restart();
+        // Faraday on the rest of the patches, while B is exchanged
+        #pragma omp for schedule(static)
+        for (unsigned int ipatch=0 ; ipatch<(*this).size() ; ipatch++){
+            double load_timer = MPI_Wtime();
+            unsigned int imin[3], imax[3];
+            for (unsigned int iDim=0 ; iDim<3 ; iDim++) {
+                imin[iDim] = border[iDim];
+                imax[iDim] = n_d[iDim]-border[iDim];
+            }
+            (*this)(ipatch)->EMfields->MaxwellFaradaySolver_->solveBox( (*this)(ipatch)->EMfields, imin, imax );
+            (*this)(ipatch)->load_timer += MPI_Wtime() - load_timer;
+        }
+        timers.maxwell.update( params.printNow( itime ) );
+    }
+
 
     #ifdef _PICSAR
     //if ( (params.is_spectral) && (itime!=0) && ( time_dual > params.time_fields_frozen ) ) {
@@ -822,6 +995,13 @@ void VectorPatch::closeAllDiags(SmileiMPI* smpi)
 }
 
 
+void VectorPatch::waitAllDiagsOutput()
+{
+    for (unsigned int idiag = 0 ; idiag < localDiags.size() ; idiag++)
+        localDiags[idiag]->waitOutput();
+}
+
+
 void VectorPatch::openAllDiags(Params& params,SmileiMPI* smpi)
 {
     // MPI master opens all global diags
@@ -860,7 +1040,10 @@ void VectorPatch::runAllDiags(Params& params, SmileiMPI* smpi, unsigned int itim
             smpi->computeGlobalDiags( globalDiags[idiag], itime);
             // MPI master writes
             #pragma omp single
-            globalDiags[idiag]->write( itime , smpi );
+            {
+                if( globalDiags[idiag]->usesHDF5( itime ) ) waitAllDiagsOutput();
+                globalDiags[idiag]->write( itime , smpi );
+            }
         }
 
         diag_timers[idiag]->update();
@@ -874,8 +1057,11 @@ void VectorPatch::runAllDiags(Params& params, SmileiMPI* smpi, unsigned int itim
         localDiags[idiag]->theTimeIsNow = localDiags[idiag]->prepare( itime );
         #pragma omp barrier
         // All MPI run their stuff and write out
-        if( localDiags[idiag]->theTimeIsNow )
+        if( localDiags[idiag]->theTimeIsNow ) {
+            #pragma omp single
+            if( localDiags[idiag]->usesHDF5( itime ) ) waitAllDiagsOutput();
             localDiags[idiag]->run( smpi, *this, itime, simWindow, timers );
+        }
 
         diag_timers[globalDiags.size()+idiag]->update();
     }
@@ -953,6 +1139,11 @@ void VectorPatch::solvePoisson( Params &params, SmileiMPI* smpi )
     // compute control parameter
     double ctrl = rnew_dot_rnew / (double)(nx_p2_global);
 
+    if (params.poisson_solver != "CG" || params.poisson_preconditioner != "none") {
+        iteration = solvePoissonPreconditioned( params, smpi, 1., false, error_max*(double)(nx_p2_global), iteration_max, rnew_dot_rnew );
+        ctrl = rnew_dot_rnew / (double)(nx_p2_global);
+    }
+
     // ---------------------------------------------------------
     // Starting iterative loop for the conjugate gradient method
     // ---------------------------------------------------------
@@ -1169,6 +1360,169 @@ void VectorPatch::solvePoisson( Params &params, SmileiMPI* smpi )
 } // END solvePoisson
 
 
+unsigned int VectorPatch::solvePoissonPreconditioned( Params &params, SmileiMPI* smpi, double gamma_mean, bool relativistic,
+                                                      double rr_max, unsigned int iteration_max, double &rnew_dot_rnew )
+{
+    PoissonPreconditioner *preconditioner;
+    bool preconditioned = true;
+    if (params.poisson_solver == "multigrid")
+        preconditioner = new PoissonMultigrid( params, *this, gamma_mean );
+    else if (params.poisson_preconditioner == "chebyshev")
+        preconditioner = new PoissonChebyshev( params, *this, gamma_mean );
+    else {
+        preconditioner = new PoissonPreconditioner( params, *this, gamma_mean );
+        preconditioned = false;
+    }
+
+    std::vector<Field*> phi_, r_, p_, Ap_;
+    for (unsigned int ipatch=0 ; ipatch<this->size() ; ipatch++) {
+        phi_.push_back( (*this)(ipatch)->EMfields->phi_ );
+        r_  .push_back( (*this)(ipatch)->EMfields->r_   );
+        p_  .push_back( (*this)(ipatch)->EMfields->p_   );
+        Ap_ .push_back( (*this)(ipatch)->EMfields->Ap_  );
+    }
+
+    unsigned int iteration = 0;
+    double local[3], global[3];
+
+    if (params.poisson_solver != "pipelined_CG") {
+        // -----------------------------
+        // Preconditioned CG: z = M^-1 r
+        // -----------------------------
+        std::vector<Field*> z_ = preconditioner->newFields( *this );
+        preconditioner->precondition( *this, smpi, r_, z_ );
+        local[0] = preconditioner->dot( *this, r_, r_ );
+        local[1] = preconditioner->dot( *this, r_, z_ );
+        MPI_Allreduce(local, global, 2, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
+        rnew_dot_rnew = global[0];
+        double rnew_dot_z = global[1];
+        PoissonPreconditioner::xpby( p_, z_, 0. );
+
+        while ( (rnew_dot_rnew > rr_max) && (iteration<iteration_max) ) {
+            iteration++;
+
+            for (unsigned int ipatch=0 ; ipatch<this->size() ; ipatch++) {
+                if (relativistic)
+                    (*this)(ipatch)->EMfields->compute_Ap_relativistic_Poisson( (*this)(ipatch), gamma_mean );
+                else
+                    (*this)(ipatch)->EMfields->compute_Ap( (*this)(ipatch) );
+            }
+            SyncVectorPatch::exchange_along_all_directions_noomp          ( Ap_, *this, smpi );
+            SyncVectorPatch::finalize_exchange_along_all_directions_noomp ( Ap_, *this );
+
+            double p_dot_Ap_local = 0.0;
+            double p_dot_Ap       = 0.0;
+            for (unsigned int ipatch=0 ; ipatch<this->size() ; ipatch++)
+                p_dot_Ap_local += (*this)(ipatch)->EMfields->compute_pAp();
+            MPI_Allreduce(&p_dot_Ap_local, &p_dot_Ap, 1, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
+
+            // phi += alpha p, r -= alpha Ap with alpha = r.z / p.Ap
+            for (unsigned int ipatch=0 ; ipatch<this->size() ; ipatch++)
+                (*this)(ipatch)->EMfields->update_pand_r( rnew_dot_z, p_dot_Ap );
+
+            preconditioner->precondition( *this, smpi, r_, z_ );
+            local[0] = preconditioner->dot( *this, r_, r_ );
+            local[1] = preconditioner->dot( *this, r_, z_ );
+            MPI_Allreduce(local, global, 2, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
+            rnew_dot_rnew = global[0];
+            if (smpi->isMaster()) DEBUG("preconditioned CG iteration " << iteration << ": rnew_dot_rnew = " << rnew_dot_rnew);
+
+            PoissonPreconditioner::xpby( p_, z_, global[1]/rnew_dot_z );
+            rnew_dot_z = global[1];
+        }
+
+        PoissonPreconditioner::deleteFields( z_ );
+    }
+    else {
+        // ------------------------------------------------------------------------------
+        // Pipelined CG (Ghysels & Vanroose, Parallel Computing 40, 2014): the 3 scalar
+        // products of an iteration are reduced together, while M^-1 and A are applied
+        // ------------------------------------------------------------------------------
+        std::vector<Field*> w_ = preconditioner->newFields( *this );
+        std::vector<Field*> s_ = preconditioner->newFields( *this );
+        std::vector<Field*> n_ = preconditioner->newFields( *this );
+        std::vector<Field*> z_ = preconditioner->newFields( *this );
+        // Without preconditioner, u = r, m = w and q = s
+        std::vector<Field*> u_ = r_, m_ = w_, q_ = s_;
+        if (preconditioned) {
+            u_ = preconditioner->newFields( *this );
+            m_ = preconditioner->newFields( *this );
+            q_ = preconditioner->newFields( *this );
+            preconditioner->precondition( *this, smpi, r_, u_ );
+        }
+        preconditioner->laplacian( *this, smpi, u_, w_ );
+        // Source term, for the residual replacements
+        std::vector<Field*> b_ = preconditioner->newFields( *this );
+        PoissonPreconditioner::xpby( b_, r_, 0. );
+
+        double gamma_old(0.), alpha_old(0.);
+        while ( iteration<=iteration_max ) {
+            local[0] = preconditioner->dot( *this, r_, r_ );
+            local[1] = preconditioner->dot( *this, r_, u_ );
+            local[2] = preconditioner->dot( *this, w_, u_ );
+            MPI_Request request;
+            MPI_Iallreduce(local, global, 3, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD, &request);
+
+            if (preconditioned)
+                preconditioner->precondition( *this, smpi, w_, m_ );
+            preconditioner->laplacian( *this, smpi, m_, n_ );
+
+            MPI_Wait(&request, MPI_STATUS_IGNORE);
+            rnew_dot_rnew = global[0];
+            if ( (rnew_dot_rnew <= rr_max) || (iteration==iteration_max) ) break;
+            iteration++;
+            if (smpi->isMaster()) DEBUG("pipelined CG iteration " << iteration << ": rnew_dot_rnew = " << rnew_dot_rnew);
+
+            double gamma = global[1];
+            double delta = global[2];
+            double beta  = iteration>1 ? gamma/gamma_old : 0.;
+            double alpha = iteration>1 ? gamma/( delta - beta*gamma/alpha_old ) : gamma/delta;
+            gamma_old = gamma;
+            alpha_old = alpha;
+
+            PoissonPreconditioner::xpby( z_, n_, beta );
+            if (preconditioned)
+                PoissonPreconditioner::xpby( q_, m_, beta );
+            PoissonPreconditioner::xpby( s_, w_, beta );
+            PoissonPreconditioner::xpby( p_, u_, beta );
+            PoissonPreconditioner::axpy( phi_, alpha, p_ );
+            PoissonPreconditioner::axpy( r_, -alpha, s_ );
+            if (preconditioned)
+                PoissonPreconditioner::axpy( u_, -alpha, q_ );
+            PoissonPreconditioner::axpy( w_, -alpha, z_ );
+
+            // The recurrences drift from the true residual b - A phi: replace them regularly
+            if (iteration%50 == 0) {
+                preconditioner->laplacian( *this, smpi, phi_, n_ );
+                PoissonPreconditioner::xpby( r_, b_, 0. );
+                PoissonPreconditioner::axpy( r_, -1., n_ );
+                if (preconditioned)
+                    preconditioner->precondition( *this, smpi, r_, u_ );
+                preconditioner->laplacian( *this, smpi, u_, w_ );
+                preconditioner->laplacian( *this, smpi, p_, s_ );
+                if (preconditioned)
+                    preconditioner->precondition( *this, smpi, s_, q_ );
+                preconditioner->laplacian( *this, smpi, q_, z_ );
+            }
+        }
+
+        PoissonPreconditioner::deleteFields( b_ );
+        PoissonPreconditioner::deleteFields( w_ );
+        PoissonPreconditioner::deleteFields( s_ );
+        PoissonPreconditioner::deleteFields( n_ );
+        PoissonPreconditioner::deleteFields( z_ );
+        if (preconditioned) {
+            PoissonPreconditioner::deleteFields( u_ );
+            PoissonPreconditioner::deleteFields( m_ );
+            PoissonPreconditioner::deleteFields( q_ );
+        }
+    }
+
+    delete preconditioner;
+    return iteration;
+} // END solvePoissonPreconditioned
+
+
 void VectorPatch::solveRelativisticPoisson( Params &params, SmileiMPI* smpi, double time_primal )
 {
 
@@ -1299,6 +1653,11 @@ void VectorPatch::solveRelativisticPoisson( Params &params, SmileiMPI* smpi, dou
     //double ctrl = rnew_dot_rnew / (double)(nx_p2_global);
     double ctrl = sqrt(rnew_dot_rnew) / norm2_source_term; // initially is equal to one
 
+    if (params.poisson_solver != "CG" || params.poisson_preconditioner != "none") {
+        iteration = solvePoissonPreconditioned( params, smpi, gamma_mean, true, pow(error_max*norm2_source_term, 2), iteration_max, rnew_dot_rnew );
+        ctrl = sqrt(rnew_dot_rnew)/norm2_source_term;
+    }
+
     // ---------------------------------------------------------
     // Starting iterative loop for the conjugate gradient method
     // ---------------------------------------------------------
@@ -1679,8 +2038,9 @@ void VectorPatch::createPatches(Params& params, SmileiMPI* smpi, SimWindow* simW
 
 
     // Get an existing patch that will be used for cloning
+    // (the new set of patches may not overlap the current one: any patch fits)
     if( existing_patch_id<0 )
-        ERROR("No patch to clone. This should never happen!");
+        existing_patch_id = refHindex_;
     Patch * existing_patch = (*this)(existing_patch_id-refHindex_);
 
 
@@ -1709,32 +2069,26 @@ void VectorPatch::createPatches(Params& params, SmileiMPI* smpi, SimWindow* simW
 void VectorPatch::exchangePatches(SmileiMPI* smpi, Params& params)
 {
 
-    //int newMPIrankbis, oldMPIrankbis, tmp;
-    int newMPIrank = smpi->getRank() -1;
-    int oldMPIrank = smpi->getRank() -1;
-    int istart = 0;
     int nmessage = nrequests;
 
-    for (int irk=0 ; irk<smpi->getRank() ; irk++) istart += smpi->patch_count[irk];
+    // Patches may move to any rank: locate the future owner of each sent patch (new distribution)
+    // and the current owner of each received patch (first hindex of all ranks before balancing)
+    std::vector<int> send_rank( send_patch_id_.size() ), recv_rank( recv_patch_id_.size() );
+    std::vector<int> old_refHindexes( smpi->getSize() );
+    int refHindex = refHindex_;
+    MPI_Allgather( &refHindex, 1, MPI_INT, &old_refHindexes[0], 1, MPI_INT, MPI_COMM_WORLD );
+    for (unsigned int ipatch=0 ; ipatch < send_patch_id_.size() ; ipatch++)
+        send_rank[ipatch] = smpi->hrank( refHindex_+send_patch_id_[ipatch] );
+    for (unsigned int ipatch=0 ; ipatch < recv_patch_id_.size() ; ipatch++)
+        recv_rank[ipatch] = upper_bound( old_refHindexes.begin(), old_refHindexes.end(), (int)recv_patch_id_[ipatch] ) - old_refHindexes.begin() - 1;
 
 
     // Send particles
-    for (unsigned int ipatch=0 ; ipatch < send_patch_id_.size() ; ipatch++) {
-        // locate rank which will own send_patch_id_[ipatch]
-        // We assume patches are only exchanged with neighbours.
-        // Once all patches supposed to be sent to the left are done, we send the rest to the right.
-        // if hindex of patch to be sent      >  future hindex of the first patch owned by this process
-        if (send_patch_id_[ipatch]+refHindex_ > istart ) newMPIrank = smpi->getRank() + 1;
-
-        smpi->isend_species( (*this)(send_patch_id_[ipatch]), newMPIrank, (refHindex_+send_patch_id_[ipatch])*nmessage, params );
-    }
-
-    for (unsigned int ipatch=0 ; ipatch < recv_patch_id_.size() ; ipatch++) {
-        //if  hindex of patch to be received > first hindex actually owned, that means it comes from the next MPI process and not from the previous anymore.
-        if(recv_patch_id_[ipatch] > refHindex_ ) oldMPIrank = smpi->getRank() + 1;
+    for (unsigned int ipatch=0 ; ipatch < send_patch_id_.size() ; ipatch++)
+        smpi->isend_species( (*this)(send_patch_id_[ipatch]), send_rank[ipatch], (refHindex_+send_patch_id_[ipatch])*nmessage, params );
 
-        smpi->recv_species( recv_patches_[ipatch], oldMPIrank, recv_patch_id_[ipatch]*nmessage, params );
-    }
+    for (unsigned int ipatch=0 ; ipatch < recv_patch_id_.size() ; ipatch++)
+        smpi->recv_species( recv_patches_[ipatch], recv_rank[ipatch], recv_patch_id_[ipatch]*nmessage, params );
 
 
     for (unsigned int ipatch=0 ; ipatch < send_patch_id_.size() ; ipatch++)
@@ -1744,27 +2098,13 @@ void VectorPatch::exchangePatches(SmileiMPI* smpi, Params& params)
 
 
     // Split the exchangePatches process to avoid deadlock with OpenMPI (observed with OpenMPI on Irene and Poicnare, not with IntelMPI)
-    newMPIrank = smpi->getRank() -1;
-    oldMPIrank = smpi->getRank() -1;
-
 
     // Send fields
-    for (unsigned int ipatch=0 ; ipatch < send_patch_id_.size() ; ipatch++) {
-        // locate rank which will own send_patch_id_[ipatch]
-        // We assume patches are only exchanged with neighbours.
-        // Once all patches supposed to be sent to the left are done, we send the rest to the right.
-        // if hindex of patch to be sent      >  future hindex of the first patch owned by this process
-        if (send_patch_id_[ipatch]+refHindex_ > istart ) newMPIrank = smpi->getRank() + 1;
-
-        smpi->isend_fields( (*this)(send_patch_id_[ipatch]), newMPIrank, (refHindex_+send_patch_id_[ipatch])*nmessage, params );
-    }
+    for (unsigned int ipatch=0 ; ipatch < send_patch_id_.size() ; ipatch++)
+        smpi->isend_fields( (*this)(send_patch_id_[ipatch]), send_rank[ipatch], (refHindex_+send_patch_id_[ipatch])*nmessage, params );
 
-    for (unsigned int ipatch=0 ; ipatch < recv_patch_id_.size() ; ipatch++) {
-        //if  hindex of patch to be received > first hindex actually owned, that means it comes from the next MPI process and not from the previous anymore.
-        if(recv_patch_id_[ipatch] > refHindex_ ) oldMPIrank = smpi->getRank() + 1;
-
-        smpi->recv_fields( recv_patches_[ipatch], oldMPIrank, recv_patch_id_[ipatch]*nmessage, params );
-    }
+    for (unsigned int ipatch=0 ; ipatch < recv_patch_id_.size() ; ipatch++)
+        smpi->recv_fields( recv_patches_[ipatch], recv_rank[ipatch], recv_patch_id_[ipatch]*nmessage, params );
 
 
     for (unsigned int ipatch=0 ; ipatch < send_patch_id_.size() ; ipatch++)
@@ -1850,16 +2190,15 @@ void VectorPatch::output_exchanges(SmileiMPI* smpi)
     name << "debug_output"<<smpi->getRank()<<".txt" ;
     output_file.open(name.str().c_str(), std::ofstream::out | std::ofstream::app);
     int newMPIrank, oldMPIrank;
-    newMPIrank = smpi->getRank() -1;
-    oldMPIrank = smpi->getRank() -1;
-    int istart( 0 );
-    for (int irk=0 ; irk<smpi->getRank() ; irk++) istart += smpi->patch_count[irk];
+    std::vector<int> old_refHindexes( smpi->getSize() );
+    int refHindex = refHindex_;
+    MPI_Allgather( &refHindex, 1, MPI_INT, &old_refHindexes[0], 1, MPI_INT, MPI_COMM_WORLD );
     for (unsigned int ipatch=0 ; ipatch < send_patch_id_.size() ; ipatch++) {
-        if(send_patch_id_[ipatch]+refHindex_ > istart ) newMPIrank = smpi->getRank() + 1;
+        newMPIrank = smpi->hrank( send_patch_id_[ipatch]+refHindex_ );
         output_file << "Rank " << smpi->getRank() << " sending patch " << send_patch_id_[ipatch]+refHindex_ << " to " << newMPIrank << endl;
     }
     for (unsigned int ipatch=0 ; ipatch < recv_patch_id_.size() ; ipatch++) {
-        if(recv_patch_id_[ipatch] > refHindex_ ) oldMPIrank = smpi->getRank() + 1;
+        oldMPIrank = upper_bound( old_refHindexes.begin(), old_refHindexes.end(), (int)recv_patch_id_[ipatch] ) - old_refHindexes.begin() - 1;
         output_file << "Rank " << smpi->getRank() << " receiving patch " << recv_patch_id_[ipatch] << " from " << oldMPIrank << endl;
     }
     output_file << "NEXT" << endl;
@@ -1869,6 +2208,9 @@ void VectorPatch::output_exchanges(SmileiMPI* smpi)
 //! Resize vector of field*
 void VectorPatch::update_field_list( SmileiMPI* smpi )
 {
+    // The patches, or their neighbours, may have moved to other MPI processes
+    clearAggregatedExchanges();
+
     int nDim(0);
     if ( !dynamic_cast<ElectroMagnAM*>(patches_[0]->EMfields) )
         nDim = patches_[0]->EMfields->Ex_->dims_.size();
@@ -2285,6 +2627,44 @@ void VectorPatch::update_field_list(int ispec, SmileiMPI* smpi)
 }
 
 
+AggregatedExchange* VectorPatch::aggregatedExchange( vector<Field*>& fields, vector<unsigned int> dims, bool sum, SmileiMPI* smpi )
+{
+    // Lists are identified by the name of their first field and their number of components,
+    // which are the same on all MPI processes: the key also provides the MPI tag
+    ostringstream key("");
+    key << fields[0]->name << " " << fields.size()/size() << ( sum ? " sum" : " exchange" );
+    for ( unsigned int idir=0 ; idir<dims.size() ; idir++ )
+        key << " " << dims[idir];
+
+    #pragma omp single
+    {
+        map<string, AggregatedExchange*>::iterator it = aggregated_exchanges_.find( key.str() );
+        // Another list with the same name (fields reallocated, unnamed fields)
+        if ( ( it != aggregated_exchanges_.end() ) && ( !it->second->isBuiltFor( fields ) ) ) {
+            delete it->second;
+            aggregated_exchanges_.erase( it );
+            it = aggregated_exchanges_.end();
+        }
+        if ( it == aggregated_exchanges_.end() ) {
+            if ( smpi == NULL )
+                ERROR( "Aggregated exchange of " << key.str() << " finalized before being started" );
+            int tag = hash<string>()( key.str() ) % 32767;
+            aggregated_exchanges_[key.str()] = new AggregatedExchange( *this, fields, dims, sum, tag, smpi->getFieldExchangeComm() );
+        }
+    }
+
+    return aggregated_exchanges_.find( key.str() )->second;
+}
+
+
+void VectorPatch::clearAggregatedExchanges()
+{
+    for ( map<string, AggregatedExchange*>::iterator it = aggregated_exchanges_.begin() ; it != aggregated_exchanges_.end() ; it++ )
+        delete it->second;
+    aggregated_exchanges_.clear();
+}
+
+
 void VectorPatch::applyAntennas(double time)
 {
 #ifdef  __DEBUG
@@ -2323,9 +2703,12 @@ void VectorPatch::applyCollisions(Params& params, int itime, Timers & timers)
     unsigned int ncoll = patches_[0]->vecCollisions.size();
 
     #pragma omp for schedule(runtime)
-    for (unsigned int ipatch=0 ; ipatch<size() ; ipatch++)
+    for (unsigned int ipatch=0 ; ipatch<size() ; ipatch++) {
+        double load_timer = MPI_Wtime();
         for (unsigned int icoll=0 ; icoll<ncoll; icoll++)
             patches_[ipatch]->vecCollisions[icoll]->collide(params,patches_[ipatch],itime, localDiags);
+        patches_[ipatch]->load_timer += MPI_Wtime() - load_timer;
+    }
 
     #pragma omp single
     for (unsigned int icoll=0 ; icoll<ncoll; icoll++)
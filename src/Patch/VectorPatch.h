@@ -2,6 +2,8 @@
 #define VECTORPATCH_H
 
 #include <vector>
+#include <map>
+#include <string>
 #include <iostream>
 #include <cstdlib>
 #include <iomanip>
@@ -24,6 +26,7 @@ class Field;
 class Timer;
 class SimWindow;
 class DomainDecomposition;
+class AggregatedExchange;
 
 //! Class Patch : sub MPI domain
 //!     Collection of patch = MPI domain
@@ -91,6 +94,9 @@ public :
     // Interfaces between main programs & main PIC operators
     // -----------------------------------------------------
     
+    //! Set the cost model of the adaptive vectorization (namelist coefficients or startup benchmark)
+    void calibrate_vectorization( Params& params, SmileiMPI* smpi );
+    
     //! Reconfigure all patches for the new time step
     void configuration(Params& params, Timers &timers, int itime);
     
@@ -108,6 +114,15 @@ public :
                   double time_dual,
                   Timers &timers, int itime);
 
+    //! Particle dynamics of all the species of patch ipatch (called by one thread)
+    void dynamicsPatch(unsigned int ipatch,
+                       Params& params,
+                       SmileiMPI* smpi,
+                       SimWindow* simWindow,
+                       RadiationTables & RadiationTables,
+                       MultiphotonBreitWheelerTables & MultiphotonBreitWheelerTables,
+                       double time_dual, int itime);
+
     void finalize_and_sort_parts(Params& params, SmileiMPI* smpi, SimWindow* simWindow,
                   RadiationTables & RadiationTables,
                   MultiphotonBreitWheelerTables & MultiphotonBreitWheelerTables,
@@ -157,6 +172,8 @@ public :
     void initAllDiags(Params& params, SmileiMPI* smpi);
     void closeAllDiags(SmileiMPI* smpi);
     void openAllDiags(Params& params, SmileiMPI* smpi);
+    //! Wait for the end of the asynchronous outputs (HDF5 is not thread-safe)
+    void waitAllDiagsOutput();
 
     //! Check if rho is null (MPI & patch sync)
     bool isRhoNull( SmileiMPI* smpi );
@@ -164,6 +181,11 @@ public :
     //! Solve Poisson to initialize E
     void solvePoisson( Params &params, SmileiMPI* smpi );
 
+    //! Preconditioned (multigrid or Chebyshev) or pipelined conjugate gradient, on the fields prepared by initPoisson
+    //! Iterates until r.r < rr_max, returns the number of iterations and the final r.r in rnew_dot_rnew
+    unsigned int solvePoissonPreconditioned( Params &params, SmileiMPI* smpi, double gamma_mean, bool relativistic,
+                                             double rr_max, unsigned int iteration_max, double &rnew_dot_rnew );
+
     //! Solve relativistic Poisson problem to initialize E and B of a relativistic bunch
     void solveRelativisticPoisson( Params &params, SmileiMPI* smpi, double time_primal );
 
@@ -228,6 +250,16 @@ public :
     std::vector<Field*> B2_localz;
     std::vector<Field*> B2_MPIz;
 
+    //! True if the MPI part of the field synchronizations goes through AggregatedExchange
+    bool aggregate_field_exchanges_;
+    //! True if the particle dynamics of the patches are OpenMP tasks ordered by decreasing cost
+    bool cost_ordered_tasks_;
+    //! Aggregated exchange of a list of fields along the directions dims, built at its first use.
+    //! Must be called by all the threads (or outside of the OpenMP region).
+    AggregatedExchange* aggregatedExchange( std::vector<Field*>& fields, std::vector<unsigned int> dims, bool sum, SmileiMPI* smpi );
+    //! Delete the aggregated exchanges, which are only valid for a given distribution of the patches
+    void clearAggregatedExchanges();
+
     std::vector<Field*> listJx_;
     std::vector<Field*> listJy_;
     std::vector<Field*> listJz_;
@@ -345,6 +377,9 @@ private :
     double antenna_intensity;
 
     std::vector<Timer*> diag_timers;
+
+    //! Aggregated exchanges, by list of fields, direction and operation
+    std::map<std::string, AggregatedExchange*> aggregated_exchanges_;
 };
 
 
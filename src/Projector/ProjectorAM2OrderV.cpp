@@ -0,0 +1,357 @@
+#include "ProjectorAM2OrderV.h"
+
+#include <cmath>
+#include <iostream>
+#include <complex>
+#include "dcomplex.h"
+#include "ElectroMagnAM.h"
+#include "cField2D.h"
+#include "Particles.h"
+#include "Tools.h"
+#include "Patch.h"
+
+using namespace std;
+
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Constructor for ProjectorAM2OrderV
+// ---------------------------------------------------------------------------------------------------------------------
+ProjectorAM2OrderV::ProjectorAM2OrderV (Params& params, Patch* patch) : ProjectorAM2Order(params, patch)
+{
+    nscellr = params.n_space[1] + 1;
+    oversize[0] = params.oversize[0];
+    oversize[1] = params.oversize[1];
+
+    b_Jl.resize(Nmode);
+    b_Jr.resize(Nmode);
+    b_Jt.resize(Nmode);
+    b_rho.resize(Nmode);
+}
+
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Destructor for ProjectorAM2OrderV
+// ---------------------------------------------------------------------------------------------------------------------
+ProjectorAM2OrderV::~ProjectorAM2OrderV()
+{
+}
+
+
+// ---------------------------------------------------------------------------------------------------------------------
+//! Project current densities of all modes : main projector vectorized
+//   - the shape factors and the real Esirkepov currents Jl_p, Jr_p are computed once per particle for all modes
+//   - exp(i m theta), exp(i m theta_old) and the azimuthal phases are updated from one mode to the next
+// ---------------------------------------------------------------------------------------------------------------------
+void ProjectorAM2OrderV::currents(complex<double>** Jl, complex<double>** Jr, complex<double>** Jt, complex<double>** rho, Particles &particles, unsigned int istart, unsigned int iend, double* invgf, int* iold, double* deltaold, complex<double>* exp_m_theta_old, int ipart_ref)
+{
+    // -------------------------------------
+    // Variable declaration & initialization
+    // -------------------------------------
+
+    int npart_total = iold[2];
+    int ipo = iold[0];
+    int jpo = iold[1];
+    int ipom2 = ipo-2;
+    int jpom2 = jpo-2;
+
+    const int vecSize = 8;
+
+    double Sl0[5*vecSize] __attribute__((aligned(64)));
+    double Sr0[5*vecSize] __attribute__((aligned(64)));
+    double Sl1[5*vecSize] __attribute__((aligned(64)));
+    double Sr1[5*vecSize] __attribute__((aligned(64)));
+    double DSl[5*vecSize] __attribute__((aligned(64)));
+    double DSr[5*vecSize] __attribute__((aligned(64)));
+    // Currents of each particle, real and independent of the mode
+    double Jl_p[25*vecSize] __attribute__((aligned(64)));
+    double Jr_p[25*vecSize] __attribute__((aligned(64)));
+    double charge_weight[vecSize] __attribute__((aligned(64)));
+    double crt_p[vecSize] __attribute__((aligned(64)));
+    // exp(i theta), exp(i theta_old), exp(i dtheta/2), exp(i theta_bar) of each particle ...
+    double e_theta_re[vecSize], e_theta_im[vecSize], e_theta_old_re[vecSize], e_theta_old_im[vecSize];
+    double e_delta_m1_re[vecSize], e_delta_m1_im[vecSize], e_bar_m1_re[vecSize], e_bar_m1_im[vecSize];
+    // ... and their power m for the current mode
+    double C_m_re[vecSize], C_m_im[vecSize], C_m_old_re[vecSize], C_m_old_im[vecSize];
+    double e_delta_re[vecSize], e_delta_im[vecSize], e_bar_re[vecSize], e_bar_im[vecSize];
+    // Buffers of the current mode, 5x5 nodes per particle
+    double bJl_re[25*vecSize] __attribute__((aligned(64)));
+    double bJl_im[25*vecSize] __attribute__((aligned(64)));
+    double bJr_re[25*vecSize] __attribute__((aligned(64)));
+    double bJr_im[25*vecSize] __attribute__((aligned(64)));
+    double bJt_re[25*vecSize] __attribute__((aligned(64)));
+    double bJt_im[25*vecSize] __attribute__((aligned(64)));
+    double brho_re[25*vecSize] __attribute__((aligned(64)));
+    double brho_im[25*vecSize] __attribute__((aligned(64)));
+
+    // Radial factors of the Jr recursion, constant over the cell
+    double Vd[5], crr_fac[5];
+    for (unsigned int j=1 ; j<5 ; j++) {
+        int jloc = j+jpom2;
+        Vd[j] = abs( (jloc + j_domain_begin - 0.5)/(jloc + j_domain_begin + 0.5) );
+        crr_fac[j] = dr_ov_dt * invVd[jloc];
+    }
+
+    int cell_nparts( (int)iend-(int)istart );
+
+    for (int ivect=0 ; ivect < cell_nparts; ivect += vecSize ){
+
+        int np_computed = min(cell_nparts-ivect,vecSize);
+        int ipart0 = ivect+istart;
+
+        #pragma omp simd
+        for (int ipart=0 ; ipart<np_computed; ipart++ ){
+
+            int ipart_buf = ipart0+ipart-ipart_ref;
+
+            // locate the particle on the primal grid at current time-step & calculate coeff. S1
+            //                            L                                 //
+            double pos = particles.position(0, ipart0+ipart) * dl_inv_;
+            int cell = round(pos);
+            int cell_shift = cell-ipo-i_domain_begin;
+            double delta  = pos - (double)cell;
+            double delta2 = delta*delta;
+            double deltam =  0.5 * (delta2-delta+0.25);
+            double deltap =  0.5 * (delta2+delta+0.25);
+            delta2 = 0.75 - delta2;
+            double m1 = (cell_shift == -1);
+            double c0 = (cell_shift ==  0);
+            double p1 = (cell_shift ==  1);
+            Sl1[          ipart] = m1 * deltam;
+            Sl1[  vecSize+ipart] = c0 * deltam + m1*delta2;
+            Sl1[2*vecSize+ipart] = p1 * deltam + c0*delta2 + m1*deltap;
+            Sl1[3*vecSize+ipart] =               p1*delta2 + c0*deltap;
+            Sl1[4*vecSize+ipart] =                           p1*deltap;
+            // locate the particle on the primal grid at former time-step & calculate coeff. S0
+            delta = deltaold[ipart_buf];
+            delta2 = delta*delta;
+            Sl0[          ipart] = 0;
+            Sl0[  vecSize+ipart] = 0.5 * (delta2-delta+0.25);
+            Sl0[2*vecSize+ipart] = 0.75-delta2;
+            Sl0[3*vecSize+ipart] = 0.5 * (delta2+delta+0.25);
+            Sl0[4*vecSize+ipart] = 0;
+            //                            R                                 //
+            double yp = particles.position(1, ipart0+ipart);
+            double zp = particles.position(2, ipart0+ipart);
+            double rp = sqrt( yp*yp + zp*zp );
+            pos = rp * dr_inv_;
+            cell = round(pos);
+            cell_shift = cell-jpo-j_domain_begin;
+            delta  = pos - (double)cell;
+            delta2 = delta*delta;
+            deltam =  0.5 * (delta2-delta+0.25);
+            deltap =  0.5 * (delta2+delta+0.25);
+            delta2 = 0.75 - delta2;
+            m1 = (cell_shift == -1);
+            c0 = (cell_shift ==  0);
+            p1 = (cell_shift ==  1);
+            Sr1[          ipart] = m1 * deltam;
+            Sr1[  vecSize+ipart] = c0 * deltam + m1*delta2;
+            Sr1[2*vecSize+ipart] = p1 * deltam + c0*delta2 + m1*deltap;
+            Sr1[3*vecSize+ipart] =               p1*delta2 + c0*deltap;
+            Sr1[4*vecSize+ipart] =                           p1*deltap;
+            delta = deltaold[ipart_buf+npart_total];
+            delta2 = delta*delta;
+            Sr0[          ipart] = 0;
+            Sr0[  vecSize+ipart] = 0.5 * (delta2-delta+0.25);
+            Sr0[2*vecSize+ipart] = 0.75-delta2;
+            Sr0[3*vecSize+ipart] = 0.5 * (delta2+delta+0.25);
+            Sr0[4*vecSize+ipart] = 0;
+
+            for (unsigned int i = 0; i < 5 ; i++){
+                DSl[i*vecSize+ipart] = Sl1[i*vecSize+ipart] - Sl0[i*vecSize+ipart];
+                DSr[i*vecSize+ipart] = Sr1[i*vecSize+ipart] - Sr0[i*vecSize+ipart];
+            }
+
+            charge_weight[ipart] = (double)(particles.charge(ipart0+ipart))*particles.weight(ipart0+ipart);
+            crt_p[ipart] = charge_weight[ipart]*( particles.momentum(2,ipart0+ipart)*yp - particles.momentum(1,ipart0+ipart)*zp )/rp*invgf[ipart_buf];
+
+            // Azimuthal phases
+            e_theta_re[ipart] = yp/rp;
+            e_theta_im[ipart] = zp/rp;
+            e_theta_old_re[ipart] =  real( exp_m_theta_old[ipart_buf] );
+            e_theta_old_im[ipart] = -imag( exp_m_theta_old[ipart_buf] );
+            double theta = atan2( zp, yp );
+            double theta_old = atan2( e_theta_old_im[ipart], e_theta_old_re[ipart] );
+            double dtheta = std::remainder( theta-theta_old, 2*M_PI )/2.; // Otherwise dtheta is overestimated when going from -pi to +pi
+            double theta_bar = theta_old+dtheta;
+            e_delta_m1_re[ipart] = cos( dtheta );
+            e_delta_m1_im[ipart] = sin( dtheta );
+            e_bar_m1_re[ipart] = cos( theta_bar );
+            e_bar_m1_im[ipart] = sin( theta_bar );
+            C_m_re[ipart] = 1.;
+            C_m_im[ipart] = 0.;
+            C_m_old_re[ipart] = 1.;
+            C_m_old_im[ipart] = 0.;
+            e_delta_re[ipart] = 1.;
+            e_delta_im[ipart] = 0.;
+            e_bar_re[ipart] = 1.;
+            e_bar_im[ipart] = 0.;
+        }
+
+        // Esirkepov currents along l and r, shared by all modes
+        #pragma omp simd
+        for (int ipart=0 ; ipart<np_computed; ipart++ ){
+            double crl_p = charge_weight[ipart]*dl_ov_dt;
+            for (unsigned int j=0 ; j<5 ; j++) {
+                Jl_p[j*vecSize+ipart] = 0.;
+                double tmp = crl_p * (Sr0[j*vecSize+ipart] + 0.5*DSr[j*vecSize+ipart]);
+                for (unsigned int i=1 ; i<5 ; i++) {
+                    Jl_p[(i*5+j)*vecSize+ipart] = Jl_p[((i-1)*5+j)*vecSize+ipart] - tmp * DSl[(i-1)*vecSize+ipart];
+                }
+            }
+            for (unsigned int i=0 ; i<5 ; i++) {
+                Jr_p[(i*5)*vecSize+ipart] = 0.;
+                double tmp = charge_weight[ipart] * (Sl0[i*vecSize+ipart] + 0.5*DSl[i*vecSize+ipart]);
+                for (unsigned int j=1 ; j<5 ; j++) {
+                    Jr_p[(i*5+j)*vecSize+ipart] = Jr_p[(i*5+j-1)*vecSize+ipart]*Vd[j] - crr_fac[j] * tmp * DSr[(j-1)*vecSize+ipart];
+                }
+            }
+        }
+
+        for (unsigned int imode=0 ; imode<Nmode ; imode++) {
+
+            #pragma omp simd
+            for (int ipart=0 ; ipart<np_computed; ipart++ ){
+
+                // Jl and Jr are weighted by exp(i m theta) + exp(i m theta_old), and Jt uses the phase of theta_bar
+                double Cl_re, Cl_im, crt_re, crt_im, ed_re, ed_im;
+                if (imode == 0) {
+                    Cl_re = 1.;
+                    Cl_im = 0.;
+                } else {
+                    double tmp;
+                    tmp = C_m_re[ipart]*e_theta_re[ipart] - C_m_im[ipart]*e_theta_im[ipart];
+                    C_m_im[ipart] = C_m_re[ipart]*e_theta_im[ipart] + C_m_im[ipart]*e_theta_re[ipart];
+                    C_m_re[ipart] = tmp;
+                    tmp = C_m_old_re[ipart]*e_theta_old_re[ipart] - C_m_old_im[ipart]*e_theta_old_im[ipart];
+                    C_m_old_im[ipart] = C_m_old_re[ipart]*e_theta_old_im[ipart] + C_m_old_im[ipart]*e_theta_old_re[ipart];
+                    C_m_old_re[ipart] = tmp;
+                    tmp = e_delta_re[ipart]*e_delta_m1_re[ipart] - e_delta_im[ipart]*e_delta_m1_im[ipart];
+                    e_delta_im[ipart] = e_delta_re[ipart]*e_delta_m1_im[ipart] + e_delta_im[ipart]*e_delta_m1_re[ipart];
+                    e_delta_re[ipart] = tmp;
+                    tmp = e_bar_re[ipart]*e_bar_m1_re[ipart] - e_bar_im[ipart]*e_bar_m1_im[ipart];
+                    e_bar_im[ipart] = e_bar_re[ipart]*e_bar_m1_im[ipart] + e_bar_im[ipart]*e_bar_m1_re[ipart];
+                    e_bar_re[ipart] = tmp;
+
+                    Cl_re = C_m_re[ipart] + C_m_old_re[ipart];
+                    Cl_im = C_m_im[ipart] + C_m_old_im[ipart];
+                    // crt_p = -2 i q w / ( exp(i m theta_bar) dt m )
+                    double fac = 2.*charge_weight[ipart]/(dt*(double)imode);
+                    crt_re = -fac*e_bar_im[ipart];
+                    crt_im = -fac*e_bar_re[ipart];
+                    ed_re = e_delta_re[ipart];
+                    ed_im = e_delta_im[ipart];
+                }
+
+                for (unsigned int i=0 ; i<5 ; i++) {
+                    for (unsigned int j=0 ; j<5 ; j++) {
+                        int k = (i*5+j)*vecSize+ipart;
+                        double S0 = Sl0[i*vecSize+ipart]*Sr0[j*vecSize+ipart];
+                        double S1 = Sl1[i*vecSize+ipart]*Sr1[j*vecSize+ipart];
+                        bJl_re[k] = Cl_re * Jl_p[k];
+                        bJl_im[k] = Cl_im * Jl_p[k];
+                        bJr_re[k] = Cl_re * Jr_p[k];
+                        bJr_im[k] = Cl_im * Jr_p[k];
+                        if (imode == 0) {
+                            bJt_re[k] = crt_p[ipart] * 0.5 * (S0 + S1);
+                            bJt_im[k] = 0.;
+                        } else {
+                            // Wt = S1 (exp(-i m dtheta/2) - 1) - S0 (exp(i m dtheta/2) - 1)
+                            double Wt_re = (S1 - S0) * (ed_re - 1.);
+                            double Wt_im = -(S1 + S0) * ed_im;
+                            bJt_re[k] = crt_re*Wt_re - crt_im*Wt_im;
+                            bJt_im[k] = crt_re*Wt_im + crt_im*Wt_re;
+                        }
+                        brho_re[k] = Cl_re * charge_weight[ipart] * S1;
+                        brho_im[k] = Cl_im * charge_weight[ipart] * S1;
+                    }
+                }
+            }
+
+            // ---------------------------
+            // Calculate the total current
+            // ---------------------------
+            for (unsigned int i=0 ; i<5 ; i++) {
+                int iloc = i+ipom2;
+                for (unsigned int j=0 ; j<5 ; j++) {
+                    int jloc = j+jpom2;
+                    int ilocal = (i*5+j)*vecSize;
+                    double Jl_re(0.), Jl_im(0.), Jr_re(0.), Jr_im(0.), Jt_re(0.), Jt_im(0.), rho_re(0.), rho_im(0.);
+                    for (int ipart=0 ; ipart<np_computed; ipart++ ){
+                        Jl_re  += bJl_re [ilocal+ipart];
+                        Jl_im  += bJl_im [ilocal+ipart];
+                        Jr_re  += bJr_re [ilocal+ipart];
+                        Jr_im  += bJr_im [ilocal+ipart];
+                        Jt_re  += bJt_re [ilocal+ipart];
+                        Jt_im  += bJt_im [ilocal+ipart];
+                        rho_re += brho_re[ilocal+ipart];
+                        rho_im += brho_im[ilocal+ipart];
+                    }
+                    // Jl^(d,p)
+                    if (i > 0)
+                        Jl[imode][iloc*nprimr+jloc] += complex<double>(Jl_re, Jl_im) * invV[jloc];
+                    // Jr^(p,d)
+                    if (j > 0)
+                        Jr[imode][iloc*(nprimr+1)+jloc] += complex<double>(Jr_re, Jr_im);
+                    // Jt^(p,p)
+                    if (imode == 0)
+                        Jt[imode][iloc*nprimr+jloc] += complex<double>(Jt_re, Jt_im) * invV[jloc] * rprim[jloc];
+                    else
+                        Jt[imode][iloc*nprimr+jloc] += complex<double>(Jt_re, Jt_im) * invV[jloc];
+                    // Rho^(p,p)
+                    if (rho)
+                        rho[imode][iloc*nprimr+jloc] += complex<double>(rho_re, rho_im) * invV[jloc];
+                }
+            }
+
+        } // END imode
+
+    } // END ivect
+
+} // END Project vectorized
+
+
+// ---------------------------------------------------------------------------------------------------------------------
+//! Wrapper for projection
+// ---------------------------------------------------------------------------------------------------------------------
+void ProjectorAM2OrderV::operator() (ElectroMagn* EMfields, Particles &particles, SmileiMPI* smpi, int istart, int iend, int ithread, int scell, int clrw, bool diag_flag, bool is_spectral, std::vector<unsigned int> &b_dim, int ispec, int ipart_ref)
+{
+    if ( istart == iend ) return; //Don't treat empty cells.
+
+    if (is_spectral)
+        ERROR("Not implemented");
+
+    std::vector<double> *delta = &(smpi->dynamics_deltaold[ithread]);
+    std::vector<double> *invgf = &(smpi->dynamics_invgf[ithread]);
+    std::vector<std::complex<double>> *exp_m_theta_old = &(smpi->dynamics_thetaold[ithread]);
+
+    // Primal indices of the cell, and number of particles in the buffers
+    int iold[3];
+    iold[0] = scell/nscellr+oversize[0];
+    iold[1] = (scell%nscellr)+oversize[1];
+    iold[2] = invgf->size();
+
+    ElectroMagnAM* emAM = static_cast<ElectroMagnAM*>( EMfields );
+
+    // If no field diagnostics this timestep, then the projection is done directly on the total arrays
+    if (!diag_flag){
+        for ( unsigned int imode = 0; imode<Nmode;imode++){
+            b_Jl[imode] = &(*emAM->Jl_[imode])(0);
+            b_Jr[imode] = &(*emAM->Jr_[imode])(0);
+            b_Jt[imode] = &(*emAM->Jt_[imode])(0);
+        }
+        currents( &b_Jl[0], &b_Jr[0], &b_Jt[0], NULL, particles, istart, iend, &(*invgf)[0], iold, &(*delta)[0], &(*exp_m_theta_old)[0], ipart_ref );
+    }
+    // Otherwise, the projection may apply to the species-specific arrays
+    else {
+        int n_species = emAM->Jl_s.size() / Nmode;
+        for ( unsigned int imode = 0; imode<Nmode;imode++){
+            int ifield = imode*n_species+ispec;
+            b_Jl [imode] = emAM->Jl_s    [ifield] ? &(* (emAM->Jl_s    [ifield]) )(0) : &(*emAM->Jl_    [imode] )(0) ;
+            b_Jr [imode] = emAM->Jr_s    [ifield] ? &(* (emAM->Jr_s    [ifield]) )(0) : &(*emAM->Jr_    [imode] )(0) ;
+            b_Jt [imode] = emAM->Jt_s    [ifield] ? &(* (emAM->Jt_s    [ifield]) )(0) : &(*emAM->Jt_    [imode] )(0) ;
+            b_rho[imode] = emAM->rho_AM_s[ifield] ? &(* (emAM->rho_AM_s[ifield]) )(0) : &(*emAM->rho_AM_[imode] )(0) ;
+        }
+        currents( &b_Jl[0], &b_Jr[0], &b_Jt[0], &b_rho[0], particles, istart, iend, &(*invgf)[0], iold, &(*delta)[0], &(*exp_m_theta_old)[0], ipart_ref );
+    }
+}
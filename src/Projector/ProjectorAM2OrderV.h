@@ -0,0 +1,36 @@
+#ifndef PROJECTORAM2ORDERV_H
+#define PROJECTORAM2ORDERV_H
+
+#include <complex>
+
+#include "ProjectorAM2Order.h"
+
+
+class ElectroMagnAM;
+
+//  --------------------------------------------------------------------------------------------------------------------
+//! Class for vectorized 2nd order projector for AM simulations (particles sorted per cell)
+//  --------------------------------------------------------------------------------------------------------------------
+class ProjectorAM2OrderV : public ProjectorAM2Order {
+public:
+    ProjectorAM2OrderV(Params&, Patch* patch);
+    ~ProjectorAM2OrderV();
+
+    //! Project global current densities of all modes (EMfields->Jl_/Jr_/Jt_), and charge if rho is not NULL
+    void currents(std::complex<double>** Jl, std::complex<double>** Jr, std::complex<double>** Jt, std::complex<double>** rho, Particles &particles, unsigned int istart, unsigned int iend, double* invgf, int* iold, double* deltaold, std::complex<double>* exp_m_theta_old, int ipart_ref = 0);
+
+    //!Wrapper
+    void operator() (ElectroMagn* EMfields, Particles &particles, SmileiMPI* smpi, int istart, int iend, int ithread, int icell, int clrw, bool diag_flag, bool is_spectral, std::vector<unsigned int> &b_dim, int ispec, int ipart_ref = 0) override final;
+
+    // Frozen species, diagnostics and ionization are projected one by one (ProjectorAM2Order)
+    using ProjectorAM2Order::operator();
+
+private:
+    //! Number of cells of a patch along r in the particle sorting
+    int nscellr;
+    int oversize[2];
+    //! Arrays of each mode on which the current cell is projected
+    std::vector<std::complex<double>*> b_Jl, b_Jr, b_Jt, b_rho;
+};
+
+#endif
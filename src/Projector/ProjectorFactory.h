@@ -14,6 +14,7 @@
 #include "Projector2D2OrderV.h"
 #include "Projector3D2OrderV.h"
 #include "Projector3D4OrderV.h"
+#include "ProjectorAM2OrderV.h"
 #endif
 
 #include "Params.h"
@@ -72,7 +73,12 @@ public:
         // AM simulation
         // ---------------
         else if ( params.geometry == "AMcylindrical" ) {
-            Proj = new ProjectorAM2Order(params, patch);
+            if (!vectorization)
+                Proj = new ProjectorAM2Order(params, patch);
+#ifdef _VECTO
+            else
+                Proj = new ProjectorAM2OrderV(params, patch);
+#endif
         }
         else {
             ERROR( "Unknwon parameters : " << params.geometry << ", Order : " << params.interpolation_order );
@@ -35,7 +35,7 @@ void PusherBorisV::operator() (Particles &particles, SmileiMPI* smpi, int istart
 
     //int* cell_keys;
 
-    double* momentum[3];
+    particle_real* momentum[3];
     for ( int i = 0 ; i<3 ; i++ )
         momentum[i] =  &( particles.momentum(i,0) );
     double* position[3];
@@ -23,6 +23,8 @@
 #include "PusherBorisV.h"
 #include "PusherPonderomotiveBorisV.h"
 #include "PusherPonderomotivePositionBorisV.h"
+#include "PusherVayV.h"
+#include "PusherHigueraCaryV.h"
 #endif
 
 #include "Params.h"
@@ -85,11 +87,21 @@ public:
             }*/
             else if ( species->pusher == "vay" )
             {
-                Push = new PusherVay( params, species );
+                if (!species->vectorized_operators)
+                    Push = new PusherVay( params, species );
+#ifdef _VECTO
+                else
+                    Push = new PusherVayV( params, species );
+#endif
             }
             else if ( species->pusher == "higueracary" )
             {
-                Push = new PusherHigueraCary( params, species );
+                if (!species->vectorized_operators)
+                    Push = new PusherHigueraCary( params, species );
+#ifdef _VECTO
+                else
+                    Push = new PusherHigueraCaryV( params, species );
+#endif
             }
             else {
                 ERROR( "For species " << species->name
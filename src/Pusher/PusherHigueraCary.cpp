@@ -52,7 +52,7 @@ void PusherHigueraCary::operator() (Particles &particles, SmileiMPI* smpi, int i
     double pxsm, pysm, pzsm;
     double local_invgf;
 
-    double* momentum[3];
+    particle_real* momentum[3];
     for ( int i = 0 ; i<3 ; i++ )
         momentum[i] =  &( particles.momentum(i,0) );
     double* position[3];
@@ -40,7 +40,7 @@ void PusherPonderomotiveBoris::operator() (Particles &particles, SmileiMPI* smpi
     double gamma0,gamma0_sq,gamma_ponderomotive;
     double charge_sq_over_mass_sq;
 
-    double* momentum[3];
+    particle_real* momentum[3];
     for ( int i = 0 ; i<3 ; i++ )
         momentum[i] =  &( particles.momentum(i,0) );
 
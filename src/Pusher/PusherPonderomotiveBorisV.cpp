@@ -36,7 +36,7 @@ void PusherPonderomotiveBorisV::operator() (Particles &particles, SmileiMPI* smp
     double gamma0,gamma0_sq,gamma_ponderomotive;
     double charge_sq_over_mass_sq;
 
-    double* momentum[3];
+    particle_real* momentum[3];
     for ( int i = 0 ; i<3 ; i++ )
         momentum[i] =  &( particles.momentum(i,0) );
 
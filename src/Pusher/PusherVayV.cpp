@@ -0,0 +1,137 @@
+/*! @file PusherVayV.cpp
+
+ @brief PusherVayV.cpp  vectorized version of the particle pusher of J.L. Vay.
+
+ #details The description of the J.L. Vay pusher can be found in this reference:
+          http://dx.doi.org/10.1063/1.2837054
+
+ */
+#include "PusherVayV.h"
+
+#include <iostream>
+#include <cmath>
+
+#include "Species.h"
+
+#include "Particles.h"
+
+using namespace std;
+
+PusherVayV::PusherVayV(Params& params, Species *species)
+    : Pusher(params, species)
+{
+}
+
+PusherVayV::~PusherVayV()
+{
+}
+
+/***********************************************************************
+    Lorentz Force -- leap-frog (Vay) scheme
+***********************************************************************/
+
+void PusherVayV::operator() (Particles &particles, SmileiMPI* smpi, int istart, int iend, int ithread, int ipart_ref)
+{
+    std::vector<double> *Epart = &(smpi->dynamics_Epart[ithread]);
+    std::vector<double> *Bpart = &(smpi->dynamics_Bpart[ithread]);
+    double *invgf = &(smpi->dynamics_invgf[ithread][0]);
+
+    particle_real* momentum[3];
+    for ( int i = 0 ; i<3 ; i++ )
+        momentum[i] =  &( particles.momentum(i,0) );
+    double* position[3];
+    for ( int i = 0 ; i<nDim_ ; i++ )
+        position[i] =  &( particles.position(i,0) );
+#ifdef  __DEBUG
+    double* position_old[3];
+    for ( int i = 0 ; i<nDim_ ; i++ )
+        position_old[i] =  &( particles.position_old(i,0) );
+#endif
+    short* charge = &( particles.charge(0) );
+
+    int nparts = Epart->size()/3;
+    double* Ex = &( (*Epart)[0*nparts] );
+    double* Ey = &( (*Epart)[1*nparts] );
+    double* Ez = &( (*Epart)[2*nparts] );
+    double* Bx = &( (*Bpart)[0*nparts] );
+    double* By = &( (*Bpart)[1*nparts] );
+    double* Bz = &( (*Bpart)[2*nparts] );
+
+    double dcharge[nparts];
+    #pragma omp simd
+    for (int ipart=istart ; ipart<iend; ipart++ )
+        dcharge[ipart-ipart_ref] = (double)(charge[ipart]);
+
+    #pragma omp simd
+    for (int ipart=istart ; ipart<iend; ipart++ ) {
+        double charge_over_mass_dts2 = dcharge[ipart-ipart_ref]*one_over_mass_*dts2;
+        double pm[3], up[3], T[3];
+
+        pm[0] = momentum[0][ipart];
+        pm[1] = momentum[1][ipart];
+        pm[2] = momentum[2][ipart];
+
+        // ____________________________________________
+        // Part I: Computation of uprime
+
+        double local_invgf = 1./sqrt( 1.0 + pm[0]*pm[0] + pm[1]*pm[1] + pm[2]*pm[2] );
+
+        // Add Electric field
+        up[0] = pm[0] + 2.*charge_over_mass_dts2*(*(Ex+ipart-ipart_ref));
+        up[1] = pm[1] + 2.*charge_over_mass_dts2*(*(Ey+ipart-ipart_ref));
+        up[2] = pm[2] + 2.*charge_over_mass_dts2*(*(Ez+ipart-ipart_ref));
+
+        // Add magnetic field
+        T[0] = charge_over_mass_dts2*(*(Bx+ipart-ipart_ref));
+        T[1] = charge_over_mass_dts2*(*(By+ipart-ipart_ref));
+        T[2] = charge_over_mass_dts2*(*(Bz+ipart-ipart_ref));
+
+        up[0] += local_invgf*(pm[1]*T[2] - pm[2]*T[1]);
+        up[1] += local_invgf*(pm[2]*T[0] - pm[0]*T[2]);
+        up[2] += local_invgf*(pm[0]*T[1] - pm[1]*T[0]);
+
+        // alpha is gamma^2
+        double alpha = 1.0 + up[0]*up[0] + up[1]*up[1] + up[2]*up[2];
+        double T2    = T[0]*T[0] + T[1]*T[1] + T[2]*T[2];
+
+        // ___________________________________________
+        // Part II: Computation of Gamma^{i+1}
+
+        // s is sigma
+        double s   = alpha - T2;
+        double us  = up[0]*T[0] + up[1]*T[1] + up[2]*T[2];
+
+        // alpha becomes 1/gamma^{i+1}
+        alpha = 1.0/sqrt(0.5*(s + sqrt(s*s + 4.0*( T2 + us*us ))));
+
+        T[0] *= alpha;
+        T[1] *= alpha;
+        T[2] *= alpha;
+
+        s     = 1.0/(1.0+T[0]*T[0]+T[1]*T[1]+T[2]*T[2]);
+        alpha = up[0]*T[0] + up[1]*T[1] + up[2]*T[2];
+
+        pm[0] = s*(up[0] + alpha*T[0] + T[2]*up[1] - T[1]*up[2]);
+        pm[1] = s*(up[1] + alpha*T[1] + T[0]*up[2] - T[2]*up[0]);
+        pm[2] = s*(up[2] + alpha*T[2] + T[1]*up[0] - T[0]*up[1]);
+
+        // Inverse Gamma factor
+        local_invgf = 1.0 / sqrt( 1.0 + pm[0]*pm[0] + pm[1]*pm[1] + pm[2]*pm[2] );
+        invgf[ipart-ipart_ref] = local_invgf;
+
+        momentum[0][ipart] = pm[0];
+        momentum[1][ipart] = pm[1];
+        momentum[2][ipart] = pm[2];
+
+        // Move the particle
+#ifdef  __DEBUG
+        for ( int i = 0 ; i<nDim_ ; i++ )
+          position_old[i][ipart] = position[i][ipart];
+#endif
+        local_invgf *= dt;
+        for ( int i = 0 ; i<nDim_ ; i++ )
+            position[i][ipart]     += pm[i]*local_invgf;
+
+    }
+
+}
@@ -0,0 +1,28 @@
+/*! @file PusherVayV.h
+
+ @brief PusherVayV.h  vectorized version of the particle pusher of J.L. Vay.
+
+ #details The description of the J.L. Vay pusher can be found in this reference:
+          http://dx.doi.org/10.1063/1.2837054
+
+ */
+
+#ifndef PUSHERVAYV_H
+#define PUSHERVAYV_H
+
+#include "Pusher.h"
+
+//  --------------------------------------------------------------------------------------------------------------------
+//! Class PusherVayV
+//  --------------------------------------------------------------------------------------------------------------------
+class PusherVayV : public Pusher {
+public:
+    //! Creator for Pusher
+    PusherVayV(Params& params, Species *species);
+    ~PusherVayV();
+    //! Overloading of () operator
+    virtual void operator() (Particles &particles, SmileiMPI* smpi, int istart, int iend, int ithread, int ipart_ref = 0);
+
+};
+
+#endif
@@ -176,6 +176,8 @@ class Main(SmileiSingleton):
     interpolation_order = 2
     number_of_patches = None
     patch_arrangement = "hilbertian"
+    aggregate_field_exchanges = True
+    cost_ordered_tasks = True
     clrw = -1
     every_clean_particles_overhead = 100
     timestep = None
@@ -192,6 +194,9 @@ class Main(SmileiSingleton):
     solve_poisson = True
     poisson_max_iteration = 50000
     poisson_max_error = 1.e-14
+    poisson_solver = 'CG'
+    poisson_preconditioner = 'none'
+    poisson_chebyshev_degree = 4
 
     # Relativistic Poisson tuning
     solve_relativistic_poisson = False
@@ -229,7 +234,7 @@ class Main(SmileiSingleton):
                     raise Exception("Need cell_length to calculate timestep")
 
                 # Yee solver
-                if Main.maxwell_solver == 'Yee':
+                if Main.maxwell_solver in ['Yee', 'YeeTiled']:
                     dim = int(Main.geometry[0])
                     if dim<1 or dim>3:
                         raise Exception("timestep_over_CFL not implemented in geometry "+Main.geometry)
@@ -289,6 +294,8 @@ class LoadBalancing(SmileiSingleton):
     initial_balance      = True
     cell_load            = 1.0
     frozen_particle_load = 0.1
+    load_model           = "particles"
+    load_smoothing       = 0.5
 
 # Radiation reaction configuration (continuous and MC algorithms)
 class Vectorization(SmileiSingleton):
@@ -298,6 +305,9 @@ class Vectorization(SmileiSingleton):
     mode                = "off"
     reconfigure_every   = 20
     initial_mode        = "off"
+    cell_ordering       = "standard"
+    cost_model          = "default"
+    cost_model_coefficients = []
 
 
 class MovingWindow(SmileiSingleton):
@@ -352,6 +362,10 @@ class Species(SmileiComponent):
     radiation_photon_gamma_threshold = 2
     multiphoton_Breit_Wheeler = [None,None]
     multiphoton_Breit_Wheeler_sampling = [1,1]
+    merging_method = "none"
+    merge_every = 0
+    merge_min_particles_per_cell = 4
+    merge_momentum_cell_size = [16,16,16]
     time_frozen = 0.0
     radiating = False
     relativistic_field_initialization = False
@@ -365,6 +379,7 @@ class Species(SmileiComponent):
     is_test = False
     relativistic_field_initialization = False
     ponderomotive_dynamics = False
+    particles_storage = "soa"
 
 class Laser(SmileiComponent):
     """Laser parameters"""
@@ -444,6 +459,7 @@ class DiagFields(SmileiComponent):
     time_average = 1
     subgrid = None
     flush_every = 1
+    asynchronous = False
 
 class DiagTrackParticles(SmileiComponent):
     """Track diagnostic"""
@@ -512,6 +528,8 @@ class RadiationReaction(SmileiComponent):
     chipa_radiation_threshold = 1e-3
     # Path the tables/databases
     table_path = "./"
+    # Path to the cache of the computed tables (no cache if empty)
+    table_cache_path = ""
 
 # MutliphotonBreitWheeler pair creation
 class MultiphotonBreitWheeler(SmileiComponent):
@@ -522,6 +540,8 @@ class MultiphotonBreitWheeler(SmileiComponent):
     output_format = "hdf5"
     # Path the tables/databases
     table_path = "./"
+    # Path to the cache of the computed tables (no cache if empty)
+    table_cache_path = ""
     # Table T parameters
     T_chiph_min = 1e-2
     T_chiph_max = 1e1
@@ -81,7 +81,7 @@ void Radiation::compute_thread_chipa(Particles &particles,
     double gamma;
 
     // Momentum shortcut
-    double* momentum[3];
+    particle_real* momentum[3];
     for ( int i = 0 ; i<3 ; i++ )
         momentum[i] =  &( particles.momentum(i,0) );
 
@@ -89,7 +89,7 @@ void Radiation::compute_thread_chipa(Particles &particles,
     short* charge = &( particles.charge(0) );
 
     // Quantum parameter
-    double* chi = &( particles.chi(0));
+    particle_real* chi = &( particles.chi(0));
 
     // _______________________________________________________________
     // Computation
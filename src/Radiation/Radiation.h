@@ -36,6 +36,7 @@ class Radiation
         //! \param smpi        MPI properties
         //! \param RadiationTables Cross-section data tables and useful functions
         //                     for nonlinear inverse Compton scattering
+        //! \param rand        Random number generator of the patch
         //! \param istart      Index of the first particle
         //! \param iend        Index of the last particle
         //! \param ithread     Thread index
@@ -44,6 +45,7 @@ class Radiation
                 Species * photon_species,
                 SmileiMPI* smpi,
                 RadiationTables &RadiationTables,
+                Random * rand,
                 int istart,
                 int iend,
                 int ithread, int ipart_ref = 0) = 0;
@@ -63,7 +65,7 @@ class Radiation
         //! \param Bz z component of the particle magnetic field
         //#pragma omp declare simd
         double inline compute_chipa(double & charge_over_mass2,
-                                     double & px, double & py, double & pz,
+                                     const double & px, const double & py, const double & pz,
                                      double & gamma,
                                      double & Ex, double & Ey, double & Ez,
                                      double & Bx, double & By, double & Bz)
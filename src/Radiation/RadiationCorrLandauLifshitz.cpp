@@ -50,6 +50,7 @@ void RadiationCorrLandauLifshitz::operator() (
         Species * photon_species,
         SmileiMPI* smpi,
         RadiationTables &RadiationTables,
+        Random * rand,
         int istart,
         int iend,
         int ithread, int ipart_ref)
@@ -85,7 +86,7 @@ void RadiationCorrLandauLifshitz::operator() (
     double temp;
 
     // Momentum shortcut
-    double* momentum[3];
+    particle_real* momentum[3];
     for ( int i = 0 ; i<3 ; i++ )
         momentum[i] =  &( particles.momentum(i,0) );
 
@@ -93,7 +94,7 @@ void RadiationCorrLandauLifshitz::operator() (
     short* charge = &( particles.charge(0) );
 
     // Weight shortcut
-    double* weight = &( particles.weight(0) );
+    particle_real* weight = &( particles.weight(0) );
 
     // Optical depth for the Monte-Carlo process
     // double* chi = &( particles.chi(0));
@@ -39,6 +39,7 @@ class RadiationCorrLandauLifshitz : public Radiation {
         //! \param smpi        MPI properties
         //! \param nlicsTables Cross-section data tables and useful functions
         //                     for nonlinear inverse Compton scattering
+        //! \param rand        Random number generator of the patch
         //! \param istart      Index of the first particle
         //! \param iend        Index of the last particle
         //! \param ithread     Thread index
@@ -48,6 +49,7 @@ class RadiationCorrLandauLifshitz : public Radiation {
                 Species * photon_species,
                 SmileiMPI* smpi,
                 RadiationTables &RadiationTables,
+                Random * rand,
                 int istart,
                 int iend,
                 int ithread, int ipart_ref = 0);
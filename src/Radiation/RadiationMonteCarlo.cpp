@@ -53,6 +53,7 @@ void RadiationMonteCarlo::operator() (
         Species * photon_species,
         SmileiMPI* smpi,
         RadiationTables &RadiationTables,
+        Random * rand,
         int istart,
         int iend,
         int ithread, int ipart_ref)
@@ -99,7 +100,7 @@ void RadiationMonteCarlo::operator() (
     int mc_it_nb;
 
     // Momentum shortcut
-    double* momentum[3];
+    particle_real* momentum[3];
     for ( int i = 0 ; i<3 ; i++ )
         momentum[i] =  &( particles.momentum(i,0) );
 
@@ -112,10 +113,10 @@ void RadiationMonteCarlo::operator() (
     short* charge = &( particles.charge(0) );
 
     // Weight shortcut
-    double* weight = &( particles.weight(0) );
+    particle_real* weight = &( particles.weight(0) );
 
     // Optical depth for the Monte-Carlo process
-    double* tau = &( particles.tau(0));
+    particle_real* tau = &( particles.tau(0));
 
     // Optical depth for the Monte-Carlo process
     // double* chi = &( particles.chi(0));
@@ -126,6 +127,36 @@ void RadiationMonteCarlo::operator() (
     // _______________________________________________________________
     // Computation
 
+    // Vectorized computation of gamma, of the particle quantum parameter
+    // and of the cross-section at the beginning of the time step
+    // for the whole bin, using direct-index lookups in the tables
+    int nbparticles = iend-istart;
+    if (nbparticles <= 0) return;
+    gamma_buffer.resize(nbparticles);
+    chipa_buffer.resize(nbparticles);
+    dNphdt_buffer.resize(nbparticles);
+    double * gamma0 = &gamma_buffer[0];
+    double * chipa0 = &chipa_buffer[0];
+
+    #pragma omp simd private(charge_over_mass2)
+    for (int ip=0 ; ip<nbparticles; ip++ ) {
+        int ipart = istart + ip;
+        charge_over_mass2 = (double)(charge[ipart])*one_over_mass_2;
+
+        gamma0[ip] = sqrt(1.0 + momentum[0][ipart]*momentum[0][ipart]
+                              + momentum[1][ipart]*momentum[1][ipart]
+                              + momentum[2][ipart]*momentum[2][ipart]);
+
+        chipa0[ip] = Radiation::compute_chipa(charge_over_mass2,
+                     momentum[0][ipart],momentum[1][ipart],momentum[2][ipart],
+                     gamma0[ip],
+                     (*(Ex+ipart-ipart_ref)),(*(Ey+ipart-ipart_ref)),(*(Ez+ipart-ipart_ref)),
+                     (*(Bx+ipart-ipart_ref)),(*(By+ipart-ipart_ref)),(*(Bz+ipart-ipart_ref)) );
+    }
+
+    RadiationTables.compute_dNphdt(chipa0, gamma0, &dNphdt_buffer[0], nbparticles);
+
+    // Monte-Carlo process (not vectorized)
     for (int ipart=istart ; ipart<iend; ipart++ ) {
         charge_over_mass2 = (double)(charge[ipart])*one_over_mass_2;
 
@@ -139,17 +170,26 @@ void RadiationMonteCarlo::operator() (
              &&(mc_it_nb < mc_it_nb_max))
         {
 
-            // Gamma
-            gamma = sqrt(1.0 + momentum[0][ipart]*momentum[0][ipart]
-                             + momentum[1][ipart]*momentum[1][ipart]
-                             + momentum[2][ipart]*momentum[2][ipart]);
-
-            // Computation of the Lorentz invariant quantum parameter
-            chipa = Radiation::compute_chipa(charge_over_mass2,
-                     momentum[0][ipart],momentum[1][ipart],momentum[2][ipart],
-                     gamma,
-                     (*(Ex+ipart-ipart_ref)),(*(Ey+ipart-ipart_ref)),(*(Ez+ipart-ipart_ref)),
-                     (*(Bx+ipart-ipart_ref)),(*(By+ipart-ipart_ref)),(*(Bz+ipart-ipart_ref)) );
+            // The momentum is unchanged before the first emission
+            if (mc_it_nb == 0)
+            {
+                gamma = gamma0[ipart-istart];
+                chipa = chipa0[ipart-istart];
+            }
+            else
+            {
+                // Gamma
+                gamma = sqrt(1.0 + momentum[0][ipart]*momentum[0][ipart]
+                                 + momentum[1][ipart]*momentum[1][ipart]
+                                 + momentum[2][ipart]*momentum[2][ipart]);
+
+                // Computation of the Lorentz invariant quantum parameter
+                chipa = Radiation::compute_chipa(charge_over_mass2,
+                         momentum[0][ipart],momentum[1][ipart],momentum[2][ipart],
+                         gamma,
+                         (*(Ex+ipart-ipart_ref)),(*(Ey+ipart-ipart_ref)),(*(Ez+ipart-ipart_ref)),
+                         (*(Bx+ipart-ipart_ref)),(*(By+ipart-ipart_ref)),(*(Bz+ipart-ipart_ref)) );
+            }
 
             // Update the quantum parameter in species
             // chi[ipart] = chipa;
@@ -163,7 +203,7 @@ void RadiationMonteCarlo::operator() (
             {
                 // New final optical depth to reach for emision
                 while (tau[ipart] <= epsilon_tau)
-                   tau[ipart] = -log(1.-Rand::uniform());
+                   tau[ipart] = -log(1.-rand->uniform());
 
             }
 
@@ -173,7 +213,10 @@ void RadiationMonteCarlo::operator() (
             {
 
                 // from the cross section
-                temp = RadiationTables.compute_dNphdt(chipa,gamma);
+                if (mc_it_nb == 0)
+                    temp = dNphdt_buffer[ipart-istart];
+                else
+                    temp = RadiationTables.compute_dNphdt(chipa,gamma);
 
                 // Time to discontinuous emission
                 // If this time is > the remaining iteration time,
@@ -194,7 +237,8 @@ void RadiationMonteCarlo::operator() (
                                            momentum,
                                            weight,
                                            photon_species,
-                                           RadiationTables);
+                                           RadiationTables,
+                                           rand);
 
                     // Optical depth becomes negative meaning
                     // that a new drawing is possible
@@ -263,15 +307,17 @@ void RadiationMonteCarlo::operator() (
 //! \param momentum           particle momentum
 //! \param RadiationTables    Cross-section data tables and useful functions
 //                        for nonlinear inverse Compton scattering
+//! \param rand               Random number generator of the patch
 // ---------------------------------------------------------------------------------------------------------------------
 void RadiationMonteCarlo::photon_emission(int ipart,
                             double &chipa,
                             double & gammapa,
                             double * position[3],
-                            double * momentum[3],
-                            double * weight,
+                            particle_real * momentum[3],
+                            particle_real * weight,
                             Species * photon_species,
-                            RadiationTables &RadiationTables)
+                            RadiationTables &RadiationTables,
+                            Random * rand)
 {
     // ____________________________________________________
     // Parameters
@@ -281,7 +327,7 @@ void RadiationMonteCarlo::photon_emission(int ipart,
     //double new_norm_p;
 
     // Get the photon quantum parameter from the table xip
-    chiph = RadiationTables.compute_chiph_emission(chipa);
+    chiph = RadiationTables.compute_chiph_emission(chipa, rand);
 
     // compute the photon gamma factor
     gammaph = chiph/chipa*(gammapa-1.0);
@@ -39,6 +39,7 @@ class RadiationMonteCarlo : public Radiation {
         //! \param smpi        MPI properties
         //! \param RadiationTables Cross-section data tables and useful functions
         //                     for nonlinear inverse Compton scattering
+        //! \param rand        Random number generator of the patch
         //! \param istart      Index of the first particle
         //! \param iend        Index of the last particle
         //! \param ithread     Thread index
@@ -48,6 +49,7 @@ class RadiationMonteCarlo : public Radiation {
                 Species * photon_species,
                 SmileiMPI* smpi,
                 RadiationTables &RadiationTables,
+                Random * rand,
                 int istart,
                 int iend,
                 int ithread, int ipart_ref = 0);
@@ -62,15 +64,17 @@ class RadiationMonteCarlo : public Radiation {
         //! \param momentum           particle momentum
         //! \param RadiationTables    Cross-section data tables and useful functions
         //                        for nonlinear inverse Compton scattering
+        //! \param rand               Random number generator of the patch
         // ---------------------------------------------------------------------
         void photon_emission(int ipart,
                              double & chipa,
                              double & gammapa,
                              double * position[3],
-                             double * momentum[3],
-                             double * weight,
+                             particle_real * momentum[3],
+                             particle_real * weight,
                              Species * photon_species,
-                             RadiationTables &RadiationTables);
+                             RadiationTables &RadiationTables,
+                             Random * rand);
 
     protected:
 
@@ -96,6 +100,12 @@ class RadiationMonteCarlo : public Radiation {
 
     private:
 
+        //! Lorentz factor, quantum parameter and cross-section of the particles
+        //! of the bin at the beginning of the time step (computed at once)
+        std::vector<double> gamma_buffer;
+        std::vector<double> chipa_buffer;
+        std::vector<double> dNphdt_buffer;
+
 };
 
 #endif
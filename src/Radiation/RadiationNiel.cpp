@@ -50,6 +50,7 @@ void RadiationNiel::operator() (
         Species * photon_species,
         SmileiMPI* smpi,
         RadiationTables &RadiationTables,
+        Random * rand,
         int istart,
         int iend,
         int ithread, int ipart_ref)
@@ -99,7 +100,7 @@ void RadiationNiel::operator() (
     double random_numbers[nbparticles];
 
     // Momentum shortcut
-    double* momentum[3];
+    particle_real* momentum[3];
     for ( int i = 0 ; i<3 ; i++ )
         momentum[i] =  &( particles.momentum(i,istart) );
 
@@ -107,10 +108,10 @@ void RadiationNiel::operator() (
     short* charge = &( particles.charge(istart) );
 
     // Weight shortcut
-    double* weight = &( particles.weight(istart) );
+    particle_real* weight = &( particles.weight(istart) );
 
     // Quantum parameter
-    double * chipa = &( particles.chi(istart));
+    particle_real * chipa = &( particles.chi(istart));
 
     // Reinitialize the cumulative radiated energy for the current thread
     this->radiated_energy = 0.;
@@ -161,19 +162,12 @@ void RadiationNiel::operator() (
     }*/
 
     // Vectorized computation of the random number in a uniform distribution
+    // The numbers are drawn in a batch from the generator of the patch
+    rand->uniform( &random_numbers[0], nbparticles );
     #pragma omp simd
     for (ipart=0 ; ipart < nbparticles; ipart++ )
     {
-
-        // Below chipa = chipa_radiation_threshold, radiation losses are negligible
-        if (chipa[ipart] > chipa_radiation_threshold)
-        {
-
-          // Pick a random number in the normal distribution of standard
-          // deviation sqrt(dt) (variance dt)
-          //random_numbers[ipart] = 2.*Rand::uniform() -1.;
-          random_numbers[ipart] = 2.*drand48() -1.;
-        }
+        random_numbers[ipart] = 2.*random_numbers[ipart] -1.;
     }
 
     // Vectorized computation of the random number in a normal distribution
@@ -219,22 +213,19 @@ void RadiationNiel::operator() (
     //double t2 = MPI_Wtime();
 
     // Computation of the diffusion coefficients
-    // Using the table (non-vectorized)
+    // Using the table (vectorized, direct-index lookup for the whole bin)
     if (h_computation_method == "table")
     {
-        // #pragma omp simd
+        RadiationTables.get_h_Niel_from_table(chipa, diffusion, nbparticles);
+
+        #pragma omp simd
         for (ipart=0 ; ipart < nbparticles; ipart++ )
         {
 
             // Below chipa = chipa_radiation_threshold, radiation losses are negligible
             if (chipa[ipart] > chipa_radiation_threshold)
             {
-
-              //h = RadiationTables.get_h_Niel_from_fit_order10(chipa[ipart]);
-              //h = RadiationTables.get_h_Niel_from_fit_order5(chipa[ipart]);
-              temp = RadiationTables.get_h_Niel_from_table(chipa[ipart]);
-
-              diffusion[ipart] = sqrt(factor_cla_rad_power*gamma[ipart]*temp)*random_numbers[ipart];
+              diffusion[ipart] = sqrt(factor_cla_rad_power*gamma[ipart]*diffusion[ipart])*random_numbers[ipart];
             }
         }
     }
@@ -18,6 +18,7 @@
 #include <cmath>
 
 #include "userFunctions.h"
+#include "TableCache.h"
 
 // -----------------------------------------------------------------------------
 // INITILIZATION AND DESTRUCTION
@@ -134,6 +135,9 @@ void RadiationTables::initParams(Params& params)
             // Path to the databases
             PyTools::extract("table_path", table_path, "RadiationReaction");
 
+            // Path to the cache of the computed tables
+            PyTools::extract("table_cache_path", table_cache_path, "RadiationReaction");
+
             // Radiation threshold on the quantum parameter chipa
             PyTools::extract("chipa_radiation_threshold",
                           chipa_radiation_threshold,"RadiationReaction");
@@ -177,6 +181,10 @@ void RadiationTables::initParams(Params& params)
         params.hasNielRadiation)
     {
         MESSAGE( "        Table path: " << table_path);
+        if (!table_cache_path.empty())
+        {
+            MESSAGE( "        Table cache path: " << table_cache_path);
+        }
     }
     if (params.hasNielRadiation)
     {
@@ -250,6 +258,27 @@ void RadiationTables::compute_h_table(SmileiMPI *smpi)
     // If external tables are available, we read them
     table_exists = RadiationTables::read_h_table(smpi);
 
+    // Else we look for them in the cache
+    TableCache cache(table_cache_path, "radiation_h");
+    cache.key(h_dim);
+    cache.key(h_chipa_min);
+    cache.key(h_chipa_max);
+    if (!table_exists && cache.read(smpi, {&h_table}, {h_dim}))
+    {
+        table_exists = true;
+
+        MESSAGE("            Reading of the cache " << cache.filename());
+        MESSAGE("            Dimension quantum parameter: "
+                             << h_dim);
+
+        // Computation of the delta
+        h_chipa_delta = (log10(h_chipa_max)
+                - h_log10_chipa_min)/(h_dim-1);
+
+        // Inverse delta
+        h_chipa_inv_delta = 1./h_chipa_delta;
+    }
+
     // Else we compute them
     if (!table_exists)
     {
@@ -353,6 +382,9 @@ void RadiationTables::compute_h_table(SmileiMPI *smpi)
         delete imin_table;
         delete length_table;
 
+        // Storage in the cache for the next runs
+        cache.write(smpi, {&h_table});
+
     }
 
     // Final timer
@@ -386,6 +418,27 @@ void RadiationTables::compute_integfochi_table(SmileiMPI *smpi)
     // If external tables are available, we read them
     table_exists = RadiationTables::read_integfochi_table(smpi);
 
+    // Else we look for them in the cache
+    TableCache cache(table_cache_path, "radiation_integfochi");
+    cache.key(integfochi_dim);
+    cache.key(integfochi_chipa_min);
+    cache.key(integfochi_chipa_max);
+    if (!table_exists && cache.read(smpi, {&integfochi_table}, {integfochi_dim}))
+    {
+        table_exists = true;
+
+        MESSAGE("            Reading of the cache " << cache.filename());
+        MESSAGE("            Dimension quantum parameter: "
+                             << integfochi_dim);
+
+        // Computation of the delta
+        integfochi_chipa_delta = (log10(integfochi_chipa_max)
+                - integfochi_log10_chipa_min)/(integfochi_dim-1);
+
+        // Inverse delta
+        integfochi_chipa_inv_delta = 1./integfochi_chipa_delta;
+    }
+
     // Else we compute them
     if (!table_exists)
     {
@@ -475,6 +528,9 @@ void RadiationTables::compute_integfochi_table(SmileiMPI *smpi)
         delete imin_table;
         delete length_table;
 
+        // Storage in the cache for the next runs
+        cache.write(smpi, {&integfochi_table});
+
     }
 
     // Final timer
@@ -511,6 +567,31 @@ void RadiationTables::compute_xip_table(SmileiMPI *smpi)
     // If external tables are available, we read them
     table_exists = RadiationTables::read_xip_table(smpi);
 
+    // Else we look for them in the cache
+    TableCache cache(table_cache_path, "radiation_xip");
+    cache.key(xip_chipa_dim);
+    cache.key(xip_chiph_dim);
+    cache.key(xip_chipa_min);
+    cache.key(xip_chipa_max);
+    cache.key(xip_power);
+    cache.key(xip_threshold);
+    if (!table_exists && cache.read(smpi, {&xip_chiphmin_table, &xip_table},
+                                    {xip_chipa_dim, xip_chipa_dim*xip_chiph_dim}))
+    {
+        table_exists = true;
+
+        MESSAGE("            Reading of the cache " << cache.filename());
+        MESSAGE("            Dimension particle chi: " << xip_chipa_dim);
+        MESSAGE("            Dimension photon chi: " << xip_chiph_dim);
+
+        // Computation of the delta
+        xip_chipa_delta = (log10(xip_chipa_max)
+                - xip_log10_chipa_min)/(xip_chipa_dim-1);
+
+        // Inverse of delta
+        xip_chipa_inv_delta = 1./xip_chipa_delta;
+    }
+
     // Else we compute them
     if (!table_exists)
     {
@@ -724,6 +805,9 @@ void RadiationTables::compute_xip_table(SmileiMPI *smpi)
         delete length_table;
         delete imin_table;
 
+        // Storage in the cache for the next runs
+        cache.write(smpi, {&xip_chiphmin_table, &xip_table});
+
     }
 
     t1 = MPI_Wtime();
@@ -744,11 +828,15 @@ void RadiationTables::compute_tables(Params& params, SmileiMPI *smpi)
     if (params.hasNielRadiation && this->h_computation_method == "table")
     {
         RadiationTables::compute_h_table(smpi);
+        h_lookup.set(&h_table[0], h_dim, h_log10_chipa_min, h_chipa_delta);
     }
     if (params.hasMCRadiation)
     {
         RadiationTables::compute_integfochi_table(smpi);
         RadiationTables::compute_xip_table(smpi);
+        integfochi_lookup.set(&integfochi_table[0], integfochi_dim,
+                              integfochi_log10_chipa_min, integfochi_chipa_delta);
+        xip_guide.build(&xip_table[0], xip_chipa_dim, xip_chiph_dim, xip_chiph_dim);
     }
 }
 
@@ -1185,8 +1273,9 @@ void RadiationTables::output_tables(SmileiMPI *smpi)
 //! ramdomly and using the tables xip and chiphmin
 //
 //! \param chipa particle quantum parameter
+//! \param rand Random number generator of the patch
 // -----------------------------------------------------------------------------
-double RadiationTables::compute_chiph_emission(double chipa)
+double RadiationTables::compute_chiph_emission(double chipa, Random * rand)
 {
     // Log10 of chipa
     double logchipa;
@@ -1226,7 +1315,7 @@ double RadiationTables::compute_chiph_emission(double chipa)
     // ---------------------------------------
 
     // First, we compute a random xip in [0,1[
-    xip = Rand::uniform();
+    xip = rand->uniform();
 
     // If the randomly computed xip if below the first one of the row,
     // we take the first one which corresponds to the minimal photon chiph
@@ -1246,8 +1335,7 @@ double RadiationTables::compute_chiph_emission(double chipa)
     else
     {
         // Search for the corresponding index ichiph for xip
-        ichiph = userFunctions::search_elem_in_array(
-            &xip_table[ichipa*xip_chiph_dim],xip,xip_chiph_dim);
+        ichiph = xip_guide.search(ichipa,xip);
     }
 
     // Corresponding chipa for ichipa
@@ -1298,53 +1386,25 @@ double RadiationTables::compute_chiph_emission(double chipa)
 
 // ---------------------------------------------------------------------------------------------------------------------
 //! Computation of the Cross Section dNph/dt which is also
-//! the number of photons generated per time unit.
+//! the number of photons generated per time unit, for the particles of a bin.
+//! The indices in the table integfochi are computed directly from its
+//! logarithmic spacing, which enables the vectorization.
 //
-//! \param chipa particle quantum parameter
-//! \param gfpa particle gamma factor
+//! \param chipa particle quantum parameters
+//! \param gfpa particle gamma factors
+//! \param dNphdt resulting cross-sections
+//! \param n number of particles
 // ---------------------------------------------------------------------------------------------------------------------
-double RadiationTables::compute_dNphdt(double chipa,double gfpa)
+void RadiationTables::compute_dNphdt(const double * chipa, const double * gfpa,
+                                     double * dNphdt, int n)
 {
+    integfochi_lookup.interpolate(chipa, dNphdt, n);
 
-    // Log of the particle quantum parameter chipa
-    double logchipa;
-    double logchipam;
-    double logchipap;
-    // Index
-    int ichipa;
-    // final value
-    double dNphdt;
-
-    logchipa = log10(chipa);
-
-    // Lower index for interpolation in the table integfochi
-    ichipa = int(floor((logchipa-integfochi_log10_chipa_min)
-                 *integfochi_chipa_inv_delta));
-
-    // If we are not in the table...
-    if (ichipa < 0)
-    {
-        ichipa = 0;
-        dNphdt = integfochi_table[ichipa];
-    }
-    else if (ichipa >= integfochi_dim-1)
+    #pragma omp simd
+    for (int ipart=0 ; ipart < n ; ipart++)
     {
-        ichipa = integfochi_dim-2;
-        dNphdt = integfochi_table[ichipa];
-    }
-    else
-    {
-        // Upper and lower values for linear interpolation
-        logchipam = ichipa*integfochi_chipa_delta + integfochi_log10_chipa_min;
-        logchipap = logchipam + integfochi_chipa_delta;
-
-        // Interpolation
-        dNphdt = (integfochi_table[ichipa+1]*fabs(logchipa-logchipam) +
-                integfochi_table[ichipa]*fabs(logchipap - logchipa))*integfochi_chipa_inv_delta;
+        dNphdt[ipart] *= factor_dNphdt*chipa[ipart]/gfpa[ipart];
     }
-
-    return factor_dNphdt*dNphdt*chipa/gfpa;
-
 }
 
 // ---------------------------------------------------------------------------------------------------------------------
@@ -1512,36 +1572,17 @@ double RadiationTables::compute_h_Niel(double chipa,
 
 }
 
-// -----------------------------------------------------------------------------
-//! Return the value of the function h(chipa) of Niel et al.
-//! from the computed table h_table
-//! \param chipa particle quantum parameter
-// -----------------------------------------------------------------------------
-double RadiationTables::get_h_Niel_from_table(double chipa)
-{
-    int ichipa;
-    double d;
-
-    // Position in the h_table
-    d = (log10(chipa)-h_log10_chipa_min)*h_chipa_inv_delta;
-    ichipa = int(floor(d));
-
-    // distance for interpolation
-    d = d - floor(d);
-
-    // Linear interpolation
-    return h_table[ichipa]*(1.-d) + h_table[ichipa+1]*(d);
-}
-
 // -----------------------------------------------------------------------------
 //! Return the stochastic diffusive component of the pusher
 //! of Niel et al.
 //! \param gamma particle Lorentz factor
 //! \param chipa particle quantum parameter
+//! \param rand Random number generator of the patch
 // -----------------------------------------------------------------------------
 double RadiationTables::get_Niel_stochastic_term(double gamma,
                                                  double chipa,
-                                                 double sqrtdt)
+                                                 double sqrtdt,
+                                                 Random * rand)
 {
     // Get the value of h for the corresponding chipa
     double h,r;
@@ -1550,7 +1591,7 @@ double RadiationTables::get_Niel_stochastic_term(double gamma,
 
     // Pick a random number in the normal distribution of standard
     // deviation sqrt(dt) (variance dt)
-    r = Rand::normal(sqrtdt);
+    r = rand->normal(sqrtdt);
 
     /*std::random_device device;
     std::mt19937 gen(device());
@@ -19,6 +19,8 @@
 
 #include "Params.h"
 #include "H5.h"
+#include "Random.h"
+#include "LogTable.h"
 
 //------------------------------------------------------------------------------
 //! RadiationTables class: holds parameters, tables and functions to compute
@@ -56,7 +58,20 @@ class RadiationTables
                 double eps);
 
         //! Computation of the cross-section dNph/dt
-        double compute_dNphdt(double chipa,double gfpa);
+        //! \param chipa particle quantum parameter
+        //! \param gfpa particle gamma factor
+        double inline compute_dNphdt(double chipa,double gfpa)
+        {
+            return factor_dNphdt*integfochi_lookup.interpolate(chipa)*chipa/gfpa;
+        };
+
+        //! Computation of the cross-section dNph/dt for n particles (batched over a bin)
+        //! \param chipa particle quantum parameters
+        //! \param gfpa particle gamma factors
+        //! \param dNphdt resulting cross-sections
+        //! \param n number of particles
+        void compute_dNphdt(const double * chipa, const double * gfpa,
+                            double * dNphdt, int n);
 
         //! Compute integration of F/chi between
         //! using Gauss-Legendre for a given chie value
@@ -69,7 +84,8 @@ class RadiationTables
         //! Computation of the photon quantum parameter chiph for emission
         //! ramdomly and using the tables xip and chiphmin
         //! \param chipa particle quantum parameter
-        double compute_chiph_emission(double chipa);
+        //! \param rand Random number generator of the patch
+        double compute_chiph_emission(double chipa, Random * rand);
 
         //! Return the value of the function h(chipa) of Niel et al.
         //! Use an integration of Gauss-Legendre
@@ -82,16 +98,32 @@ class RadiationTables
         //! Return the value of the function h(chipa) of Niel et al.
         //! from the computed table h_table
         //! \param chipa particle quantum parameter
-        double get_h_Niel_from_table(double chipa);
+        double inline get_h_Niel_from_table(double chipa)
+        {
+            return h_lookup.interpolate(chipa);
+        };
+
+        //! Return the values of the function h(chipa) of Niel et al.
+        //! from the computed table h_table for n particles (batched over a bin)
+        //! \param chipa particle quantum parameters
+        //! \param h resulting values
+        //! \param n number of particles
+        template<typename T>
+        void get_h_Niel_from_table(const T * chipa, double * h, int n)
+        {
+            h_lookup.interpolate(chipa, h, n);
+        };
 
         //! Return the stochastic diffusive component of the pusher
         //! of Niel et al.
         //! \param gamma particle Lorentz factor
         //! \param chipa particle quantum parameter
         //! \param dt time step
+        //! \param rand Random number generator of the patch
         double get_Niel_stochastic_term(double gamma,
                                         double chipa,
-                                        double dt);
+                                        double dt,
+                                        Random * rand);
 
         //! Computation of the corrected continuous quantum radiated energy
         //! during dt from the quantum parameter chipa using the Ridgers
@@ -286,6 +318,9 @@ class RadiationTables
         //! Path to the tables
         std::string table_path;
 
+        //! Path to the cache of the computed tables (no cache if empty)
+        std::string table_cache_path;
+
         //! Minimum threshold above which the Monte-Carlo algorithm is working
         //! This avoids using the Monte-Carlo algorithm when chipa is too low
         double chipa_disc_min_threshold;
@@ -300,7 +335,7 @@ class RadiationTables
 
         //! Array containing tabulated values of the function h for the
         //! stochastic diffusive operator of Niel et al.
-        std::vector<double > h_table;
+        table_vector h_table;
 
         //! Minimum boundary of the table h
         double h_chipa_min;
@@ -326,6 +361,9 @@ class RadiationTables
         //! Method to be used to get the h values (table, fit5, fit10)
         std::string h_computation_method;
 
+        //! Direct-index lookup in the table h
+        LogTable h_lookup;
+
         // ---------------------------------------------
         // Table integfochi
         // ---------------------------------------------
@@ -335,7 +373,7 @@ class RadiationTables
         //! (which is also the optical depth for the Monte-Carlo process).
         //! This table is the integration of the Synchrotron emissivity
         //! refers to as F over the quantum parameter Chi.
-        std::vector<double > integfochi_table;
+        table_vector integfochi_table;
 
         //! Minimum boundary of the table integfochi_table
         double integfochi_chipa_min;
@@ -358,6 +396,9 @@ class RadiationTables
         //! This variable is true if the table is computed, false if read
         bool integfochi_computed;
 
+        //! Direct-index lookup in the table integfochi
+        LogTable integfochi_lookup;
+
         // ---------------------------------------------
         // Table chiph min for xip table
         // ---------------------------------------------
@@ -365,7 +406,7 @@ class RadiationTables
         //! Table containing the chiph min values
         //! Under this value, photon energy is
         //! considered negligible
-        std::vector<double > xip_chiphmin_table;
+        table_vector xip_chiphmin_table;
 
         // ---------------------------------------------
         // Table xip
@@ -373,7 +414,7 @@ class RadiationTables
 
         //! Table containing the cumulative distribution function \f$P(0 \rightarrow \chi_{\gamma})\f$
         //! that gives gives the probability for a photon emission in the range \f$[0, \chi_{\gamma}]\f$
-        std::vector<double> xip_table;
+        table_vector xip_table;
 
         //! Minimum boundary for chipa in the table xip and xip_chiphmin
         double xip_chipa_min;
@@ -410,6 +451,9 @@ class RadiationTables
         //! This variable is true if the table is computed, false if read
         bool xip_computed;
 
+        //! Guide for the search of the photon quantum parameter in the table xip
+        CDFGuide xip_guide;
+
         // ---------------------------------------------
         // Factors
         // ---------------------------------------------
@@ -137,8 +137,11 @@ int main (int argc, char* argv[])
         checkpoint.restartAll( vecPatches, &smpi, simWindow, params, openPMD);
         vecPatches.sort_all_particles(params);
         
-        // Patch reconfiguration for the adaptive vectorization
-        if( params.has_adaptive_vectorization) {
+        // Cost model and patch reconfiguration for the adaptive vectorization
+        if( params.has_adaptive_vectorization || params.vectorization_mode == "hybrid" ) {
+            vecPatches.calibrate_vectorization( params, &smpi );
+        }
+        if( params.has_adaptive_vectorization ) {
             vecPatches.configuration(params,timers, 0);
         }
 
@@ -220,7 +223,10 @@ int main (int argc, char* argv[])
             vecPatches.solvePoisson( params, &smpi );
         }
 
-        // Patch reconfiguration
+        // Cost model and patch reconfiguration
+        if( params.has_adaptive_vectorization || params.vectorization_mode == "hybrid" ) {
+            vecPatches.calibrate_vectorization( params, &smpi );
+        }
         if( params.has_adaptive_vectorization ) {
             vecPatches.configuration(params,timers, 0);
         }
@@ -171,7 +171,8 @@ void SpeciesMPIbuffers::allocate(unsigned int ndims)
     rrequest.resize(ndims);
 
     partRecv.resize(ndims);
-    partSend.resize(ndims);
+    partSendBuffer.resize(ndims);
+    partRecvBuffer.resize(ndims);
 
     part_index_send.resize(ndims);
     part_index_send_sz.resize(ndims);
@@ -181,7 +182,8 @@ void SpeciesMPIbuffers::allocate(unsigned int ndims)
         srequest[i].resize(2);
         rrequest[i].resize(2);
         partRecv[i].resize(2);
-        partSend[i].resize(2);
+        partSendBuffer[i].resize(2);
+        partRecvBuffer[i].resize(2);
         part_index_send[i].resize(2);
         part_index_send_sz[i].resize(2);
         part_index_recv_sz[i].resize(2);
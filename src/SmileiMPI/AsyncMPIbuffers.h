@@ -40,10 +40,13 @@ public:
 
     void allocate(unsigned int nDim_field) ;
 
-    //! ndim vectors of 2 sent packets of particles (1 per direction) 
-    std::vector< std::vector<Particles > > partRecv;
     //! ndim vectors of 2 received packets of particles (1 per direction) 
-    std::vector< std::vector<Particles > > partSend;
+    std::vector< std::vector<Particles > > partRecv;
+    //! ndim vectors of 2 byte buffers of particles sent to MPI neighbours (1 per direction), see Particles::pack_parts
+    //!   - kept from one exchange to the next to reuse their memory
+    std::vector< std::vector< std::vector<char> > > partSendBuffer;
+    //! ndim vectors of 2 byte buffers of particles received from MPI neighbours (1 per direction)
+    std::vector< std::vector< std::vector<char> > > partRecvBuffer;
 
     //! ndim vectors of 2 vectors of index particles to send (1 per direction) 
     //!   - not sent
@@ -2,6 +2,7 @@
 
 #include <cmath>
 #include <cstring>
+#include <algorithm>
 
 #include <iostream>
 #include <sstream>
@@ -58,6 +59,8 @@ SmileiMPI::SmileiMPI( int* argc, char*** argv )
     SMILEI_COMM_WORLD = MPI_COMM_WORLD;
     MPI_Comm_size( SMILEI_COMM_WORLD, &smilei_sz );
     MPI_Comm_rank( SMILEI_COMM_WORLD, &smilei_rk );
+    MPI_Comm_dup( SMILEI_COMM_WORLD, &SMILEI_COMM_FIELD_EXCHANGES );
+    MPI_Comm_dup( SMILEI_COMM_WORLD, &SMILEI_COMM_PARTICLE_EXCHANGES );
 
 } // END SmileiMPI::SmileiMPI
 
@@ -70,6 +73,8 @@ SmileiMPI::~SmileiMPI()
 {
     delete[]periods_;
 
+    MPI_Comm_free( &SMILEI_COMM_FIELD_EXCHANGES );
+    MPI_Comm_free( &SMILEI_COMM_PARTICLE_EXCHANGES );
     MPI_Finalize();
 
 } // END SmileiMPI::~SmileiMPI
@@ -356,22 +361,18 @@ void SmileiMPI::init_patch_count( Params& params, DomainDecomposition* domain_de
 void SmileiMPI::recompute_patch_count( Params& params, VectorPatch& vecpatches, double time_dual )
 {
 
-    unsigned int ncells_perpatch, j;
-    int Ncur;
-    double Tload,Tload_loc,Tcur, cells_load, target, Tscan, largest_patch_loc, largest_patch;
-    bool recompute_tload = true;
+    unsigned int ncells_perpatch;
+    int npatches_loc = patch_count[smilei_rk], npatches_tot;
+    double Tload, Tload_loc, Tscan, cells_load, largest_patch_loc, largest_patch;
     //Load of a cell = cell_load*load of a particle.
     //Load of a frozen particle = frozen_particle_load*load of a particle.
-    std::vector<double> Lp, Lp_left, Lp_right;
+    std::vector<double> Lp;
     ofstream fout;
 
     if (isMaster()) {
         fout.open ("patch_load.txt", std::ofstream::out | std::ofstream::app);
     }
 
-    MPI_Status status, status0, status1;
-    MPI_Request request0, request1;
-
     ncells_perpatch = params.n_space[0]+2*params.oversize[0]; //Initialization
     for (unsigned int idim = 1; idim < params.nDim_field; idim++)
         ncells_perpatch *= params.n_space[idim]+2*params.oversize[idim];
@@ -379,120 +380,98 @@ void SmileiMPI::recompute_patch_count( Params& params, VectorPatch& vecpatches,
     unsigned int tot_species_number = vecpatches(0)->vecSpecies.size();
     cells_load = ncells_perpatch*params.cell_load ;
 
-    Lp.resize(patch_count[smilei_rk]);
-    if (smilei_rk > 0) Lp_left.resize(patch_count[smilei_rk-1]);
-    if (smilei_rk < smilei_sz-1) Lp_right.resize(patch_count[smilei_rk+1]);
-
-
-
-    while (recompute_tload){
-
-        Tload_loc = 0.;
-        Ncur = 0; // Variation of the number of patches assigned to current rank r.
-        for(unsigned int ipatch=0; ipatch < (unsigned int)patch_count[smilei_rk]; ipatch++)  Lp[ipatch] =  cells_load ;
+    Lp.resize(npatches_loc);
+
+    //Measured load model: smoothed time per timestep spent in each patch since the last balancing
+    int measured = 0;
+    if (params.load_model == "measured") {
+        double Lm_sum = 0.;
+        unsigned int Lm_count = 0;
+        for(int ipatch=0; ipatch < npatches_loc; ipatch++){
+            Patch* patch = vecpatches(ipatch);
+            if (patch->load_timer_steps > 0) {
+                double t = patch->load_timer / patch->load_timer_steps;
+                if (patch->measured_load < 0.)
+                    patch->measured_load = t;
+                else
+                    patch->measured_load = params.load_smoothing*t + (1.-params.load_smoothing)*patch->measured_load;
+            }
+            patch->load_timer = 0.;
+            patch->load_timer_steps = 0;
+            Lp[ipatch] = patch->measured_load;
+            if (patch->measured_load >= 0.) {
+                Lm_sum += patch->measured_load;
+                Lm_count++;
+            }
+        }
+        //Patches received since the last balancing have no measurement yet: give them the average of the rank
+        for(int ipatch=0; ipatch < npatches_loc; ipatch++)
+            if (Lp[ipatch] < 0.) Lp[ipatch] = Lm_count>0 ? Lm_sum/Lm_count : 0.;
+        //Fall back to the particle model until every rank has measured something
+        int measured_loc = Lm_count>0 ? 1 : 0;
+        MPI_Allreduce(&measured_loc, &measured, 1, MPI_INT, MPI_MIN, MPI_COMM_WORLD);
+    }
 
+    if (!measured) {
         //Compute particle contribution to Local Loads of each Patch (Lp)
-        for(unsigned int ipatch=0; ipatch < (unsigned int)patch_count[smilei_rk]; ipatch++){
+        for(int ipatch=0; ipatch < npatches_loc; ipatch++){
+            Lp[ipatch] = cells_load;
             for (unsigned int ispecies = 0; ispecies < tot_species_number; ispecies++) {
                 Lp[ipatch] += vecpatches(ipatch)->vecSpecies[ispecies]->getNbrOfParticles()*(1+(params.frozen_particle_load-1)*(time_dual < vecpatches(ipatch)->vecSpecies[ispecies]->time_frozen)) ;
             }
-            Tload_loc += Lp[ipatch];
-        }
-
-        largest_patch_loc = *max_element(Lp.begin(), Lp.end());
-
-        //Tscan = total load carried by previous ranks and me
-        MPI_Scan(&Tload_loc, &Tscan, 1, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
-        //Tload = total load carried by all ranks
-        MPI_Allreduce(&Tload_loc, &Tload, 1, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
-        //Evaluate largest patch of the simulation
-        MPI_Allreduce(&largest_patch_loc, &largest_patch, 1, MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD);
-
-        Tload /= Tcapabilities; //Target load for each mpi process.
-
-        //This algorithm does not support single patches having a load larger than the target load per MPI rank.
-        //If this happens, the code multiplies the cell load coefficient in order to be able to continue.
-        if (largest_patch >= Tload){
-            params.cell_load *= 2.;
-            cells_load = ncells_perpatch*params.cell_load ;
-            WARNING("Dynamic Load balancing had to increase cell load coefficient because of an overloaded patch with respect to the target load per MPI rank. Try using smaller patches or less MPI ranks.");
-        }else{
-            recompute_tload = false;
         }
     }
 
-    //Communicate the detail of the load of each patch to neighbouring MPI ranks
-    if (smilei_rk < smilei_sz-1) {
-        MPI_Isend( &(Lp[0]), patch_count[smilei_rk], MPI_DOUBLE, smilei_rk+1, 0, MPI_COMM_WORLD, &request0 );
-    }
-    if (smilei_rk > 0) {
-        MPI_Isend( &(Lp[0]), patch_count[smilei_rk], MPI_DOUBLE, smilei_rk-1, 1, MPI_COMM_WORLD, &request1 );
-        MPI_Recv( &(Lp_left[0]), patch_count[smilei_rk-1], MPI_DOUBLE, smilei_rk-1, 0, MPI_COMM_WORLD, &status0 );
-    }
-    if (smilei_rk < smilei_sz-1){
-        MPI_Recv( &(Lp_right[0]), patch_count[smilei_rk+1], MPI_DOUBLE, smilei_rk+1, 1, MPI_COMM_WORLD, &status1);
-    }
-
+    Tload_loc = 0.;
+    for(int ipatch=0; ipatch < npatches_loc; ipatch++) Tload_loc += Lp[ipatch];
+    largest_patch_loc = *max_element(Lp.begin(), Lp.end());
 
-    if (smilei_rk > 0)
-        MPI_Wait(&request1, &status);
-    if (smilei_rk < smilei_sz-1)
-        MPI_Wait(&request0, &status);
-
-    if (smilei_rk > 0){
-        //Tcur is now initialized as the total load currently carried by previous ranks.
-        Tcur = Tscan - Tload_loc;
-        //Check if my rank should start with additional patches from left neighbour.
-        target = smilei_rk*Tload; //target here points at the optimal begining for current rank
-        if (Tcur > target){
-            j = Lp_left.size()-1;
-            while (abs(Tcur-target) > abs(Tcur-Lp_left[j] - target) && j>0){ //Leave at least 1 patch to my neighbour.
-                Tcur -= Lp_left[j];
-                j--;
-                Ncur++;
-            }
-        } else {
-        //  Check if some of my patches should be given to my left neighbour.
-            j = 0;
-            while ( (abs(Tcur-target) > abs(Tcur+Lp[j]-target)) && (j < (unsigned int)patch_count[smilei_rk]-1) ){ //Keep at least 1 patch from my original set of patches
-                Tcur += Lp[j];
-                j++;
-                Ncur --;
-            }
-        }
-    }
+    //Tscan = total load carried by previous ranks and me
+    MPI_Scan(&Tload_loc, &Tscan, 1, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
+    //Tload = total load carried by all ranks
+    MPI_Allreduce(&Tload_loc, &Tload, 1, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
+    //Evaluate largest patch of the simulation
+    MPI_Allreduce(&largest_patch_loc, &largest_patch, 1, MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD);
+    MPI_Allreduce(&npatches_loc, &npatches_tot, 1, MPI_INT, MPI_SUM, MPI_COMM_WORLD);
 
-    if (smilei_rk < smilei_sz-1){
-        //Tcur is now initialized as the total load carried by previous ranks + my load.
-        Tcur = Tscan;
-        target = (smilei_rk+1)*Tload;
-
-        //Check if my rank should start with additional patches from right neighbour ...
-        if (Tcur < target){
-            unsigned int j = 0;
-            while ( (abs(Tcur-target) > abs(Tcur+Lp_right[j] - target)) && (j<(unsigned int)patch_count[smilei_rk+1] - 1) ){ //Leave at least 1 patch to my neighbour
-                Tcur += Lp_right[j];
-                j++;
-                Ncur++;
-            }
+    Tload /= Tcapabilities; //Target load for each mpi process.
 
-        } else {
-        //  Check if some of my patches should be given to my right neighbour.
-            j = patch_count[smilei_rk]-1;
-            while (abs(Tcur-target) > abs(Tcur-Lp[j]-target) && j > 0){ //Keep at least 1 patch from my original set of patches
-                Tcur -= Lp[j];
-                j--;
-                Ncur --;
-            }
-        }
+    //A patch larger than the target load per MPI rank is given a rank of its own
+    if (largest_patch >= Tload)
+        WARNING("Dynamic Load balancing found an overloaded patch with respect to the target load per MPI rank. Try using smaller patches or less MPI ranks.");
+
+    //Cut points on the Hilbert curve: rank r starts where the cumulative load reaches the
+    //cumulative capability of ranks 0..r-1. Each patch goes to the rank whose load interval
+    //contains the middle of the patch, so that all cut points are found in one pass.
+    std::vector<double> Ttarget(smilei_sz+1, 0.);
+    for (int irk=0; irk<smilei_sz; irk++)
+        Ttarget[irk+1] = Ttarget[irk] + Tload*capabilities[irk];
+
+    std::vector<int> new_count_loc(smilei_sz, 0);
+    double Tcur = Tscan - Tload_loc; //Total load carried by previous ranks
+    int irk = upper_bound(Ttarget.begin()+1, Ttarget.end()-1, Tcur) - (Ttarget.begin()+1);
+    for(int ipatch=0; ipatch < npatches_loc; ipatch++){
+        double Tmid = Tcur + 0.5*Lp[ipatch];
+        while ( irk < smilei_sz-1 && Tmid >= Ttarget[irk+1] ) irk++;
+        new_count_loc[irk]++;
+        Tcur += Lp[ipatch];
     }
-
-    //Ncur is the variation of number of patches owned by current rank.
-    //Stores in Ncur the final patch count of this rank
-    Ncur += patch_count[smilei_rk] ;
-
-    //Ncur now has to be gathered to all as target_patch_count[smilei_rk]
-    MPI_Allgather(&Ncur,1,MPI_INT,&patch_count[0], 1, MPI_INT,MPI_COMM_WORLD);
+    MPI_Allreduce(&new_count_loc[0], &patch_count[0], smilei_sz, MPI_INT, MPI_SUM, MPI_COMM_WORLD);
+
+    //Every rank keeps at least one patch: move the cut points just enough
+    std::vector<int> first(smilei_sz+1);
+    first[0] = 0;
+    for (int irk=0; irk<smilei_sz; irk++)
+        first[irk+1] = first[irk] + patch_count[irk];
+    for (int irk=1; irk<smilei_sz; irk++)
+        first[irk] = max( first[irk], first[irk-1]+1 );
+    for (int irk=smilei_sz-1; irk>0; irk--)
+        first[irk] = min( first[irk], first[irk+1]-1 );
+    for (int irk=0; irk<smilei_sz; irk++)
+        patch_count[irk] = first[irk+1] - first[irk];
+
+    if (first[smilei_sz] != npatches_tot)
+        ERROR("Dynamic load balancing lost patches. This should never happen!");
 
     patch_refHindexes[0] = 0;
     for ( int rk=1 ; rk<smilei_sz ; rk++)
@@ -534,15 +513,21 @@ int SmileiMPI::hrank(int h)
 // ----------------------------------------------------------------------
 MPI_Datatype SmileiMPI::createMPIparticles( Particles* particles )
 {
-    int nbrOfProp = particles->double_prop.size() + particles->short_prop.size() + particles->uint64_prop.size();
+    int nbrOfProp = particles->double_prop.size() + particles->float_prop.size() + particles->short_prop.size() + particles->uint64_prop.size();
+    // index of the first property of each type
+    int first_float  = particles->double_prop.size();
+    int first_short  = first_float + particles->float_prop.size();
+    int first_uint64 = first_short + particles->short_prop.size();
 
     MPI_Aint address[nbrOfProp];
     for ( unsigned int iprop=0 ; iprop<particles->double_prop.size() ; iprop++ )
         MPI_Get_address( &( (*(particles->double_prop[iprop]))[0] ), &(address[iprop]) );
+    for ( unsigned int iprop=0 ; iprop<particles->float_prop.size() ; iprop++ )
+        MPI_Get_address( &( (*(particles->float_prop[iprop]))[0] ), &(address[first_float+iprop]) );
     for ( unsigned int iprop=0 ; iprop<particles->short_prop.size() ; iprop++ )
-        MPI_Get_address( &( (*(particles->short_prop[iprop]))[0] ), &(address[particles->double_prop.size()+iprop]) );
+        MPI_Get_address( &( (*(particles->short_prop[iprop]))[0] ), &(address[first_short+iprop]) );
     for ( unsigned int iprop=0 ; iprop<particles->uint64_prop.size() ; iprop++ )
-        MPI_Get_address( &( (*(particles->uint64_prop[iprop]))[0] ), &(address[particles->double_prop.size()+particles->short_prop.size()+iprop]) );
+        MPI_Get_address( &( (*(particles->uint64_prop[iprop]))[0] ), &(address[first_uint64+iprop]) );
 
     int nbr_parts[nbrOfProp];
     // number of elements per property
@@ -559,10 +544,12 @@ MPI_Datatype SmileiMPI::createMPIparticles( Particles* particles )
     // define MPI type of each property, default is DOUBLE
     for ( unsigned int i=0 ; i<particles->double_prop.size() ; i++)
         partDataType[i] = MPI_DOUBLE;
+    for ( unsigned int iprop=0 ; iprop<particles->float_prop.size() ; iprop++ )
+        partDataType[ first_float+iprop] = MPI_FLOAT;
     for ( unsigned int iprop=0 ; iprop<particles->short_prop.size() ; iprop++ )
-        partDataType[ particles->double_prop.size()+iprop] = MPI_SHORT;
+        partDataType[ first_short+iprop] = MPI_SHORT;
     for ( unsigned int iprop=0 ; iprop<particles->uint64_prop.size() ; iprop++ )
-        partDataType[ particles->double_prop.size()+particles->short_prop.size()+iprop] = MPI_UNSIGNED_LONG_LONG;
+        partDataType[ first_uint64+iprop] = MPI_UNSIGNED_LONG_LONG;
 
     MPI_Datatype typeParticlesMPI;
     MPI_Type_create_struct( nbrOfProp, &(nbr_parts[0]), &(disp[0]), &(partDataType[0]), &typeParticlesMPI);
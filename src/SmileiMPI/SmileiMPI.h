@@ -137,6 +137,18 @@ public:
         return SMILEI_COMM_WORLD;
     }
 
+    //! Return the communicator of the aggregated field exchanges
+    inline MPI_Comm getFieldExchangeComm()
+    {
+        return SMILEI_COMM_FIELD_EXCHANGES;
+    }
+
+    //! Return the communicator of the particle exchanges between patches
+    inline MPI_Comm getParticleExchangeComm()
+    {
+        return SMILEI_COMM_PARTICLE_EXCHANGES;
+    }
+
     //! Return MPI_Comm_size
     inline int getOMPMaxThreads() {
         return smilei_omp_max_threads;
@@ -199,6 +211,12 @@ public:
 protected:
     //! Global MPI Communicator
     MPI_Comm SMILEI_COMM_WORLD;
+    //! Duplicate of SMILEI_COMM_WORLD for the aggregated field exchanges (see AggregatedExchange),
+    //! which cannot be mistaken for the per-patch messages
+    MPI_Comm SMILEI_COMM_FIELD_EXCHANGES;
+    //! Duplicate of SMILEI_COMM_WORLD for the particle exchanges: their size is only known when probed
+    //! (see Patch::finalizeExchParticles), so that no other message may share their tags
+    MPI_Comm SMILEI_COMM_PARTICLE_EXCHANGES;
 
     //! Number of MPI process in the current communicator
     int smilei_sz;
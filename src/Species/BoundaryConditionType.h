@@ -14,6 +14,7 @@
 #include "Params.h"
 #include "tabulatedFunctions.h"
 #include "userFunctions.h"
+#include "Random.h"
 
 //!
 //! int function( Particles &particles, int ipart, int direction, double limit_pos )
@@ -137,13 +138,13 @@ inline int thermalize_particle( Particles &particles, int ipart, int direction,
                 // change of velocity in the direction normal to the reflection plane
                 double sign_vel = -particles.momentum(i,ipart)/std::abs(particles.momentum(i,ipart));
                 particles.momentum(i,ipart) = sign_vel * species->thermalMomentum[i]
-                *                             std::sqrt( -std::log(1.0-Rand::uniform1()) );
+                *                             std::sqrt( -std::log(1.0-species->rand_->uniform()) );
 
             } else {
                 // change of momentum in the direction(s) along the reflection plane
-                double sign_rnd = Rand::uniform() - 0.5; sign_rnd = (sign_rnd)/std::abs(sign_rnd);
+                double sign_rnd = species->rand_->uniform() - 0.5; sign_rnd = (sign_rnd)/std::abs(sign_rnd);
                 particles.momentum(i,ipart) = sign_rnd * species->thermalMomentum[i]
-                *                             userFunctions::erfinv( Rand::uniform1() );
+                *                             userFunctions::erfinv( species->rand_->uniform() );
             }//if
 
         }//i
@@ -1,5 +1,6 @@
 #include "Particles.h"
 
+#include <algorithm>
 #include <cstring>
 #include <iostream>
 
@@ -23,10 +24,12 @@ tracked(false)
     Position_old.resize(0);
     Momentum.resize(0);
     is_test = false;
+    tile_size = 1;
     isQuantumParameter = false;
     isMonteCarlo = false;
 
     double_prop.resize(0);
+    float_prop.resize(0);
     short_prop.resize(0);
     uint64_prop.resize(0);
 }
@@ -56,9 +59,9 @@ void Particles::initialize(unsigned int nParticles, unsigned int nDim)
             double_prop.push_back( &(Position[i]) );
 
         for (unsigned int i=0 ; i< 3 ; i++)
-            double_prop.push_back( &(Momentum[i]) );
+            add_prop( &(Momentum[i]) );
 
-        double_prop.push_back( &Weight );
+        add_prop( &Weight );
 
 #ifdef  __DEBUG
         Position_old.resize(nDim);
@@ -75,7 +78,7 @@ void Particles::initialize(unsigned int nParticles, unsigned int nDim)
         // - if radiation reaction (continuous or discontinuous)
         // - if multiphoton-Breit-Wheeler if photons
         if (isQuantumParameter) {
-            double_prop.push_back( &Chi );
+            add_prop( &Chi );
         }
 
         // Optical Depth for Monte-Carlo processes:
@@ -83,7 +86,7 @@ void Particles::initialize(unsigned int nParticles, unsigned int nDim)
         // are activated, tau is the incremental optical depth to emission
         if (isMonteCarlo)
         {
-            double_prop.push_back( &Tau );
+            add_prop( &Tau );
         }
 
     }
@@ -96,6 +99,8 @@ void Particles::initialize(unsigned int nParticles, unsigned int nDim)
 void Particles::initialize(unsigned int nParticles, Particles &part)
 {
     is_test=part.is_test;
+
+    tile_size=part.tile_size;
     
     tracked=part.tracked;
 
@@ -141,6 +146,11 @@ void Particles::reserve( unsigned int n_part_max, unsigned int nDim )
 
 void Particles::resize( unsigned int nParticles, unsigned int nDim )
 {
+    if (tile_size > 1) {
+        Position.resize(nDim);
+        pad_to_tiles( nParticles );
+    }
+
     Position.resize(nDim);
     for (unsigned int i=0 ; i<nDim ; i++)
         Position[i].resize(nParticles, 0.);
@@ -173,17 +183,56 @@ void Particles::resize( unsigned int nParticles, unsigned int nDim )
 
 }
 
+// ---------------------------------------------------------------------------------------------------------------------
+// Round the capacity of all property arrays up to a whole number of SIMD tiles
+// The arrays being aligned, every tile starts on a cache line and the last one can be processed entirely
+// ---------------------------------------------------------------------------------------------------------------------
+void Particles::pad_to_tiles( unsigned int nParticles )
+{
+    if (nParticles <= Weight.capacity()) return;
+
+    // Grow geometrically, as std::vector would, but by whole tiles
+    unsigned int n_part_max = std::max( nParticles, 2*(unsigned int)Weight.capacity() );
+    n_part_max = ( (n_part_max + tile_size - 1) / tile_size ) * tile_size;
+
+    for (unsigned int i=0 ; i<Position.size() ; i++)
+        Position[i].reserve(n_part_max);
+#ifdef  __DEBUG
+    for (unsigned int i=0 ; i<Position_old.size() ; i++)
+        Position_old[i].reserve(n_part_max);
+#endif
+    Momentum.resize(3);
+    for (unsigned int i=0 ; i< 3 ; i++)
+        Momentum[i].reserve(n_part_max);
+    Weight.reserve(n_part_max);
+    Charge.reserve(n_part_max);
+
+    if (tracked)
+        Id.reserve(n_part_max);
+
+    if (isQuantumParameter)
+        Chi.reserve(n_part_max);
+
+    if (isMonteCarlo)
+        Tau.reserve(n_part_max);
+
+    cell_keys.reserve(n_part_max);
+}
+
 void Particles::shrink_to_fit( unsigned int nDim )
 {
 
     for ( unsigned int iprop=0 ; iprop<double_prop.size() ; iprop++ )
-        std::vector<double>( *double_prop[iprop] ).swap( *double_prop[iprop] );
+        particle_property<double>( *double_prop[iprop] ).swap( *double_prop[iprop] );
+
+    for ( unsigned int iprop=0 ; iprop<float_prop.size() ; iprop++ )
+        particle_property<float>( *float_prop[iprop] ).swap( *float_prop[iprop] );
 
     for ( unsigned int iprop=0 ; iprop<short_prop.size() ; iprop++ )
-        std::vector<short>( *short_prop[iprop] ).swap( *short_prop[iprop] );
+        particle_property<short>( *short_prop[iprop] ).swap( *short_prop[iprop] );
 
     for ( unsigned int iprop=0 ; iprop<uint64_prop.size() ; iprop++ )
-        std::vector<uint64_t>( *uint64_prop[iprop] ).swap( *uint64_prop[iprop] );
+        particle_property<uint64_t>( *uint64_prop[iprop] ).swap( *uint64_prop[iprop] );
 }
 
 
@@ -195,6 +244,9 @@ void Particles::clear()
     for ( unsigned int iprop=0 ; iprop<double_prop.size() ; iprop++ )
         double_prop[iprop]->clear();
 
+    for ( unsigned int iprop=0 ; iprop<float_prop.size() ; iprop++ )
+        float_prop[iprop]->clear();
+
     for ( unsigned int iprop=0 ; iprop<short_prop.size() ; iprop++ )
         short_prop[iprop]->clear();
 
@@ -208,6 +260,9 @@ void Particles::cp_particle(unsigned int ipart )
     for ( unsigned int iprop=0 ; iprop<double_prop.size() ; iprop++ )
         double_prop[iprop]->push_back( (*double_prop[iprop])[ipart] );
 
+    for ( unsigned int iprop=0 ; iprop<float_prop.size() ; iprop++ )
+        float_prop[iprop]->push_back( (*float_prop[iprop])[ipart] );
+
     for ( unsigned int iprop=0 ; iprop<short_prop.size() ; iprop++ )
         short_prop[iprop]->push_back( (*short_prop[iprop])[ipart] );
 
@@ -224,6 +279,9 @@ void Particles::cp_particle(unsigned int ipart, Particles &dest_parts )
     for ( unsigned int iprop=0 ; iprop<double_prop.size() ; iprop++ )
         dest_parts.double_prop[iprop]->push_back( (*double_prop[iprop])[ipart] );
 
+    for ( unsigned int iprop=0 ; iprop<float_prop.size() ; iprop++ )
+        dest_parts.float_prop[iprop]->push_back( (*float_prop[iprop])[ipart] );
+
     for ( unsigned int iprop=0 ; iprop<short_prop.size() ; iprop++ )
         dest_parts.short_prop[iprop]->push_back( (*short_prop[iprop])[ipart] );
 
@@ -239,6 +297,9 @@ void Particles::cp_particle(unsigned int ipart, Particles &dest_parts, int dest_
     for ( unsigned int iprop=0 ; iprop<double_prop.size() ; iprop++ )
         dest_parts.double_prop[iprop]->insert( dest_parts.double_prop[iprop]->begin() + dest_id, (*double_prop[iprop])[ipart] );
 
+    for ( unsigned int iprop=0 ; iprop<float_prop.size() ; iprop++ )
+        dest_parts.float_prop[iprop]->insert( dest_parts.float_prop[iprop]->begin() + dest_id, (*float_prop[iprop])[ipart] );
+
     for ( unsigned int iprop=0 ; iprop<short_prop.size() ; iprop++ )
         dest_parts.short_prop[iprop]->insert( dest_parts.short_prop[iprop]->begin() + dest_id, (*short_prop[iprop])[ipart] );
 
@@ -255,6 +316,9 @@ void Particles::cp_particles(unsigned int iPart, unsigned int nPart, Particles &
     for ( unsigned int iprop=0 ; iprop<double_prop.size() ; iprop++ )
         dest_parts.double_prop[iprop]->insert( dest_parts.double_prop[iprop]->begin() + dest_id, double_prop[iprop]->begin()+iPart, double_prop[iprop]->begin()+iPart+nPart );
 
+    for ( unsigned int iprop=0 ; iprop<float_prop.size() ; iprop++ )
+        dest_parts.float_prop[iprop]->insert( dest_parts.float_prop[iprop]->begin() + dest_id, float_prop[iprop]->begin()+iPart, float_prop[iprop]->begin()+iPart+nPart );
+
     for ( unsigned int iprop=0 ; iprop<short_prop.size() ; iprop++ )
         dest_parts.short_prop[iprop]->insert( dest_parts.short_prop[iprop]->begin() + dest_id, short_prop[iprop]->begin()+iPart, short_prop[iprop]->begin()+iPart+nPart );
 
@@ -271,6 +335,9 @@ void Particles::erase_particle(unsigned int ipart )
     for ( unsigned int iprop=0 ; iprop<double_prop.size() ; iprop++ )
         (*double_prop[iprop]).erase( (*double_prop[iprop]).begin()+ipart );
 
+    for ( unsigned int iprop=0 ; iprop<float_prop.size() ; iprop++ )
+        (*float_prop[iprop]).erase( (*float_prop[iprop]).begin()+ipart );
+
     for ( unsigned int iprop=0 ; iprop<short_prop.size() ; iprop++ )
         (*short_prop[iprop]).erase( (*short_prop[iprop]).begin()+ipart );
 
@@ -287,6 +354,9 @@ void Particles::erase_particle_trail(unsigned int ipart)
     for ( unsigned int iprop=0 ; iprop<double_prop.size() ; iprop++ )
         (*double_prop[iprop]).erase( (*double_prop[iprop]).begin()+ipart, (*double_prop[iprop]).end() );
 
+    for ( unsigned int iprop=0 ; iprop<float_prop.size() ; iprop++ )
+        (*float_prop[iprop]).erase( (*float_prop[iprop]).begin()+ipart, (*float_prop[iprop]).end() );
+
     for ( unsigned int iprop=0 ; iprop<short_prop.size() ; iprop++ )
         (*short_prop[iprop]).erase( (*short_prop[iprop]).begin()+ipart, (*short_prop[iprop]).end() );
 
@@ -302,6 +372,9 @@ void Particles::erase_particle(unsigned int ipart, unsigned int npart)
     for ( unsigned int iprop=0 ; iprop<double_prop.size() ; iprop++ )
         (*double_prop[iprop]).erase( (*double_prop[iprop]).begin()+ipart, (*double_prop[iprop]).begin()+ipart+npart );
 
+    for ( unsigned int iprop=0 ; iprop<float_prop.size() ; iprop++ )
+        (*float_prop[iprop]).erase( (*float_prop[iprop]).begin()+ipart, (*float_prop[iprop]).begin()+ipart+npart );
+
     for ( unsigned int iprop=0 ; iprop<short_prop.size() ; iprop++ )
         (*short_prop[iprop]).erase( (*short_prop[iprop]).begin()+ipart, (*short_prop[iprop]).begin()+ipart+npart );
 
@@ -371,6 +444,9 @@ void Particles::swap_part(unsigned int part1, unsigned int part2)
     for ( unsigned int iprop=0 ; iprop<double_prop.size() ; iprop++ )
         std::swap( (*double_prop[iprop])[part1], (*double_prop[iprop])[part2] );
 
+    for ( unsigned int iprop=0 ; iprop<float_prop.size() ; iprop++ )
+        std::swap( (*float_prop[iprop])[part1], (*float_prop[iprop])[part2] );
+
     for ( unsigned int iprop=0 ; iprop<short_prop.size() ; iprop++ )
         std::swap( (*short_prop[iprop])[part1], (*short_prop[iprop])[part2] );
 
@@ -390,6 +466,14 @@ void Particles::swap_part3(unsigned int part1, unsigned int part2, unsigned int
         (*double_prop[iprop])[part2] = temp;
     }
 
+    float ftemp;
+    for ( unsigned int iprop=0 ; iprop<float_prop.size() ; iprop++ ) {
+        ftemp = (*float_prop[iprop])[part1];
+        (*float_prop[iprop])[part1] = (*float_prop[iprop])[part3];
+        (*float_prop[iprop])[part3] = (*float_prop[iprop])[part2];
+        (*float_prop[iprop])[part2] = ftemp;
+    }
+
     short stemp;
     for ( unsigned int iprop=0 ; iprop<short_prop.size() ; iprop++ ) {
         stemp = (*short_prop[iprop])[part1];
@@ -421,6 +505,15 @@ void Particles::swap_part4(unsigned int part1, unsigned int part2, unsigned int
         (*double_prop[iprop])[part2] = temp;
     }
 
+    float ftemp;
+    for ( unsigned int iprop=0 ; iprop<float_prop.size() ; iprop++ ) {
+        ftemp = (*float_prop[iprop])[part1];
+        (*float_prop[iprop])[part1] = (*float_prop[iprop])[part4];
+        (*float_prop[iprop])[part4] = (*float_prop[iprop])[part3];
+        (*float_prop[iprop])[part3] = (*float_prop[iprop])[part2];
+        (*float_prop[iprop])[part2] = ftemp;
+    }
+
     short stemp;
     for ( unsigned int iprop=0 ; iprop<short_prop.size() ; iprop++ ) {
         stemp = (*short_prop[iprop])[part1];
@@ -472,6 +565,9 @@ void Particles::overwrite_part(unsigned int part1, unsigned int part2)
     for ( unsigned int iprop=0 ; iprop<double_prop.size() ; iprop++ )
         (*double_prop[iprop])[part2] = (*double_prop[iprop])[part1];
 
+    for ( unsigned int iprop=0 ; iprop<float_prop.size() ; iprop++ )
+        (*float_prop[iprop])[part2] = (*float_prop[iprop])[part1];
+
     for ( unsigned int iprop=0 ; iprop<short_prop.size() ; iprop++ )
         (*short_prop[iprop])[part2] = (*short_prop[iprop])[part1];
 
@@ -486,12 +582,16 @@ void Particles::overwrite_part(unsigned int part1, unsigned int part2)
 void Particles::overwrite_part(unsigned int part1, unsigned int part2, unsigned int N)
 {
     unsigned int sizepart = N*sizeof(Position[0][0]);
+    unsigned int sizefloat = N*sizeof(float);
     unsigned int sizecharge = N*sizeof(Charge[0]);
     unsigned int sizeid = N*sizeof(Id[0]);
 
     for ( unsigned int iprop=0 ; iprop<double_prop.size() ; iprop++ )
         memcpy(& (*double_prop[iprop])[part2],  &(*double_prop[iprop])[part1], sizepart);
 
+    for ( unsigned int iprop=0 ; iprop<float_prop.size() ; iprop++ )
+        memcpy(& (*float_prop[iprop])[part2],  &(*float_prop[iprop])[part1], sizefloat);
+
     for ( unsigned int iprop=0 ; iprop<short_prop.size() ; iprop++ )
         memcpy(& (*short_prop[iprop])[part2] ,  &(*short_prop[iprop])[part1] , sizecharge);
 
@@ -507,6 +607,9 @@ void Particles::overwrite_part(unsigned int part1, Particles &dest_parts, unsign
     for ( unsigned int iprop=0 ; iprop<double_prop.size() ; iprop++ )
         (*dest_parts.double_prop[iprop])[part2] = (*double_prop[iprop])[part1];
 
+    for ( unsigned int iprop=0 ; iprop<float_prop.size() ; iprop++ )
+        (*dest_parts.float_prop[iprop])[part2] = (*float_prop[iprop])[part1];
+
     for ( unsigned int iprop=0 ; iprop<short_prop.size() ; iprop++ )
         (*dest_parts.short_prop[iprop])[part2] = (*short_prop[iprop])[part1];
 
@@ -520,12 +623,16 @@ void Particles::overwrite_part(unsigned int part1, Particles &dest_parts, unsign
 void Particles::overwrite_part(unsigned int part1, Particles &dest_parts, unsigned int part2, unsigned int N)
 {
     unsigned int sizepart = N*sizeof(Position[0][0]);
+    unsigned int sizefloat = N*sizeof(float);
     unsigned int sizecharge = N*sizeof(Charge[0]);
     unsigned int sizeid = N*sizeof(Id[0]);
 
     for ( unsigned int iprop=0 ; iprop<double_prop.size() ; iprop++ )
         memcpy(& (*dest_parts.double_prop[iprop])[part2],  &(*double_prop[iprop])[part1], sizepart);
 
+    for ( unsigned int iprop=0 ; iprop<float_prop.size() ; iprop++ )
+        memcpy(& (*dest_parts.float_prop[iprop])[part2],  &(*float_prop[iprop])[part1], sizefloat);
+
     for ( unsigned int iprop=0 ; iprop<short_prop.size() ; iprop++ )
         memcpy(& (*dest_parts.short_prop[iprop])[part2] ,  &(*short_prop[iprop])[part1] , sizecharge);
 
@@ -535,6 +642,106 @@ void Particles::overwrite_part(unsigned int part1, Particles &dest_parts, unsign
 }
 
 
+// ---------------------------------------------------------------------------------------------------------------------
+// Copy one property of particles iPart->iPart+nPart into dest at the positions given by dest_index
+// ---------------------------------------------------------------------------------------------------------------------
+template<typename T>
+static inline void scatter_property( const particle_property<T> &src, unsigned int iPart, unsigned int nPart, const int* dest_index, particle_property<T> &dest )
+{
+    const T* s = &src[iPart];
+    T* d = dest.data();
+    for ( unsigned int ip=0 ; ip<nPart ; ip++ ) {
+        if ( dest_index[ip] >= 0 )
+            d[ dest_index[ip] ] = s[ip];
+    }
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Copy particles iPart->iPart+nPart into dest_parts, particle iPart+i going to dest_index[i]
+// Particles with a negative dest_index are not copied. dest_parts must already have the required size.
+// ---------------------------------------------------------------------------------------------------------------------
+void Particles::scatter_parts(unsigned int iPart, unsigned int nPart, const int* dest_index, Particles &dest_parts)
+{
+    if ( nPart == 0 ) return;
+
+    for ( unsigned int iprop=0 ; iprop<double_prop.size() ; iprop++ )
+        scatter_property( *double_prop[iprop], iPart, nPart, dest_index, *dest_parts.double_prop[iprop] );
+
+    for ( unsigned int iprop=0 ; iprop<float_prop.size() ; iprop++ )
+        scatter_property( *float_prop[iprop], iPart, nPart, dest_index, *dest_parts.float_prop[iprop] );
+
+    for ( unsigned int iprop=0 ; iprop<short_prop.size() ; iprop++ )
+        scatter_property( *short_prop[iprop], iPart, nPart, dest_index, *dest_parts.short_prop[iprop] );
+
+    for ( unsigned int iprop=0 ; iprop<uint64_prop.size() ; iprop++ )
+        scatter_property( *uint64_prop[iprop], iPart, nPart, dest_index, *dest_parts.uint64_prop[iprop] );
+}
+
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Size in bytes of one particle in the buffers of pack_parts / unpack_parts
+// ---------------------------------------------------------------------------------------------------------------------
+unsigned int Particles::packed_size() const
+{
+    return double_prop.size()*sizeof(double) + float_prop.size()*sizeof(float)
+        +  short_prop.size()*sizeof(short)   + uint64_prop.size()*sizeof(uint64_t);
+}
+
+template<typename T>
+static inline char* pack_property( const particle_property<T> &src, const int* index, unsigned int nPart, char* buffer )
+{
+    T* b = reinterpret_cast<T*>( buffer );
+    for ( unsigned int ip=0 ; ip<nPart ; ip++ )
+        b[ip] = src[ index[ip] ];
+    return buffer + nPart*sizeof(T);
+}
+
+template<typename T>
+static inline const char* unpack_property( const char* buffer, unsigned int nPart, particle_property<T> &dest )
+{
+    memcpy( dest.data(), buffer, nPart*sizeof(T) );
+    return buffer + nPart*sizeof(T);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Copy the particles index[0]->index[nPart-1] into buffer (resized to nPart*packed_size() bytes), property by property
+// The properties are stored in the order of double_prop, float_prop, short_prop and uint64_prop: each property is
+// a contiguous array, aligned as long as the previous ones are made of 8-byte types.
+// ---------------------------------------------------------------------------------------------------------------------
+void Particles::pack_parts(const int* index, unsigned int nPart, std::vector<char> &buffer)
+{
+    buffer.resize( nPart*packed_size() );
+    if ( nPart == 0 ) return;
+
+    char* b = buffer.data();
+    for ( unsigned int iprop=0 ; iprop<double_prop.size() ; iprop++ )
+        b = pack_property( *double_prop[iprop], index, nPart, b );
+    for ( unsigned int iprop=0 ; iprop<uint64_prop.size() ; iprop++ )
+        b = pack_property( *uint64_prop[iprop], index, nPart, b );
+    for ( unsigned int iprop=0 ; iprop<float_prop.size() ; iprop++ )
+        b = pack_property( *float_prop[iprop], index, nPart, b );
+    for ( unsigned int iprop=0 ; iprop<short_prop.size() ; iprop++ )
+        b = pack_property( *short_prop[iprop], index, nPart, b );
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Overwrite particles 0->nPart-1 with the nPart particles stored in buffer by pack_parts
+// ---------------------------------------------------------------------------------------------------------------------
+void Particles::unpack_parts(const char* buffer, unsigned int nPart)
+{
+    if ( nPart == 0 ) return;
+
+    for ( unsigned int iprop=0 ; iprop<double_prop.size() ; iprop++ )
+        buffer = unpack_property( buffer, nPart, *double_prop[iprop] );
+    for ( unsigned int iprop=0 ; iprop<uint64_prop.size() ; iprop++ )
+        buffer = unpack_property( buffer, nPart, *uint64_prop[iprop] );
+    for ( unsigned int iprop=0 ; iprop<float_prop.size() ; iprop++ )
+        buffer = unpack_property( buffer, nPart, *float_prop[iprop] );
+    for ( unsigned int iprop=0 ; iprop<short_prop.size() ; iprop++ )
+        buffer = unpack_property( buffer, nPart, *short_prop[iprop] );
+}
+
+
 // ---------------------------------------------------------------------------------------------------------------------
 // Exchange N particles part1->part1+N & part2->part2+N memory location
 // ---------------------------------------------------------------------------------------------------------------------
@@ -543,6 +750,7 @@ void Particles::swap_part(unsigned int part1, unsigned int part2, unsigned int N
     double* buffer[N];
 
     unsigned int sizepart = N*sizeof(Position[0][0]);
+    unsigned int sizefloat = N*sizeof(float);
     unsigned int sizecharge = N*sizeof(Charge[0]);
     unsigned int sizeid = N*sizeof(Id[0]);
 
@@ -552,6 +760,12 @@ void Particles::swap_part(unsigned int part1, unsigned int part2, unsigned int N
         memcpy(&((*double_prop[iprop])[part2]), buffer, sizepart);
     }
 
+    for ( unsigned int iprop=0 ; iprop<float_prop.size() ; iprop++ ) {
+        memcpy(buffer,&((*float_prop[iprop])[part1]), sizefloat);
+        memcpy(&((*float_prop[iprop])[part1]), &((*float_prop[iprop])[part2]), sizefloat);
+        memcpy(&((*float_prop[iprop])[part2]), buffer, sizefloat);
+    }
+
     for ( unsigned int iprop=0 ; iprop<short_prop.size() ; iprop++ ) {
         memcpy(buffer,&((*short_prop[iprop])[part1]), sizecharge);
         memcpy(&((*short_prop[iprop])[part1]), &((*short_prop[iprop])[part2]), sizecharge);
@@ -582,6 +796,9 @@ void Particles::create_particle()
     for ( unsigned int iprop=0 ; iprop<double_prop.size() ; iprop++ )
         (*double_prop[iprop]).push_back(0.);
 
+    for ( unsigned int iprop=0 ; iprop<float_prop.size() ; iprop++ )
+        (*float_prop[iprop]).push_back(0.);
+
     for ( unsigned int iprop=0 ; iprop<short_prop.size() ; iprop++ )
         (*short_prop[iprop]).push_back(0);
 
@@ -596,9 +813,15 @@ void Particles::create_particle()
 void Particles::create_particles(int nAdditionalParticles )
 {
     int nParticles = size();
+    if (tile_size > 1)
+        pad_to_tiles( nParticles+nAdditionalParticles );
+
     for ( unsigned int iprop=0 ; iprop<double_prop.size() ; iprop++ )
         (*double_prop[iprop]).resize(nParticles+nAdditionalParticles,0.);
 
+    for ( unsigned int iprop=0 ; iprop<float_prop.size() ; iprop++ )
+        (*float_prop[iprop]).resize(nParticles+nAdditionalParticles,0.);
+
     for ( unsigned int iprop=0 ; iprop<short_prop.size() ; iprop++ )
         (*short_prop[iprop]).resize(nParticles+nAdditionalParticles,0);
 
@@ -9,6 +9,7 @@
 
 #include "Tools.h"
 #include "TimeSelection.h"
+#include "AlignedAllocator.h"
 
 class Particle;
 
@@ -17,6 +18,18 @@ class Patch;
 
 
 
+//! Array storing one property of all particles, aligned for the vectorized operators
+template<typename T>
+using particle_property = std::vector<T, AlignedAllocator<T> >;
+
+//! Floating-point type of the momentum, weight, chi and tau of the particles:
+//! single precision in the compact build (make config=compact_particles)
+#ifdef __COMPACT_PARTICLES
+typedef float  particle_real;
+#else
+typedef double particle_real;
+#endif
+
 //----------------------------------------------------------------------------------------------------------------------
 //! Particle class: holds the basic properties of a particle
 //----------------------------------------------------------------------------------------------------------------------
@@ -108,6 +121,16 @@ public:
     //! Overwrite particle part1 into part2 of dest_parts memory location. Erasing part2
     void overwrite_part(unsigned int part1, Particles &dest_parts, unsigned int part2);
 
+    //! Copy particles iPart->iPart+nPart into dest_parts, particle iPart+i going to dest_index[i] (skipped if negative)
+    void scatter_parts(unsigned int iPart, unsigned int nPart, const int* dest_index, Particles &dest_parts);
+
+    //! Size in bytes of one particle packed by pack_parts
+    unsigned int packed_size() const;
+    //! Copy particles index[0]->index[nPart-1] into a contiguous byte buffer, property by property
+    void pack_parts(const int* index, unsigned int nPart, std::vector<char> &buffer);
+    //! Overwrite particles 0->nPart-1 with the particles of a buffer filled by pack_parts
+    void unpack_parts(const char* buffer, unsigned int nPart);
+
 
     //! Move iPart at the end of vectors
     void push_to_end(unsigned int iPart );
@@ -145,33 +168,33 @@ public:
     }
 
     //! Method used to get the list of Particle position
-    inline std::vector<double>  position(unsigned int idim) const {
+    inline particle_property<double>  position(unsigned int idim) const {
         return Position[idim];
     }
 
     //! Method used to get the Particle momentum
-    inline double  momentum( unsigned int idim, unsigned int ipart ) const {
+    inline particle_real  momentum( unsigned int idim, unsigned int ipart ) const {
         return Momentum[idim][ipart];
     }
     //! Method used to set a new value to the Particle momentum
-    inline double& momentum( unsigned int idim, unsigned int ipart )       {
+    inline particle_real& momentum( unsigned int idim, unsigned int ipart )       {
         return Momentum[idim][ipart];
     }
       //! Method used to get the Particle momentum
-    inline std::vector<double>  momentum( unsigned int idim ) const {
+    inline particle_property<particle_real>  momentum( unsigned int idim ) const {
         return Momentum[idim];
     }
 
     //! Method used to get the Particle weight
-    inline double  weight(unsigned int ipart) const {
+    inline particle_real  weight(unsigned int ipart) const {
         return Weight[ipart];
     }
     //! Method used to set a new value to the Particle weight
-    inline double& weight(unsigned int ipart)       {
+    inline particle_real& weight(unsigned int ipart)       {
         return Weight[ipart];
     }
     //! Method used to get the Particle weight
-    inline std::vector<double>  weight() const {
+    inline particle_property<particle_real>  weight() const {
         return Weight;
     }
 
@@ -184,7 +207,7 @@ public:
         return Charge[ipart];
     }
     //! Method used to get the list of Particle charges
-    inline std::vector<short>  charge() const {
+    inline particle_property<short>  charge() const {
         return Charge;
     }
 
@@ -204,40 +227,44 @@ public:
         return sqrt(pow(momentum(0,ipart),2)+pow(momentum(1,ipart),2)+pow(momentum(2,ipart),2));
     }
 
-    //! Partiles properties, respect type order : all double, all short, all unsigned int
+    //! Partiles properties, respect type order : all double, all float, all short, all unsigned int
 
     //! array containing the particle position
-    std::vector< std::vector<double> > Position;
+    std::vector< particle_property<double> > Position;
 
     //! array containing the particle former (old) positions
-    std::vector< std::vector<double> >Position_old;
+    std::vector< particle_property<double> >Position_old;
 
     //! array containing the particle moments
-    std::vector< std::vector<double> >  Momentum;
+    std::vector< particle_property<particle_real> >  Momentum;
 
     //! containing the particle weight: equivalent to a charge density
-    std::vector<double> Weight;
+    particle_property<particle_real> Weight;
 
     //! containing the particle quantum parameter
-    std::vector<double> Chi;
+    particle_property<particle_real> Chi;
 
     //! charge state of the particle (multiples of e>0)
-    std::vector<short> Charge;
+    particle_property<short> Charge;
 
     //! Id of the particle
-    std::vector<uint64_t> Id;
+    particle_property<uint64_t> Id;
 
     // Discontinuous radiation losses
 
     //! Incremental optical depth for
     //! the Monte-Carlo process
-    std::vector<double> Tau;
+    particle_property<particle_real> Tau;
     
     //! cell_keys of the particle
     std::vector<int> cell_keys;
     
     // TEST PARTICLE PARAMETERS
     bool is_test;
+
+    //! Number of particles in a SIMD tile: the capacity of the property
+    //! arrays is kept a multiple of it (1 = no padding, "soa" storage)
+    unsigned int tile_size;
     
     //! True if tracking the particles
     bool tracked;
@@ -257,7 +284,7 @@ public:
         return Id[ipart];
     }
     //! Method used to get the Particle Ids
-    inline std::vector<uint64_t> id() const {
+    inline particle_property<uint64_t> id() const {
         return Id;
     }
     void sortById();
@@ -272,36 +299,37 @@ public:
     bool isMonteCarlo;
 
     //! Method used to get the Particle chi factor
-    inline double  chi(unsigned int ipart) const {
+    inline particle_real  chi(unsigned int ipart) const {
         return Chi[ipart];
     }
     //! Method used to set a new value to the Particle chi factor
-    inline double& chi(unsigned int ipart)       {
+    inline particle_real& chi(unsigned int ipart)       {
         return Chi[ipart];
     }
     //! Method used to get the Particle chi factor
-    inline std::vector<double>  chi() const {
+    inline particle_property<particle_real>  chi() const {
         return Chi;
     }
 
     //! Method used to get the Particle optical depth
-    inline double  tau(unsigned int ipart) const {
+    inline particle_real  tau(unsigned int ipart) const {
         return Tau[ipart];
     }
     //! Method used to set a new value to
     //! the Particle optical depth
-    inline double& tau(unsigned int ipart)       {
+    inline particle_real& tau(unsigned int ipart)       {
         return Tau[ipart];
     }
     //! Method used to get the Particle optical depth
-    inline std::vector<double>  tau() const {
+    inline particle_property<particle_real>  tau() const {
         return Tau;
     }
 
 
-    std::vector< std::vector<double  >*> double_prop;
-    std::vector< std::vector<short   >*> short_prop;
-    std::vector< std::vector<uint64_t>*> uint64_prop;
+    std::vector< particle_property<double  >*> double_prop;
+    std::vector< particle_property<float   >*> float_prop;
+    std::vector< particle_property<short   >*> short_prop;
+    std::vector< particle_property<uint64_t>*> uint64_prop;
 
 
 #ifdef __DEBUG
@@ -323,19 +351,43 @@ public:
 
     Particle operator()(unsigned int iPart);
 
-    //! Methods to obtain any property, given its index in the arrays double_prop, uint64_prop, or short_prop
-    void getProperty(unsigned int iprop, std::vector<uint64_t>* &prop) {
+    //! Methods to obtain any property, given its index in the arrays double_prop, float_prop, uint64_prop, or short_prop
+    void getProperty(unsigned int iprop, particle_property<uint64_t>* &prop) {
         prop = uint64_prop[iprop];
     }
-    void getProperty(unsigned int iprop, std::vector<short>* &prop) {
+    void getProperty(unsigned int iprop, particle_property<short>* &prop) {
         prop = short_prop[iprop];
     }
-    void getProperty(unsigned int iprop, std::vector<double>* &prop) {
+    void getProperty(unsigned int iprop, particle_property<double>* &prop) {
         prop = double_prop[iprop];
     }
+    void getProperty(unsigned int iprop, particle_property<float>* &prop) {
+        prop = float_prop[iprop];
+    }
+
+    //! Index of the first momentum component in the array of properties of type particle_real
+    //! (the weight follows, then chi and tau when they exist)
+    inline unsigned int first_real_prop() const {
+#ifdef __COMPACT_PARTICLES
+        return 0;
+#else
+        return Position.size();
+#endif
+    }
 
 private:
 
+    //! Grow the capacity of all property arrays to a whole number of tiles holding nParticles
+    void pad_to_tiles( unsigned int nParticles );
+
+    //! Append a property array to the list of its type (double_prop or float_prop)
+    inline void add_prop( particle_property<double>* prop ) {
+        double_prop.push_back( prop );
+    }
+    inline void add_prop( particle_property<float>* prop ) {
+        float_prop.push_back( prop );
+    }
+
 };
 
 
@@ -16,6 +16,8 @@
 #include "IonizationFactory.h"
 #include "RadiationFactory.h"
 #include "MultiphotonBreitWheelerFactory.h"
+#include "MergingFactory.h"
+#include "TimeSelection.h"
 #include "PartBoundCond.h"
 #include "PartWall.h"
 #include "BoundaryConditionType.h"
@@ -52,6 +54,10 @@ c_part_max(1),
 ionization_rate(Py_None),
 pusher("boris"),
 radiation_model("none"),
+merging_method("none"),
+merging_time_selection(NULL),
+merge_min_particles_per_cell(4),
+merge_momentum_cell_size(3,16),
 time_frozen(0),
 radiating(false),
 relativistic_field_initialization(false),
@@ -84,6 +90,7 @@ min_loc_vec(patch->getDomainLocalMin()),
 tracking_diagnostic(10000),
 nDim_particle(params.nDim_particle),
 partBoundCond(NULL),
+rand_(patch->rand_),
 min_loc(patch->getDomainLocalMin(0))
 
 {
@@ -223,19 +230,22 @@ void Species::initOperators(Params& params, Patch* patch)
     if (Multiphoton_Breit_Wheeler_process) {
         DEBUG("Species " << name << " will undergo multiphoton Breit-Wheeler!");
     }
+
+    // Create the particle merging method
+    Merge = MergingFactory::create(params, this);
+    if (Merge) {
+        DEBUG("Species " << name << " will undergo particle merging!");
+    }
     // define limits for BC and functions applied and for domain decomposition
     partBoundCond = new PartBoundCond(params, this, patch);
     for (unsigned int iDim=0 ; iDim < nDim_particle ; iDim++){
         for (unsigned int iNeighbor=0 ; iNeighbor<2 ; iNeighbor++) {
             MPIbuff.partRecv[iDim][iNeighbor].initialize(0, (*particles));
-            MPIbuff.partSend[iDim][iNeighbor].initialize(0, (*particles));
             MPIbuff.part_index_send[iDim][iNeighbor].resize(0);
             MPIbuff.part_index_recv_sz[iDim][iNeighbor] = 0;
             MPIbuff.part_index_send_sz[iDim][iNeighbor] = 0;
         }
     }
-    typePartSend.resize(nDim_particle*2, MPI_DATATYPE_NULL);
-    typePartRecv.resize(nDim_particle*2, MPI_DATATYPE_NULL);
     exchangePatch = MPI_DATATYPE_NULL;
 
 }
@@ -250,6 +260,8 @@ Species::~Species()
     if (Ionize) delete Ionize;
     if (Radiate) delete Radiate;
     if (Multiphoton_Breit_Wheeler_process) delete Multiphoton_Breit_Wheeler_process;
+    if (Merge) delete Merge;
+    if (merging_time_selection) delete merging_time_selection;
     if (partBoundCond) delete partBoundCond;
     if (ppcProfile) delete ppcProfile;
     if (chargeProfile) delete chargeProfile;
@@ -264,6 +276,16 @@ Species::~Species()
 }
 
 
+// ---------------------------------------------------------------------------------------------------------------------
+// Select the random stream of the species: the numbers drawn only depend on the seed, the patch Hindex,
+// the timestep, the operation and the species index (not on the thread or process treating the patch)
+// ---------------------------------------------------------------------------------------------------------------------
+void Species::set_random_stream(Params& params, Patch* patch, double time_dual, unsigned int operation)
+{
+    rand_->set_stream( patch->Hindex(), (uint32_t)floor( time_dual/params.timestep ), operation, speciesNumber );
+}
+
+
 
 // ---------------------------------------------------------------------------------------------------------------------
 // For all (np) particles in a mesh initialize its numerical weight (equivalent to a number density)
@@ -597,6 +619,7 @@ void Species::dynamics(double time_dual, unsigned int ispec,
     // calculate the particle dynamics
     // -------------------------------
     if (time_dual>time_frozen) { // moving particle
+        set_random_stream( params, patch, time_dual, Random::DYNAMICS );
 
         smpi->dynamics_resize(ithread, nDim_field, last_index.back(), params.geometry=="AMcylindrical");
         //Point to local thread dedicated buffers
@@ -641,7 +664,7 @@ void Species::dynamics(double time_dual, unsigned int ispec,
 
                 // Radiation process
                 (*Radiate)(*particles, this->photon_species, smpi,
-                         RadiationTables,
+                         RadiationTables, rand_,
                          first_index[ibin], last_index[ibin], ithread );
 
                 // Update scalar variable for diagnostics
@@ -671,7 +694,7 @@ void Species::dynamics(double time_dual, unsigned int ispec,
                 // Pair generation process
                 (*Multiphoton_Breit_Wheeler_process)(*particles,
                          smpi,
-                         MultiphotonBreitWheelerTables,
+                         MultiphotonBreitWheelerTables, rand_,
                          first_index[ibin], last_index[ibin], ithread );
 
                  // Update scalar variable for diagnostics
@@ -999,280 +1022,181 @@ void Species::computeCharge(unsigned int ispec, ElectroMagn* EMfields)
 // ---------------------------------------------------------------------------------------------------------------------
 void Species::sort_part(Params& params)
 {
-    int ndim = params.nDim_field;
-    int idim;
-    //cleanup_sent_particles(ispec, indexes_of_particles_to_exchange);
-
-    //We have stored in indexes_of_particles_to_exchange the list of all particles that needs to be removed.
-    /********************************************************************************/
-    // Delete Particles included in the index of particles to exchange. Assumes indexes are sorted.
-    /********************************************************************************/
-    int ii, iPart;
-
-    // Push lost particles at the end of bins
-    for (unsigned int ibin = 0 ; ibin < last_index.size() ; ibin++ ) {
-        ii = indexes_of_particles_to_exchange.size()-1;
-        if (ii >= 0) { // Push lost particles to the end of the bin
-            iPart = indexes_of_particles_to_exchange[ii];
-            while (iPart >= last_index[ibin] && ii > 0) {
-                ii--;
-                iPart = indexes_of_particles_to_exchange[ii];
-            }
-            while (iPart == last_index[ibin]-1 && iPart >= first_index[ibin] && ii > 0) {
-                last_index[ibin]--;
-                ii--;
-                iPart = indexes_of_particles_to_exchange[ii];
-            }
-            while (iPart >= first_index[ibin] && ii > 0) {
-                particles->overwrite_part(last_index[ibin]-1, iPart );
-                last_index[ibin]--;
-                ii--;
-                iPart = indexes_of_particles_to_exchange[ii];
-            }
-            //On traite la dernière particule (qui peut aussi etre la premiere)
-            if (iPart >= first_index[ibin] && iPart < last_index[ibin]) {
-                particles->overwrite_part(last_index[ibin]-1, iPart );
-                last_index[ibin]--;
-            }
-        }
-    }
-
-
-    //Shift the bins in memory
-    //Warning: this loop must be executed sequentially. Do not use openMP here.
-    for (int unsigned ibin = 1 ; ibin < last_index.size() ; ibin++ ) { //First bin don't need to be shifted
-        ii = first_index[ibin]-last_index[ibin-1]; // Shift the bin in memory by ii slots.
-        iPart = min(ii,last_index[ibin]-first_index[ibin]); // Number of particles we have to shift = min (Nshift, Nparticle in the bin)
-        if(iPart > 0) particles->overwrite_part(last_index[ibin]-iPart,last_index[ibin-1],iPart);
-        last_index[ibin] -= ii;
-        first_index[ibin] = last_index[ibin-1];
-    }
+    count_sort_part(params);
+}
 
+void Species::initial_configuration(Params& param, Patch * patch)
+{
+}
 
+void Species::configuration(Params& param, Patch * patch)
+{
+}
 
-    int nmove,lmove; // local, OK
-    int shift[last_index.size()+1];//how much we need to shift each bin in order to leave room for the new particle
-    double dbin;
+void Species::reconfiguration(Params& param, Patch * patch)
+{
+}
 
-    dbin = params.cell_length[0]*params.clrw; //width of a bin.
-    for (unsigned int j=0; j<last_index.size()+1 ;j++){
-        shift[j]=0;
+// ---------------------------------------------------------------------------------------------------------------------
+// Compute the cell index of particles 0->npart of parts, cells being numbered x-major (index = (ix*ny + iy)*nz + iz)
+// so that the cells of a bin (cluster of clrw cells along x) are contiguous
+// In AM geometry, the second index is the radial one
+// ---------------------------------------------------------------------------------------------------------------------
+void Species::compute_sort_keys(Params &params, Particles &parts, unsigned int npart, int* keys)
+{
+    const bool AM = (params.geometry == "AMcylindrical");
+    const int nx = params.n_space[0];
+    const int ny = params.n_space[1];
+    const int nz = params.n_space[2];
+
+    #pragma omp simd
+    for (unsigned int ip=0; ip < npart; ip++) {
+        int ix = floor( (parts.position(0,ip)-min_loc) * dx_inv_[0] );
+        ix = min( max(ix, 0), nx-1 );
+        keys[ip] = ix;
+        if (nDim_field > 1) {
+            double X = AM ? sqrt(parts.distance2_to_axis(ip)) : parts.position(1,ip);
+            int iy = floor( (X-min_loc_vec[1]) * dx_inv_[1] );
+            iy = min( max(iy, 0), ny-1 );
+            keys[ip] = keys[ip]*ny + iy;
+        }
+        if (nDim_field > 2) {
+            int iz = floor( (parts.position(2,ip)-min_loc_vec[2]) * dx_inv_[2] );
+            iz = min( max(iz, 0), nz-1 );
+            keys[ip] = keys[ip]*nz + iz;
+        }
     }
+}
 
-
-    int nbNeighbors_ = 2;
-    int n_part_recv;
-
-    indexes_of_particles_to_exchange.clear();
-    particles->erase_particle_trail(last_index.back());
-
-    //Evaluation of the necessary shift of all bins.2
-    for (unsigned int j=0; j<last_index.size()+1 ;j++){
-        shift[j]=0;
+// ---------------------------------------------------------------------------------------------------------------------
+// Sort particles by cell with a counting sort
+//   - particles listed in indexes_of_particles_to_exchange are removed
+//   - particles received from the neighbours (MPIbuff.partRecv) are inserted
+//   - all particles are scattered in a single pass into the other buffer of particles_sorted (ping-pong)
+// first_index and last_index are then the boundaries of the bins (clusters of clrw cells along x)
+// ---------------------------------------------------------------------------------------------------------------------
+void Species::count_sort_part(Params &params)
+{
+    unsigned int nbin = first_index.size();
+    // Particles beyond the last bin do not belong to the species anymore
+    unsigned int npart = last_index.back();
+    int token = (particles == &particles_sorted[0]);
+
+    // Number of cells in one bin, and in the patch
+    unsigned int ncell_bin = clrw;
+    for (unsigned int idim=1; idim < nDim_field; idim++) ncell_bin *= params.n_space[idim];
+    unsigned int ncell = nbin*ncell_bin;
+
+    // cell_keys first store the cell of each particle (-1 if it leaves the patch), then its new index
+    std::vector<int> &keys = particles->cell_keys;
+    keys.resize( particles->size() );
+    compute_sort_keys( params, *particles, npart, keys.data() );
+    for (unsigned int ii=0; ii < indexes_of_particles_to_exchange.size(); ii++) {
+        if ( indexes_of_particles_to_exchange[ii] < (int)npart )
+            keys[ indexes_of_particles_to_exchange[ii] ] = -1;
     }
 
-    //idim=0
-    shift[1] += MPIbuff.part_index_recv_sz[0][0];//Particles coming from ymin all go to bin 0 and shift all the other bins.
-    shift[last_index.size()] += MPIbuff.part_index_recv_sz[0][1];//Used only to count the total number of particles arrived.
-    //idim>0
-    for (idim = 1; idim < ndim; idim++){
-        for (int iNeighbor=0 ; iNeighbor<nbNeighbors_ ; iNeighbor++) {
-            n_part_recv = MPIbuff.part_index_recv_sz[idim][iNeighbor];
-            for (unsigned int j=0; j<(unsigned int)n_part_recv ;j++){
-                //We first evaluate how many particles arrive in each bin.
-                ii = int((MPIbuff.partRecv[idim][iNeighbor].position(0,j)-min_loc)/dbin);//bin in which the particle goes.
-                shift[ii+1]++; // It makes the next bins shift.
-            }
+    // Same for the particles just received
+    std::vector<int> recv_keys[3][2];
+    for (unsigned int idim=0; idim < nDim_field; idim++) {
+        for (unsigned int ineighbor=0; ineighbor < 2; ineighbor++) {
+            unsigned int n_part_recv = MPIbuff.part_index_recv_sz[idim][ineighbor];
+            recv_keys[idim][ineighbor].resize( n_part_recv );
+            if (n_part_recv > 0)
+                compute_sort_keys( params, MPIbuff.partRecv[idim][ineighbor], n_part_recv, &recv_keys[idim][ineighbor][0] );
         }
     }
 
-
-    //Must be done sequentially
-    for (unsigned int j=1; j<last_index.size()+1;j++){ //bin 0 is not shifted.Last element of shift stores total number of arriving particles.
-        shift[j]+=shift[j-1];
+    // Count the particles in each cell, then convert to a cumulative sum
+    std::vector<int> cell_start( ncell+1, 0 );
+    for (unsigned int ip=0; ip < npart; ip++) {
+        if ( keys[ip] >= 0 ) cell_start[ keys[ip]+1 ]++;
     }
-    //Make room for new particles
-    if (shift[last_index.size()]) {
-        //! vecor::resize of Charge crashed ! Temporay solution : push_back / Particle
-        //particles->initialize( particles->size()+shift[last_index.size()], particles->Position.size() );
-        for (int inewpart=0 ; inewpart<shift[last_index.size()] ; inewpart++) particles->create_particle();
+    for (unsigned int idim=0; idim < nDim_field; idim++) {
+        for (unsigned int ineighbor=0; ineighbor < 2; ineighbor++) {
+            for (unsigned int ip=0; ip < recv_keys[idim][ineighbor].size(); ip++)
+                cell_start[ recv_keys[idim][ineighbor][ip]+1 ]++;
+        }
     }
+    for (unsigned int icell=0; icell < ncell; icell++)
+        cell_start[icell+1] += cell_start[icell];
 
-    //Shift bins, must be done sequentially
-    for (unsigned int j=last_index.size()-1; j>=1; j--){
-        int n_particles = last_index[j]-first_index[j]; //Nbr of particle in this bin
-        nmove = min(n_particles,shift[j]); //Nbr of particles to move
-        lmove = max(n_particles,shift[j]); //How far particles must be shifted
-        if (nmove>0) particles->overwrite_part(first_index[j], first_index[j]+lmove, nmove);
-        first_index[j] += shift[j];
-        last_index[j] += shift[j];
+    // Bin boundaries
+    for (unsigned int ibin=0; ibin < nbin; ibin++) {
+        first_index[ibin] = cell_start[ ibin   *ncell_bin];
+        last_index [ibin] = cell_start[(ibin+1)*ncell_bin];
     }
 
-    //Space has been made now to write the arriving particles into the correct bins
-    //idim == 0  is the easy case, when particles arrive either in first or last bin.
-    for (int iNeighbor=0 ; iNeighbor<nbNeighbors_ ; iNeighbor++) {
-        n_part_recv = MPIbuff.part_index_recv_sz[0][iNeighbor];
-        //if ( (neighbor_[0][iNeighbor]!=MPI_PROC_NULL) && (n_part_recv!=0) ) {
-        if (                                               (n_part_recv!=0) ) {
-            ii = iNeighbor*(last_index.size()-1);//0 if iNeighbor=0(particles coming from Xmin) and last_index.size()-1 otherwise.
-            MPIbuff.partRecv[0][iNeighbor].overwrite_part(0, *particles,last_index[ii],n_part_recv);
-            last_index[ii] += n_part_recv ;
-        }
+    // Destination of each particle: cell_start is used as the insertion point in each cell
+    for (unsigned int ip=0; ip < npart; ip++) {
+        if ( keys[ip] >= 0 ) keys[ip] = cell_start[ keys[ip] ]++;
     }
-    //idim > 0; this is the difficult case, when particles can arrive in any bin.
-    for (idim = 1; idim < ndim; idim++){
-        //if (idim!=iDim) continue;
-        for (int iNeighbor=0 ; iNeighbor<nbNeighbors_ ; iNeighbor++) {
-            n_part_recv = MPIbuff.part_index_recv_sz[idim][iNeighbor];
-            //if ( (neighbor_[idim][iNeighbor]!=MPI_PROC_NULL) && (n_part_recv!=0) ) {
-            if (                                                  (n_part_recv!=0) ) {
-                for(unsigned int j=0; j<(unsigned int)n_part_recv; j++){
-                    ii = int((MPIbuff.partRecv[idim][iNeighbor].position(0,j)-min_loc)/dbin);//bin in which the particle goes.
-                    MPIbuff.partRecv[idim][iNeighbor].overwrite_part(j, *particles,last_index[ii]);
-                    last_index[ii] ++ ;
-                }
-            }
+    for (unsigned int idim=0; idim < nDim_field; idim++) {
+        for (unsigned int ineighbor=0; ineighbor < 2; ineighbor++) {
+            for (unsigned int ip=0; ip < recv_keys[idim][ineighbor].size(); ip++)
+                recv_keys[idim][ineighbor][ip] = cell_start[ recv_keys[idim][ineighbor][ip] ]++;
         }
     }
 
-
-    //The width of one bin is cell_length[0] * clrw.
-
-    int p1,p2,first_index_init;
-    unsigned int bin;
-    double limit;
-
-
-    //Backward pass
-    for (bin=0; bin<first_index.size()-1; bin++) { //Loop on the bins.
-        limit = min_loc + (bin+1)*cell_length[0]*clrw;
-        p1 = last_index[bin]-1;
-        //If first particles change bin, they do not need to be swapped.
-        while (p1 == last_index[bin]-1 && p1 >= first_index[bin]) {
-            if (particles->position(0,p1) >= limit ) {
-                last_index[bin]--;
-            }
-            p1--;
-        }
-        //         Now particles have to be swapped
-        for( p2 = p1 ; p2 >= first_index[bin] ; p2-- ) { //Loop on the bin's particles.
-            if (particles->position(0,p2) >= limit ) {
-                //This particle goes up one bin.
-                particles->swap_part(p2,last_index[bin]-1);
-                last_index[bin]--;
-            }
+    // Scatter all particles in the other buffer
+    Particles &sorted = particles_sorted[token];
+    sorted.initialize( last_index.back(), *particles );
+    particles->scatter_parts( 0, npart, keys.data(), sorted );
+    for (unsigned int idim=0; idim < nDim_field; idim++) {
+        for (unsigned int ineighbor=0; ineighbor < 2; ineighbor++) {
+            if ( recv_keys[idim][ineighbor].size() > 0 )
+                MPIbuff.partRecv[idim][ineighbor].scatter_parts( 0, recv_keys[idim][ineighbor].size(), &recv_keys[idim][ineighbor][0], sorted );
         }
     }
-    //Forward pass + Rebracketting
-    for (bin=1; bin<first_index.size(); bin++) { //Loop on the bins.
-        limit = min_loc + bin*cell_length[0]*clrw;
-        first_index_init = first_index[bin];
-        p1 = first_index[bin];
-        while (p1 == first_index[bin] && p1 < last_index[bin]) {
-            if (particles->position(0,p1) < limit ) {
-                first_index[bin]++;
-            }
-            p1++;
-        }
-        for( p2 = p1 ; p2 < last_index[bin] ; p2++ ) { //Loop on the bin's particles.
-            if (particles->position(0,p2) < limit ) {
-                //This particle goes down one bin.
-                particles->swap_part(p2,first_index[bin]);
-                first_index[bin]++;
-            }
-        }
-
-        //Rebracketting
-        //Number of particles from bin going down is: first_index[bin]-first_index_init.
-        //Number of particles from bin-1 going up is: first_index_init-last_index[bin-1].
-        //Total number of particles we need to swap is the min of both.
-        p2 = min(first_index[bin]-first_index_init,first_index_init-last_index[bin-1]);
-        if (p2 >0) particles->swap_part(last_index[bin-1],first_index[bin]-p2,p2);
-        last_index[bin-1] += first_index[bin] - first_index_init;
-        first_index[bin] = last_index[bin-1];
-    }
-}
+    sorted.cell_keys.resize( sorted.size() );
 
-void Species::initial_configuration(Params& param, Patch * patch)
-{
-}
-
-void Species::configuration(Params& param, Patch * patch)
-{
-}
-
-void Species::reconfiguration(Params& param, Patch * patch)
-{
+    particles = &sorted;
+    indexes_of_particles_to_exchange.clear();
 }
 
 // ---------------------------------------------------------------------------------------------------------------------
-// Sort particles
+// Merge the macro-particles of each cell with the Merging operator
+//   - the merged particles get a null weight
+//   - they are then removed, each bin being shifted to keep the bins contiguous
 // ---------------------------------------------------------------------------------------------------------------------
-void Species::count_sort_part(Params &params)
+void Species::merge_particles(Params &params)
 {
-    unsigned int ip, npart, ixy,tot, oc, nxy, token;
-    int ix,iy;
-    double x,y;
-
-    nxy = params.n_space[0]*params.n_space[1];
-    token = (particles == &particles_sorted[0]);
-
-    int indices[nxy];
-    npart = particles->size();
-    //particles_sorted = particles ;
-    particles_sorted[token].initialize(npart, *particles);
-
-    for (unsigned int i=0; i < nxy ; i++) indices[i] = 0 ;
-
-    // first loop counts the # of particles in each cell
-    for (ip=0; ip < npart; ip++)
-        {
-            x = particles->position(0,ip)-min_loc;
-            y = particles->position(1,ip)-min_loc_vec[1];
-
-            ix = floor(x * dx_inv_[0]) ;
-            iy = floor(y * dx_inv_[1]) ;
-
-            ixy = iy + ix*params.n_space[1];
-
-
-            indices[ixy] ++;
-        }
-
-    // second loop convert the count array in cumulative sum
-    tot=0;
-    for (unsigned int ixy=0; ixy < nxy; ixy++)
-        {
-            oc = indices[ixy];
-            indices[ixy] = tot;
-            tot += oc;
+    unsigned int npart = last_index.back();
+    if ( npart == 0 )
+        return;
+
+    // Cell of each particle (with vectorized operators, the bins are already the cells)
+    std::vector<int> cell_index( npart );
+    if ( vectorized_operators ) {
+        for (unsigned int ibin=0; ibin < first_index.size(); ibin++)
+            for (int ip=first_index[ibin]; ip < last_index[ibin]; ip++)
+                cell_index[ip] = ibin;
+    } else
+        compute_sort_keys( params, *particles, npart, cell_index.data() );
+
+    Merge->resetRemovedParticles();
+    for (unsigned int ibin=0; ibin < first_index.size(); ibin++)
+        (*Merge)( *particles, cell_index.data(), first_index[ibin], last_index[ibin] );
+
+    if ( Merge->getRemovedParticles() == 0 )
+        return;
+
+    // Remove the particles with a null weight
+    unsigned int ip_dest = 0;
+    for (unsigned int ibin=0; ibin < first_index.size(); ibin++) {
+        unsigned int ip_first = ip_dest;
+        for (unsigned int ip=first_index[ibin]; ip < (unsigned int)last_index[ibin]; ip++) {
+            if ( particles->weight(ip) > 0. ) {
+                if ( ip != ip_dest ) particles->overwrite_part( ip, ip_dest );
+                ip_dest++;
+            }
         }
-
-    //Bookmarking is not needed if normal sort is called before.
-    //first_index[0] = 0;
-    //for (bin=0; bin<first_index.size()-1; bin++) { //Loop on the bins.
-    //
-    //    first_index[bin+1] = indices[(bin+1)*params.n_space[1]*clrw] ;
-    //    last_index[bin] = first_index[bin+1];
-    //}
-    //bin = first_index.size()-1 ;
-    //last_index[bin] = npart;
-
-    // last loop puts the particles and update the count array
-    for (ip=0; ip < npart; ip++) {
-        x = particles->position(0,ip)-min_loc;
-        y = particles->position(1,ip)-min_loc_vec[1];
-
-        ix = floor(x * dx_inv_[1]) ;
-        iy = floor(y * dx_inv_[2]) ;
-
-        ixy = iy + ix*params.n_space[1];
-        particles->overwrite_part(ip, particles_sorted[token] , indices[ixy]);
-        indices[ixy]++;
+        first_index[ibin] = ip_first;
+        last_index[ibin] = ip_dest;
     }
-
-    particles = &particles_sorted[token] ;
-
+    particles->erase_particle( ip_dest, npart-ip_dest );
+    if ( particles->cell_keys.size() >= npart )
+        particles->cell_keys.erase( particles->cell_keys.begin()+ip_dest, particles->cell_keys.begin()+npart );
 }
 
 
@@ -1764,6 +1688,7 @@ void Species::ponderomotive_update_susceptibility_and_momentum(double time_dual,
     // calculate the particle updated momentum
     // -------------------------------
     if (time_dual>time_frozen) { // moving particle
+        set_random_stream( params, patch, time_dual, Random::PONDEROMOTIVE_MOMENTUM );
 
         smpi->dynamics_resize(ithread, nDim_field, last_index.back(), params.geometry=="AMcylindrical");
 
@@ -1897,6 +1822,7 @@ void Species::ponderomotive_update_position_and_currents(double time_dual, unsig
     // calculate the particle updated position
     // -------------------------------
     if (time_dual>time_frozen) { // moving particle
+        set_random_stream( params, patch, time_dual, Random::PONDEROMOTIVE_POSITION );
     
         smpi->dynamics_resize(ithread, nDim_field, last_index.back(), params.geometry=="AMcylindrical");
     
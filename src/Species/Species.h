@@ -29,6 +29,9 @@ class Field3D;
 class Patch;
 class SimWindow;
 class Radiation;
+class Merging;
+class Random;
+class TimeSelection;
 
 
 //! class Species
@@ -90,6 +93,18 @@ public:
     //! radiation model
     std::string radiation_model;
 
+    //! particle merging method
+    std::string merging_method;
+
+    //! time selection of the particle merging
+    TimeSelection* merging_time_selection;
+
+    //! minimum number of particles in a cell for the merging to occur
+    unsigned int merge_min_particles_per_cell;
+
+    //! number of momentum-space cells for the merging (norm, polar angle, azimuthal angle)
+    std::vector<unsigned int> merge_momentum_cell_size;
+
     //! Time for which the species is frozen
     double time_frozen;
 
@@ -196,9 +211,7 @@ public:
     //! Oversize (copy from Params)
     std::vector<unsigned int> oversize;
 
-    //! MPI structure to exchange particles
-    std::vector<MPI_Datatype> typePartSend ;
-    std::vector<MPI_Datatype> typePartRecv ;
+    //! MPI structure to send the particles when the patch moves to another MPI process
     MPI_Datatype exchangePatch;
 
     //! Cell_length (copy from Params)
@@ -245,9 +258,15 @@ public:
     //! Multiphoton Breit-wheeler
     MultiphotonBreitWheeler * Multiphoton_Breit_Wheeler_process;
 
+    //! Particle merging method
+    Merging * Merge;
+
     //! Boundary condition for the Particles of the considered Species
     PartBoundCond* partBoundCond;
 
+    //! Random number generator of the patch (owned by the patch)
+    Random* rand_;
+
     //! Particles pusher (change momentum & change position, only momentum in case envelope model is used)
     Pusher* Push;
 
@@ -271,6 +290,9 @@ public:
     //! Initialize operators (must be separate from parameters init, because of cloning)
     void initOperators(Params&, Patch*);
 
+    //! Select the random stream of the species for the patch, the timestep and the operation (see Random::Operation)
+    void set_random_stream(Params&, Patch*, double time_dual, unsigned int operation);
+
     //! Method returning the Particle list for the considered Species
     inline Particles getParticlesList() const {
         return *particles;
@@ -368,9 +390,12 @@ public:
     //! Method used to initialize the Particle charge
     void initCharge(unsigned int, unsigned int, double);
 
-    //! Method used to sort particles
+    //! Method used to sort particles (counting sort, see count_sort_part)
     virtual void sort_part(Params& param);
 
+    //! Merge the macro-particles of each cell (see Merging) and remove the merged ones
+    void merge_particles(Params& params);
+
     virtual void compute_part_cell_keys(Params &params) {};
 
     //! This function configures the type of species according to the default mode
@@ -384,8 +409,13 @@ public:
     //! the best mode from the particle distribution
     virtual void reconfiguration(Params& param, Patch  * patch);
 
+    //! Sort the particles by cell with a counting sort into the other particles_sorted buffer
+    //! (also removes the exchanged particles and inserts the received ones)
     void count_sort_part(Params& param);
 
+    //! Cell index of the npart first particles of parts, in the order used by count_sort_part
+    void compute_sort_keys(Params& params, Particles &parts, unsigned int npart, int* keys);
+
     //!
     virtual void add_space_for_a_particle() {
         last_index[last_index.size()-1]++;
@@ -460,6 +490,7 @@ public:
         //speciesSize *= getNbrOfParticles();
         int speciesSize(0);
         speciesSize += particles->double_prop.size()*sizeof(double);
+        speciesSize += particles->float_prop.size()*sizeof(float);
         speciesSize += particles->short_prop.size()*sizeof(short);
         speciesSize += particles->uint64_prop.size()*sizeof(uint64_t);
         speciesSize *= getParticlesCapacity();
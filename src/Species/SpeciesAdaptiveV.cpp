@@ -129,8 +129,10 @@ void SpeciesAdaptiveV::compute_part_cell_keys(Params &params)
     }
 
     // Reduction of the number of particles per cell in count
-    for (ip=0; ip < nparts ; ip++)
+    for (ip=0; ip < nparts ; ip++) {
+        (*particles).cell_keys[ip] = cell_to_bin( (*particles).cell_keys[ip] );
         count[(*particles).cell_keys[ip]] ++ ;
+    }
 
 }
 
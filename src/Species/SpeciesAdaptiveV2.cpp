@@ -95,6 +95,7 @@ void SpeciesAdaptiveV2::scalar_dynamics(double time_dual, unsigned int ispec,
     // -------------------------------
     if (time_dual>time_frozen)
     { // moving particle
+        set_random_stream( params, patch, time_dual, Random::DYNAMICS );
 
         smpi->dynamics_resize(ithread, nDim_particle, last_index.back());
 
@@ -144,7 +145,7 @@ void SpeciesAdaptiveV2::scalar_dynamics(double time_dual, unsigned int ispec,
 #endif
                 // Radiation process
                 (*Radiate)(*particles, this->photon_species, smpi,
-                           RadiationTables,
+                           RadiationTables, rand_,
                            first_index[scell], last_index[scell], ithread );
 
                 // Update scalar variable for diagnostics
@@ -170,7 +171,7 @@ void SpeciesAdaptiveV2::scalar_dynamics(double time_dual, unsigned int ispec,
                 // Pair generation process
                 (*Multiphoton_Breit_Wheeler_process)(*particles,
                                                      smpi,
-                                                     MultiphotonBreitWheelerTables,
+                                                     MultiphotonBreitWheelerTables, rand_,
                                                      first_index[scell], last_index[scell], ithread );
 
                 // Update scalar variable for diagnostics
@@ -232,6 +233,7 @@ void SpeciesAdaptiveV2::scalar_dynamics(double time_dual, unsigned int ispec,
                             (*particles).cell_keys[iPart] *= this->length[i];
                             (*particles).cell_keys[iPart] += round( ((*particles).position(i,iPart)-min_loc_vec[i]) * dx_inv_[i] );
                         }
+                        (*particles).cell_keys[iPart] = cell_to_bin( (*particles).cell_keys[iPart] );
                         //First reduction of the count sort algorithm. Lost particles are not included.
                         count[(*particles).cell_keys[iPart]] ++;
                     }
@@ -262,6 +264,7 @@ void SpeciesAdaptiveV2::scalar_dynamics(double time_dual, unsigned int ispec,
                             (*particles).cell_keys[iPart] *= this->length[i];
                             (*particles).cell_keys[iPart] += round( ((*particles).position(i,iPart)-min_loc_vec[i]) * dx_inv_[i] );
                         }
+                        (*particles).cell_keys[iPart] = cell_to_bin( (*particles).cell_keys[iPart] );
                         //First reduction of the count sort algorithm. Lost particles are not included.
                         count[(*particles).cell_keys[iPart]] ++;
                     }
@@ -523,6 +526,7 @@ void SpeciesAdaptiveV2::scalar_ponderomotive_update_susceptibility_and_momentum(
     // calculate the particle updated momentum
     // -------------------------------
     if (time_dual>time_frozen) { // moving particle
+        set_random_stream( params, patch, time_dual, Random::PONDEROMOTIVE_MOMENTUM );
 
         smpi->dynamics_resize(ithread, nDim_field, last_index.back(), params.geometry=="AMcylindrical");
 
@@ -590,6 +594,7 @@ void SpeciesAdaptiveV2::scalar_ponderomotive_update_position_and_currents(double
     // calculate the particle updated position
     // -------------------------------
     if (time_dual>time_frozen) { // moving particle
+        set_random_stream( params, patch, time_dual, Random::PONDEROMOTIVE_POSITION );
     
         smpi->dynamics_resize(ithread, nDim_field, last_index.back(), params.geometry=="AMcylindrical");
 
@@ -646,6 +651,7 @@ void SpeciesAdaptiveV2::scalar_ponderomotive_update_position_and_currents(double
                             (*particles).cell_keys[iPart] *= this->length[i];
                             (*particles).cell_keys[iPart] += round( ((*particles).position(i,iPart)-min_loc_vec[i]) * dx_inv_[i] );
                         }
+                        (*particles).cell_keys[iPart] = cell_to_bin( (*particles).cell_keys[iPart] );
                         //First reduction of the count sort algorithm. Lost particles are not included.
                         count[(*particles).cell_keys[iPart]] ++;
                     }
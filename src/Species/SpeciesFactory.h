@@ -104,7 +104,7 @@ public:
                 }
 
 #ifdef _VECTO
-                else if ( params.vectorization_mode == "on")
+                else if ( params.vectorization_mode == "on" || params.vectorization_mode == "hybrid" )
                 {
                     thisSpecies = new SpeciesNormV(params, patch);
                 }
@@ -194,7 +194,7 @@ public:
                 thisSpecies = new SpeciesNorm(params, patch);
             }
 #ifdef _VECTO
-            else if ( params.vectorization_mode == "on" )
+            else if ( params.vectorization_mode == "on" || params.vectorization_mode == "hybrid" )
             {
                 thisSpecies = new SpeciesNormV(params, patch);
             }
@@ -225,7 +225,7 @@ public:
         {
             thisSpecies->vectorized_operators = false;
         }
-        else if (params.vectorization_mode == "on" || params.vectorization_mode == "adaptive_mixed_sort" || params.vectorization_mode == "adaptive")
+        else if (params.vectorization_mode == "on" || params.vectorization_mode == "hybrid" || params.vectorization_mode == "adaptive_mixed_sort" || params.vectorization_mode == "adaptive")
         {
             thisSpecies->vectorized_operators = true;
         }
@@ -667,11 +667,51 @@ public:
         // Extract test Species flag
         PyTools::extract("is_test", thisSpecies->particles->is_test, "Species", ispec);
 
+        // Layout of the particle property arrays
+        std::string particles_storage = "soa";
+        PyTools::extract("particles_storage", particles_storage, "Species", ispec);
+        if (particles_storage == "soa") {
+            thisSpecies->particles->tile_size = 1;
+        } else if (particles_storage == "tiled") {
+            // One tile fills an aligned block of SMILEI_ALIGNMENT bytes of each double property
+            thisSpecies->particles->tile_size = SMILEI_ALIGNMENT / sizeof(double);
+            MESSAGE(2,"> Particle properties stored in aligned tiles of "
+                    << thisSpecies->particles->tile_size << " particles");
+        } else {
+            ERROR("For species '" << species_name << "', particles_storage must be 'soa' or 'tiled'");
+        }
+
         // Verify they don't ionize
         if (thisSpecies->ionization_model!="none" && thisSpecies->particles->is_test) {
             ERROR("For species '" << species_name << "' test & ionized is currently impossible");
         }
 
+        // Particle merging
+        PyTools::extract("merging_method", thisSpecies->merging_method, "Species", ispec);
+        std::transform(thisSpecies->merging_method.begin(), thisSpecies->merging_method.end(), thisSpecies->merging_method.begin(), tolower);
+        if (thisSpecies->merging_method != "none") {
+            if (thisSpecies->merging_method != "vranic") {
+                ERROR("For species '" << species_name << "', merging_method must be 'none' or 'vranic'");
+            }
+            if (thisSpecies->particles->is_test) {
+                ERROR("For species '" << species_name << "' test & merging is impossible");
+            }
+            thisSpecies->merging_time_selection = new TimeSelection(
+                PyTools::extract_py("merge_every", "Species", ispec), "Particle merging"
+            );
+            if (!PyTools::extract("merge_min_particles_per_cell", thisSpecies->merge_min_particles_per_cell, "Species", ispec)
+             || thisSpecies->merge_min_particles_per_cell < 4) {
+                ERROR("For species '" << species_name << "', merge_min_particles_per_cell must be an integer >= 4");
+            }
+            if (!PyTools::extract("merge_momentum_cell_size", thisSpecies->merge_momentum_cell_size, "Species", ispec)
+             || thisSpecies->merge_momentum_cell_size.size() != 3
+             || *std::min_element(thisSpecies->merge_momentum_cell_size.begin(), thisSpecies->merge_momentum_cell_size.end()) == 0) {
+                ERROR("For species '" << species_name << "', merge_momentum_cell_size must be a list of 3 positive integers");
+            }
+            MESSAGE(2,"> Particle merging with method `" << thisSpecies->merging_method << "`, "
+                    << thisSpecies->merging_time_selection->info());
+        }
+
         // Create the particles
         if (!params.restart) {
             // does a loop over all cells in the simulation
@@ -701,7 +741,7 @@ public:
         if ( params.vectorization_mode == "off")
             newSpecies = new SpeciesNorm(params, patch);
 #ifdef _VECTO
-        else if (params.vectorization_mode == "on")
+        else if (params.vectorization_mode == "on" || params.vectorization_mode == "hybrid")
             newSpecies = new SpeciesNormV(params, patch);
         else if (params.vectorization_mode == "adaptive_mixed_sort")
             newSpecies = new SpeciesAdaptiveV(params, patch);
@@ -716,6 +756,11 @@ public:
         newSpecies->radiation_photon_species                 = species->radiation_photon_species;
         newSpecies->radiation_photon_sampling                = species->radiation_photon_sampling;
         newSpecies->radiation_photon_gamma_threshold         = species->radiation_photon_gamma_threshold;
+        newSpecies->merging_method                           = species->merging_method;
+        if (species->merging_time_selection)
+            newSpecies->merging_time_selection               = new TimeSelection(species->merging_time_selection);
+        newSpecies->merge_min_particles_per_cell             = species->merge_min_particles_per_cell;
+        newSpecies->merge_momentum_cell_size                 = species->merge_momentum_cell_size;
         newSpecies->photon_species                           = species->photon_species;
         newSpecies->speciesNumber                            = species->speciesNumber;
         newSpecies->position_initialization_on_species       = species->position_initialization_on_species;
@@ -773,6 +818,7 @@ public:
         }
 
         newSpecies->particles->is_test                       = species->particles->is_test;
+        newSpecies->particles->tile_size                     = species->particles->tile_size;
         newSpecies->particles->tracked                       = species->particles->tracked;
         newSpecies->particles->isQuantumParameter            = species->particles->isQuantumParameter;
         newSpecies->particles->isMonteCarlo                  = species->particles->isMonteCarlo;
@@ -9,6 +9,9 @@
 
 #include "SpeciesMetrics.h"
 
+#include <algorithm>
+#include <limits>
+
 
 
 // -----------------------------------------------------------------------------
@@ -115,6 +118,47 @@ void SpeciesMetrics::get_computation_time(const std::vector<int> & count,
     scalar_time = scalar_time_loc;
 }
 
+// -----------------------------------------------------------------------------
+//! Coefficients of the fits measured on reference machines, used unless
+//! the model is calibrated at startup or given in the namelist
+// -----------------------------------------------------------------------------
+// Skylake 8168 (Ex: Irene)
+#if defined __INTEL_SKYLAKE_8168
+double SpeciesMetrics::vecto_coefficients_[5] = {
+    -5.500324176161280e-03, 5.302690106220765e-02, -2.390999177899332e-02,
+    -1.018178658950980e+00, 2.873965603217334e+00 };
+double SpeciesMetrics::scalar_coefficients_[2] = {
+    -1.476070257489217e-02, 9.539747447809775e-01 };
+// Knight Landings Intel Xeon Phi 7250 (Ex: Frioul)
+#elif defined __INTEL_KNL_7250
+double SpeciesMetrics::vecto_coefficients_[5] = {
+    9.287025545185804e-03, -1.252595460426959e-01, 6.609030611761257e-01,
+    -1.948861281215199e+00, 3.391615458521049e+00 };
+double SpeciesMetrics::scalar_coefficients_[2] = {
+    -1.693420314189753e-02, 9.640406193625433e-01 };
+// Broadwell Intel Xeon E5-2697 v4 (Ex: Tornado)
+#elif defined __INTEL_BDW_E5_2697_V4
+double SpeciesMetrics::vecto_coefficients_[5] = {
+    -4.732086199743545e-03, 3.249709067117774e-02, 1.940828611778672e-01,
+    -2.010116307618810e+00, 4.661824411143119e+00 };
+double SpeciesMetrics::scalar_coefficients_[2] = {
+    6.694852027937652e-03, 9.382353109818060e-01 };
+// Haswell Intel Xeon E5-2680 v3 (Ex: Jureca)
+#elif defined __INTEL_HSW_E5_2680_v3
+double SpeciesMetrics::vecto_coefficients_[5] = {
+    -4.127980207551420e-03, 3.688297004269906e-02, 3.666171703120181e-02,
+    -1.066920754145127e+00, 2.893485213852858e+00 };
+double SpeciesMetrics::scalar_coefficients_[2] = {
+    -1.716273243387051e-02, 9.761935025470106e-01 };
+// General fit
+#else
+double SpeciesMetrics::vecto_coefficients_[5] = {
+    -7.983397022180499e-05, -1.220834603123080e-02, 2.262009704511124e-01,
+    -1.346529777726451e+00, 3.053068997965275e+00 };
+double SpeciesMetrics::scalar_coefficients_[2] = {
+    -3.227685432492503e-02, 9.344604887689714e-01 };
+#endif
+
 //! Evaluate the time necessary to compute `particle_number` particles
 //! using vectorized operators
 /*#pragma omp declare simd
@@ -132,43 +176,11 @@ double SpeciesMetrics::get_particle_computation_time_vectorization(const double
 //#pragma omp declare simd
 float SpeciesMetrics::get_particle_computation_time_vectorization(const float log_particle_number)
 {
-// Skylake 8168 (Ex: Irene)
-#if defined __INTEL_SKYLAKE_8168
-    return    -5.500324176161280e-03 * pow(log_particle_number,4)
-+ 5.302690106220765e-02 * pow(log_particle_number,3)
- -2.390999177899332e-02 * pow(log_particle_number,2)
- -1.018178658950980e+00 * log_particle_number
-+ 2.873965603217334e+00;
-// Knight Landings Intel Xeon Phi 7250 (Ex: Frioul)
-#elif defined __INTEL_KNL_7250
-    return    + 9.287025545185804e-03 * pow(log_particle_number,4)
- -1.252595460426959e-01 * pow(log_particle_number,3)
-+ 6.609030611761257e-01 * pow(log_particle_number,2)
- -1.948861281215199e+00 * log_particle_number
-+ 3.391615458521049e+00;
-// Broadwell Intel Xeon E5-2697 v4 (Ex: Tornado)
-#elif defined __INTEL_BDW_E5_2697_V4
-    return     -4.732086199743545e-03 * pow(log_particle_number,4)
-+ 3.249709067117774e-02 * pow(log_particle_number,3)
-+ 1.940828611778672e-01 * pow(log_particle_number,2)
- -2.010116307618810e+00 * log_particle_number
-+ 4.661824411143119e+00;
-// Haswell Intel Xeon E5-2680 v3 (Ex: Jureca)
-#elif defined __INTEL_HSW_E5_2680_v3
-    return     -4.127980207551420e-03 * pow(log_particle_number,4)
-+ 3.688297004269906e-02 * pow(log_particle_number,3)
-+ 3.666171703120181e-02 * pow(log_particle_number,2)
- -1.066920754145127e+00 * log_particle_number
-+ 2.893485213852858e+00;
-// General fit
-#else
-    return   -7.983397022180499e-05 * pow(log_particle_number,4)
- -1.220834603123080e-02 * pow(log_particle_number,3)
-+ 2.262009704511124e-01 * pow(log_particle_number,2)
- -1.346529777726451e+00 * log_particle_number
-+ 3.053068997965275e+00;
-#endif
-
+    return   vecto_coefficients_[0] * pow(log_particle_number,4)
++ vecto_coefficients_[1] * pow(log_particle_number,3)
++ vecto_coefficients_[2] * pow(log_particle_number,2)
++ vecto_coefficients_[3] * log_particle_number
++ vecto_coefficients_[4];
 };
 
 //! Evaluate the time necessary to compute `particle_number` particles
@@ -180,30 +192,130 @@ double SpeciesMetrics::get_particle_computation_time_scalar(const double log_par
 + 9.539747447809775e-01;
 };*/
 
+
 //! Evaluate the time necessary to compute `particle_number` particles
 //! using scalar operators
 //#pragma omp declare simd
 float SpeciesMetrics::get_particle_computation_time_scalar(const float log_particle_number)
 {
-// Skylake 8168 (Ex: Irene)
-#if defined __INTEL_SKYLAKE_8168
-    return   -1.476070257489217e-02 * log_particle_number
-+ 9.539747447809775e-01;
-// Knight Landings Intel Xeon Phi 7250 (Ex: Frioul)
-#elif defined __INTEL_KNL_7250
-    return   -1.693420314189753e-02 * log_particle_number
-+ 9.640406193625433e-01;
-// Broadwell Intel Xeon E5-2697 v4 (Ex: Tornado)
-#elif defined __INTEL_BDW_E5_2697_V4
-    return   + 6.694852027937652e-03 * log_particle_number
-+ 9.382353109818060e-01;
-// Haswell Intel Xeon E5-2680 v3 (Ex: Jureca)
-#elif defined __INTEL_HSW_E5_2680_v3
-    return    -1.716273243387051e-02 * log_particle_number
-+ 9.761935025470106e-01;
-// General fit
-#else
-    return   -3.227685432492503e-02 * log_particle_number
-+ 9.344604887689714e-01;
-#endif
+    return   scalar_coefficients_[0] * log_particle_number
++ scalar_coefficients_[1];
 };
+
+// -----------------------------------------------------------------------------
+//! Smallest number of particles in a cell for which the vectorized operators
+//! are expected to be faster than the scalar ones
+//! (the fits are not used beyond 256 particles)
+// -----------------------------------------------------------------------------
+int SpeciesMetrics::get_vectorization_threshold()
+{
+    for (int particle_number=1; particle_number <= 256; particle_number++)
+    {
+        float log_particle_number = log(float(particle_number));
+        if (get_particle_computation_time_vectorization(log_particle_number)
+            <= get_particle_computation_time_scalar(log_particle_number))
+        {
+            return particle_number;
+        }
+    }
+    return std::numeric_limits<int>::max();
+}
+
+// -----------------------------------------------------------------------------
+//! Replace the coefficients of the model: the 5 coefficients of the
+//! vectorized fit followed by the 2 coefficients of the scalar fit
+// -----------------------------------------------------------------------------
+void SpeciesMetrics::set_coefficients(const std::vector<double> & coefficients)
+{
+    for (unsigned int i=0; i<5; i++)
+        vecto_coefficients_[i] = coefficients[i];
+    for (unsigned int i=0; i<2; i++)
+        scalar_coefficients_[i] = coefficients[5+i];
+}
+
+// -----------------------------------------------------------------------------
+//! Return the coefficients of the model (same layout as set_coefficients)
+// -----------------------------------------------------------------------------
+std::vector<double> SpeciesMetrics::get_coefficients()
+{
+    std::vector<double> coefficients(vecto_coefficients_, vecto_coefficients_+5);
+    coefficients.insert(coefficients.end(), scalar_coefficients_, scalar_coefficients_+2);
+    return coefficients;
+}
+
+// -----------------------------------------------------------------------------
+//! Fit the model on measured times per particle.
+//! The times are normalized by the mean scalar time so that the coefficients
+//! keep the magnitude of the default fits.
+// -----------------------------------------------------------------------------
+void SpeciesMetrics::fit_coefficients(const std::vector<double> & particles_per_cell,
+                                      const std::vector<double> & vecto_time,
+                                      const std::vector<double> & scalar_time)
+{
+    unsigned int n = particles_per_cell.size();
+    std::vector<double> log_particle_number(n);
+    std::vector<double> vecto(n), scalar(n);
+
+    double norm = 0;
+    for (unsigned int i=0; i<n; i++)
+        norm += scalar_time[i];
+    norm = n / norm;
+
+    for (unsigned int i=0; i<n; i++) {
+        log_particle_number[i] = log(particles_per_cell[i]);
+        vecto[i] = vecto_time[i] * norm;
+        scalar[i] = scalar_time[i] * norm;
+    }
+
+    polynomial_fit(log_particle_number, vecto, 4, vecto_coefficients_);
+    polynomial_fit(log_particle_number, scalar, 1, scalar_coefficients_);
+}
+
+// -----------------------------------------------------------------------------
+//! Least-squares fit of y by a polynomial of x of degree `degree`.
+//! The coefficients are stored from the highest degree to the constant term.
+// -----------------------------------------------------------------------------
+void SpeciesMetrics::polynomial_fit(const std::vector<double> & x,
+                                    const std::vector<double> & y,
+                                    const unsigned int degree,
+                                    double * coefficients)
+{
+    unsigned int n = degree+1;
+
+    // Normal equations A c = b, with c[k] the coefficient of x^k
+    std::vector<std::vector<double> > A(n, std::vector<double>(n+1, 0.));
+    for (unsigned int i=0; i<x.size(); i++) {
+        std::vector<double> xk(2*n-1, 1.);
+        for (unsigned int k=1; k<2*n-1; k++)
+            xk[k] = xk[k-1]*x[i];
+        for (unsigned int j=0; j<n; j++) {
+            for (unsigned int k=0; k<n; k++)
+                A[j][k] += xk[j+k];
+            A[j][n] += xk[j]*y[i];
+        }
+    }
+
+    // Gaussian elimination with partial pivoting
+    for (unsigned int j=0; j<n; j++) {
+        unsigned int pivot = j;
+        for (unsigned int i=j+1; i<n; i++)
+            if (fabs(A[i][j]) > fabs(A[pivot][j]))
+                pivot = i;
+        std::swap(A[j], A[pivot]);
+        for (unsigned int i=j+1; i<n; i++) {
+            double f = A[i][j] / A[j][j];
+            for (unsigned int k=j; k<=n; k++)
+                A[i][k] -= f * A[j][k];
+        }
+    }
+    std::vector<double> c(n);
+    for (int j=n-1; j>=0; j--) {
+        c[j] = A[j][n];
+        for (unsigned int k=j+1; k<n; k++)
+            c[j] -= A[j][k] * c[k];
+        c[j] /= A[j][j];
+    }
+
+    for (unsigned int k=0; k<n; k++)
+        coefficients[k] = c[degree-k];
+}
@@ -29,6 +29,22 @@ class SpeciesMetrics
                                          float & vecto_time,
                                          float & scalar_time);
 
+        //! Smallest number of particles in a cell for which the vectorized operators
+        //! are expected to be faster than the scalar ones
+        static int get_vectorization_threshold();
+
+        //! Replace the coefficients of the model: the 5 coefficients of the vectorized fit
+        //! (from the highest degree) followed by the 2 coefficients of the scalar fit
+        static void set_coefficients(const std::vector<double> & coefficients);
+
+        //! Return the coefficients of the model (same layout as set_coefficients)
+        static std::vector<double> get_coefficients();
+
+        //! Fit the model on the times per particle measured for the given numbers of particles per cell
+        static void fit_coefficients(const std::vector<double> & particles_per_cell,
+                                     const std::vector<double> & vecto_time,
+                                     const std::vector<double> & scalar_time);
+
     protected:
 
         //! Evaluate the time necessary to compute `particle_number` particles
@@ -49,6 +65,17 @@ class SpeciesMetrics
 
     private:
 
+        //! Coefficients of the vectorized fit (degree 4 in log of the number of particles)
+        static double vecto_coefficients_[5];
+
+        //! Coefficients of the scalar fit (degree 1 in log of the number of particles)
+        static double scalar_coefficients_[2];
+
+        //! Least-squares polynomial fit, coefficients stored from the highest degree
+        static void polynomial_fit(const std::vector<double> & x,
+                                   const std::vector<double> & y,
+                                   const unsigned int degree,
+                                   double * coefficients);
 
 };
 
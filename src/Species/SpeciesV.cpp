@@ -1,6 +1,8 @@
 #include "SpeciesV.h"
 
 #include <cmath>
+#include <algorithm>
+#include <cstdint>
 #include <ctime>
 #include <cstdlib>
 
@@ -36,6 +38,8 @@
 
 #include "DiagnosticTrack.h"
 
+#include "SpeciesMetrics.h"
+
 using namespace std;
 
 
@@ -46,10 +50,17 @@ using namespace std;
 SpeciesV::SpeciesV(Params& params, Patch* patch) :
     Species(params, patch)
 {
+    AM_ = ( params.geometry == "AMcylindrical" );
     initCluster( params );
     npack_ = 0 ;
     packsize_ = 0;
 
+    Interp_scalar_ = NULL;
+    Proj_scalar_ = NULL;
+    if ( params.vectorization_mode == "hybrid" ) {
+        Interp_scalar_ = InterpolatorFactory::create(params, patch, false);
+        Proj_scalar_ = ProjectorFactory::create(params, patch, false);
+    }
 
 }//END SpeciesV creator
 
@@ -58,13 +69,15 @@ SpeciesV::SpeciesV(Params& params, Patch* patch) :
 // ---------------------------------------------------------------------------------------------------------------------
 SpeciesV::~SpeciesV()
 {
+    if (Interp_scalar_) delete Interp_scalar_;
+    if (Proj_scalar_) delete Proj_scalar_;
 }
 
 
 void SpeciesV::initCluster(Params& params)
 {
     int ncells = 1;
-    for (unsigned int iDim=0 ; iDim<nDim_particle ; iDim++)
+    for (unsigned int iDim=0 ; iDim<nDim_field ; iDim++)
         ncells *= (params.n_space[iDim]+1);
     last_index.resize(ncells,0);
     first_index.resize(ncells,0);
@@ -79,17 +92,17 @@ void SpeciesV::initCluster(Params& params)
     f_dim2 =  params.n_space[2] + 2 * oversize[2] +1;
 
     b_dim.resize(params.nDim_field, 1);
-    if (nDim_particle == 1){
+    if (nDim_field == 1){
         b_dim[0] =  (1 + clrw) + 2 * oversize[0];
         f_dim1 = 1;
         f_dim2 = 1;
     }
-    if (nDim_particle == 2){
+    if (nDim_field == 2){
         b_dim[0] =  (1 + clrw) + 2 * oversize[0]; // There is a primal number of bins.
         b_dim[1] =  f_dim1;
         f_dim2 = 1;
     }
-    if (nDim_particle == 3){
+    if (nDim_field == 3){
         b_dim[0] =  (1 + clrw) + 2 * oversize[0]; // There is a primal number of bins.
         b_dim[1] = f_dim1;
         b_dim[2] = f_dim2;
@@ -103,8 +116,50 @@ void SpeciesV::initCluster(Params& params)
     nrj_mw_lost = 0.;
     nrj_new_particles = 0.;
 
+    init_cell_ordering(params);
+
 }//END initCluster
 
+// ---------------------------------------------------------------------------------------------------------------------
+// Build the correspondence between the linear cell indices and the bins when the cells are ordered
+// along a Morton curve: the bins are sorted by increasing Morton code (bit interleaving of the cell
+// coordinates), so that consecutive bins, hence consecutive particles, are close in space in every dimension.
+// ---------------------------------------------------------------------------------------------------------------------
+void SpeciesV::init_cell_ordering(Params& params)
+{
+    cell_bin_.clear();
+    bin_cell_.clear();
+    if ( params.cell_ordering != "morton" || nDim_field < 2 )
+        return;
+
+    unsigned int ncell[3] = {1, 1, 1};
+    for (unsigned int iDim=0 ; iDim<nDim_field ; iDim++)
+        ncell[iDim] = params.n_space[iDim]+1;
+    unsigned int ncells = ncell[0]*ncell[1]*ncell[2];
+
+    // Morton code of each cell, paired with its linear index
+    vector<pair<uint64_t,int> > code(ncells);
+    for (unsigned int ix=0 ; ix<ncell[0] ; ix++)
+        for (unsigned int iy=0 ; iy<ncell[1] ; iy++)
+            for (unsigned int iz=0 ; iz<ncell[2] ; iz++) {
+                unsigned int ic[3] = {ix, iy, iz};
+                uint64_t key = 0;
+                for (unsigned int ibit=0 ; ibit<21 ; ibit++)
+                    for (unsigned int iDim=0 ; iDim<nDim_field ; iDim++)
+                        key |= (uint64_t)( (ic[iDim]>>ibit) & 1 ) << (ibit*nDim_field + nDim_field-1-iDim);
+                int icell = (ix*ncell[1] + iy)*ncell[2] + iz;
+                code[icell] = make_pair(key, icell);
+            }
+    sort(code.begin(), code.end());
+
+    cell_bin_.resize(ncells);
+    bin_cell_.resize(ncells);
+    for (unsigned int ibin=0 ; ibin<ncells ; ibin++) {
+        bin_cell_[ibin] = code[ibin].second;
+        cell_bin_[code[ibin].second] = ibin;
+    }
+}
+
 
 void SpeciesV::dynamics(double time_dual, unsigned int ispec,
                        ElectroMagn* EMfields, Params &params, bool diag_flag,
@@ -134,7 +189,7 @@ int ithread;
         //else
         //    npack_ *= (f_dim0-2*oversize[0]);
 
-        if (nDim_particle == 3)
+        if (nDim_field == 3)
             packsize_ *= (f_dim2-2*oversize[2]);
     }
 
@@ -151,6 +206,7 @@ int ithread;
     // calculate the particle dynamics
     // -------------------------------
     if (time_dual>time_frozen) { // moving particle
+        set_random_stream( params, patch, time_dual, Random::DYNAMICS );
 
         smpi->dynamics_resize(ithread, nDim_field, last_index.back(), params.geometry=="AMcylindrical");
 
@@ -162,10 +218,16 @@ int ithread;
         for (unsigned int i=0; i<count.size(); i++)
             count[i] = 0;
 
+        // Hybrid mode: the cells with less particles than this threshold use the scalar operators.
+        // These index the particle buffers like the vectorized ones only when they hold all the particles.
+        int scalar_threshold = 0;
+        if ( Interp_scalar_ && npack_ == 1 && (int)particles->size() == last_index.back() )
+            scalar_threshold = SpeciesMetrics::get_vectorization_threshold();
+
         for ( unsigned int ipack = 0 ; ipack < npack_ ; ipack++ ) {
 
             int nparts_in_pack = last_index[ (ipack+1) * packsize_-1 ];
-            smpi->dynamics_resize(ithread, nDim_particle, nparts_in_pack );
+            smpi->dynamics_resize(ithread, nDim_field, nparts_in_pack, params.geometry=="AMcylindrical" );
 
 #ifdef  __DETAILED_TIMERS
             timer = MPI_Wtime();
@@ -174,10 +236,13 @@ int ithread;
             // Interpolate the fields at the particle position
             //for (unsigned int scell = 0 ; scell < first_index.size() ; scell++)
             //    (*Interp)(EMfields, *particles, smpi, &(first_index[scell]), &(last_index[scell]), ithread );
-            for (unsigned int scell = 0 ; scell < packsize_ ; scell++)
-                (*Interp)(EMfields, *particles, smpi, &(first_index[ipack*packsize_+scell]),
-                                                      &(last_index[ipack*packsize_+scell]),
-                                                      ithread, first_index[ipack*packsize_] );
+            for (unsigned int scell = 0 ; scell < packsize_ ; scell++) {
+                unsigned int ibin = ipack*packsize_+scell;
+                Interpolator* interp = ( last_index[ibin]-first_index[ibin] < scalar_threshold ) ? Interp_scalar_ : Interp;
+                (*interp)(EMfields, *particles, smpi, &(first_index[ibin]),
+                                                     &(last_index[ibin]),
+                                                     ithread, first_index[ipack*packsize_] );
+            }
 
 #ifdef  __DETAILED_TIMERS
             patch->patch_timers[0] += MPI_Wtime() - timer;
@@ -206,7 +271,7 @@ int ithread;
                 for (unsigned int ibin = 0 ; ibin < first_index.size() ; ibin++) {
                     // Radiation process
                     (*Radiate)(*particles, this->photon_species, smpi,
-                               RadiationTables,
+                               RadiationTables, rand_,
                                first_index[ibin], last_index[ibin], ithread );
 
                     // Update scalar variable for diagnostics
@@ -235,7 +300,7 @@ int ithread;
                     // Pair generation process
                     (*Multiphoton_Breit_Wheeler_process)(*particles,
                                                          smpi,
-                                                         MultiphotonBreitWheelerTables,
+                                                         MultiphotonBreitWheelerTables, rand_,
                                                          first_index[ibin], last_index[ibin], ithread );
 
                     // Update scalar variable for diagnostics
@@ -278,11 +343,6 @@ int ithread;
             // Computation of the particle cell keys for all particles
             // this->compute_bin_cell_keys(params, first_index[ipack*packsize_], last_index[ipack*packsize_+packsize_-1]);
 
-            unsigned int length[3];
-            length[0]=0;
-            length[1]=params.n_space[1]+1;
-            length[2]=params.n_space[2]+1;
-
             //for (unsigned int ibin = 0 ; ibin < first_index.size() ; ibin++) {
             for (unsigned int ibin = 0 ; ibin < packsize_ ; ibin++) {
                 // Apply wall and boundary conditions
@@ -310,10 +370,8 @@ int ithread;
                             }
                             else {
                                 //Compute cell_keys of remaining particles
-                                for ( unsigned int i = 0 ; i<nDim_particle; i++ ){
-                                    (*particles).cell_keys[iPart] *= this->length[i];
-                                    (*particles).cell_keys[iPart] += round( ((*particles).position(i,iPart)-min_loc_vec[i]) * dx_inv_[i] );
-                                }
+                                (*particles).cell_keys[iPart] = cell_key( *particles, iPart );
+                                (*particles).cell_keys[iPart] = cell_to_bin( (*particles).cell_keys[iPart] );
                                 //First reduction of the count sort algorithm. Lost particles are not included.
                                 count[(*particles).cell_keys[iPart]] ++;
                             }
@@ -341,10 +399,8 @@ int ithread;
                         }
                         else {
                             //Compute cell_keys of remaining particles
-                            for ( unsigned int i = 0 ; i<nDim_particle; i++ ){
-                                (*particles).cell_keys[iPart] *= length[i];
-                                (*particles).cell_keys[iPart] += round( ((*particles).position(i,iPart)-min_loc_vec[i]) * dx_inv_[i] );
-                            }
+                            (*particles).cell_keys[iPart] = cell_key( *particles, iPart );
+                            (*particles).cell_keys[iPart] = cell_to_bin( (*particles).cell_keys[iPart] );
                             //First reduction of the count sort algorithm. Lost particles are not included.
                             count[(*particles).cell_keys[iPart]] ++;
                         }
@@ -368,12 +424,19 @@ int ithread;
             timer = MPI_Wtime();
 #endif
 
-                for (unsigned int scell = 0 ; scell < packsize_ ; scell++)
-                    (*Proj)(EMfields, *particles, smpi, first_index[ipack*packsize_+scell],
-                                                        last_index[ipack*packsize_+scell],
-                                                        ithread, ipack*packsize_+scell,
-                                                        clrw, diag_flag, params.is_spectral,
-                                                        b_dim, ispec, first_index[ipack*packsize_] );
+                for (unsigned int scell = 0 ; scell < packsize_ ; scell++) {
+                    unsigned int ibin = ipack*packsize_+scell;
+                    // Same operator type as the interpolation, which buffered the old positions
+                    if ( last_index[ibin]-first_index[ibin] < scalar_threshold )
+                        (*Proj_scalar_)(EMfields, *particles, smpi, first_index[ibin], last_index[ibin],
+                                        ithread, 0, clrw, diag_flag, params.is_spectral, b_dim, ispec );
+                    else
+                        (*Proj)(EMfields, *particles, smpi, first_index[ibin],
+                                                            last_index[ibin],
+                                                            ithread, bin_to_cell( ibin ),
+                                                            clrw, diag_flag, params.is_spectral,
+                                                            b_dim, ispec, first_index[ipack*packsize_] );
+                }
 
 #ifdef  __DETAILED_TIMERS
             patch->patch_timers[2] += MPI_Wtime() - timer;
@@ -414,7 +477,7 @@ void SpeciesV::computeCharge(unsigned int ispec, ElectroMagn* EMfields)
     // -------------------------------
     // calculate the particle charge
     // -------------------------------
-    if ( (!particles->is_test) ) {
+    if ( (!particles->is_test) && (!AM_) ) {
         double* b_rho=&(*EMfields->rho_)(0);
 
         for (unsigned int iPart=first_index[0] ; (int)iPart<last_index[last_index.size()-1]; iPart++ )
@@ -432,7 +495,6 @@ void SpeciesV::sort_part(Params &params)
 {
     unsigned int npart, ncell;
     int ip_dest, cell_target;
-    unsigned int length[3];
     vector<int> buf_cell_keys[3][2];
     std::vector<unsigned int> cycle;
     unsigned int ip_src;
@@ -443,10 +505,6 @@ void SpeciesV::sort_part(Params &params)
 
     npart = (*particles).size(); //Number of particles before exchange
 
-    length[0]=0;
-    length[1]=params.n_space[1]+1;
-    length[2]=params.n_space[2]+1;
-
     //count temporarily stores the # of particles in a given cell quadrant.
 
     //Loop over just arrived particles
@@ -455,14 +513,11 @@ void SpeciesV::sort_part(Params &params)
             buf_cell_keys[idim][ineighbor].resize( MPIbuff.part_index_recv_sz[idim][ineighbor]);
             #pragma omp simd
             for (unsigned int ip=0; ip < MPIbuff.part_index_recv_sz[idim][ineighbor]; ip++){
-                for (unsigned int ipos=0; ipos < nDim_particle ; ipos++) {
-                    double X = MPIbuff.partRecv[idim][ineighbor].position(ipos,ip)-min_loc_vec[ipos];
-                    int IX = round(X * dx_inv_[ipos] );
-                    buf_cell_keys[idim][ineighbor][ip] = buf_cell_keys[idim][ineighbor][ip] * length[ipos] + IX;
-                }
+                buf_cell_keys[idim][ineighbor][ip] = cell_key( MPIbuff.partRecv[idim][ineighbor], ip );
             }
             //Can we vectorize this reduction ?
             for (unsigned int ip=0; ip < MPIbuff.part_index_recv_sz[idim][ineighbor]; ip++){
+                buf_cell_keys[idim][ineighbor][ip] = cell_to_bin( buf_cell_keys[idim][ineighbor][ip] );
                 count[buf_cell_keys[idim][ineighbor][ip]] ++;
             }
         }
@@ -577,22 +632,18 @@ void SpeciesV::compute_part_cell_keys(Params &params)
     //Compute part_cell_keys at patch creation. This operation is normally done in the pusher to avoid additional particles pass.
 
     unsigned int ip, npart;
-    int IX;
-    double X;
 
     npart = (*particles).size(); //Number of particles
 
     #pragma omp simd
     for (ip=0; ip < npart ; ip++){
     // Counts the # of particles in each cell (or sub_cell) and store it in slast_index.
-        for (unsigned int ipos=0; ipos < nDim_particle ; ipos++) {
-            X = (*particles).position(ipos,ip)-min_loc_vec[ipos];
-            IX = round(X * dx_inv_[ipos] );
-            (*particles).cell_keys[ip] = (*particles).cell_keys[ip] * this->length[ipos] + IX;
-        }
+        (*particles).cell_keys[ip] = cell_key( *particles, ip );
     }
-    for (ip=0; ip < npart ; ip++)
+    for (ip=0; ip < npart ; ip++) {
+        (*particles).cell_keys[ip] = cell_to_bin( (*particles).cell_keys[ip] );
         count[(*particles).cell_keys[ip]] ++ ;
+    }
 
 }
 
@@ -612,11 +663,11 @@ void SpeciesV::compute_bin_cell_keys(Params &params, int istart, int iend)
     #pragma omp simd
     for (int ip=istart; ip < iend; ip++){
     // Counts the # of particles in each cell (or sub_cell) and store it in slast_index.
-        for (unsigned int ipos=0; ipos < nDim_particle ; ipos++) {
-            (*particles).cell_keys[ip] *= this->length[ipos];
-            (*particles).cell_keys[ip] += round( ((*particles).position(ipos,ip)-min_loc_vec[ipos]) * dx_inv_[ipos] );
-        }
+        (*particles).cell_keys[ip] = cell_key( *particles, ip );
     }
+    if ( !cell_bin_.empty() )
+        for (int ip=istart; ip < iend; ip++)
+            (*particles).cell_keys[ip] = cell_bin_[(*particles).cell_keys[ip]];
 }
 
 void SpeciesV::importParticles( Params& params, Patch* patch, Particles& source_particles, vector<Diagnostic*>& localDiags )
@@ -628,14 +679,6 @@ void SpeciesV::importParticles( Params& params, Patch* patch, Particles& source_
     if( particles->tracked )
         dynamic_cast<DiagnosticTrack*>(localDiags[tracking_diagnostic])->setIDs( source_particles );
 
-    unsigned int length[3];
-    length[0]=0;
-    length[1]=params.n_space[1]+1;
-    length[2]=params.n_space[2]+1;
-
-    int IX;
-    double X;
-
     // std::cerr << "SpeciesV::importParticles "
     //           << " for "<< this->name
     //           << " in patch (" << patch->Pcoordinates[0] << "," <<  patch->Pcoordinates[1] << "," <<  patch->Pcoordinates[2] << ") "
@@ -649,12 +692,7 @@ void SpeciesV::importParticles( Params& params, Patch* patch, Particles& source_
     for( unsigned int i=0; i<npart; i++ ) {
 
         // Compute the receiving bin index
-        ibin = 0;
-        for (unsigned int ipos=0; ipos < nDim_particle ; ipos++) {
-            X = source_particles.position(ipos,i)-min_loc_vec[ipos];
-            IX = round(X * dx_inv_[ipos] );
-            ibin = ibin * length[ipos] + IX;
-        }
+        ibin = cell_to_bin( cell_key( source_particles, i ) );
 
         // Copy particle to the correct bin
         source_particles.cp_particle(i, *particles, last_index[ibin] );
@@ -708,7 +746,7 @@ void SpeciesV::ponderomotive_update_susceptibility_and_momentum(double time_dual
         //else
         //    npack_ *= (f_dim0-2*oversize[0]);
 
-        if (nDim_particle == 3)
+        if (nDim_field == 3)
             packsize_ *= (f_dim2-2*oversize[2]);
     }
 
@@ -717,6 +755,7 @@ void SpeciesV::ponderomotive_update_susceptibility_and_momentum(double time_dual
     // calculate the particle dynamics
     // -------------------------------
     if (time_dual>time_frozen) { // advance particle momentum
+        set_random_stream( params, patch, time_dual, Random::PONDEROMOTIVE_MOMENTUM );
 
         for ( unsigned int ipack = 0 ; ipack < npack_ ; ipack++ ) {
 
@@ -741,7 +780,7 @@ void SpeciesV::ponderomotive_update_susceptibility_and_momentum(double time_dual
             timer = MPI_Wtime();
 #endif
             for (unsigned int scell = 0 ; scell < packsize_ ; scell++)
-                Proj->project_susceptibility( EMfields, *particles, mass, smpi, first_index[ipack*packsize_+scell], last_index[ipack*packsize_+scell], ithread, ipack*packsize_+scell, b_dim, first_index[ipack*packsize_] );
+                Proj->project_susceptibility( EMfields, *particles, mass, smpi, first_index[ipack*packsize_+scell], last_index[ipack*packsize_+scell], ithread, bin_to_cell( ipack*packsize_+scell ), b_dim, first_index[ipack*packsize_] );
 
 #ifdef  __DETAILED_TIMERS
             patch->patch_timers[8] += MPI_Wtime() - timer;
@@ -797,7 +836,7 @@ void SpeciesV::ponderomotive_project_susceptibility(double time_dual, unsigned i
         //else
         //    npack_ *= (f_dim0-2*oversize[0]);
 
-        if (nDim_particle == 3)
+        if (nDim_field == 3)
             packsize_ *= (f_dim2-2*oversize[2]);
     }
 
@@ -830,7 +869,7 @@ void SpeciesV::ponderomotive_project_susceptibility(double time_dual, unsigned i
             timer = MPI_Wtime();
 #endif
             for (unsigned int scell = 0 ; scell < packsize_ ; scell++)
-                Proj->project_susceptibility( EMfields, *particles, mass, smpi, first_index[ipack*packsize_+scell], last_index[ipack*packsize_+scell], ithread, ipack*packsize_+scell, b_dim, first_index[ipack*packsize_] );
+                Proj->project_susceptibility( EMfields, *particles, mass, smpi, first_index[ipack*packsize_+scell], last_index[ipack*packsize_+scell], ithread, bin_to_cell( ipack*packsize_+scell ), b_dim, first_index[ipack*packsize_] );
 
 #ifdef  __DETAILED_TIMERS
             patch->patch_timers[8] += MPI_Wtime() - timer;
@@ -884,6 +923,7 @@ void SpeciesV::ponderomotive_update_position_and_currents(double time_dual, unsi
    // calculate the particle dynamics
    // -------------------------------
    if (time_dual>time_frozen) { // moving particle
+        set_random_stream( params, patch, time_dual, Random::PONDEROMOTIVE_POSITION );
 
         //Prepare for sorting
         for (unsigned int i=0; i<count.size(); i++)
@@ -914,11 +954,6 @@ void SpeciesV::ponderomotive_update_position_and_currents(double time_dual, unsi
             patch->patch_timers[11] += MPI_Wtime() - timer;
             timer = MPI_Wtime();
 #endif
-            unsigned int length[3];
-            length[0]=0;
-            length[1]=params.n_space[1]+1;
-            length[2]=params.n_space[2]+1;
-
             for (unsigned int ibin = 0 ; ibin < packsize_ ; ibin++) {
                 // Apply wall and boundary conditions
                 if (mass>0)
@@ -944,10 +979,8 @@ void SpeciesV::ponderomotive_update_position_and_currents(double time_dual, unsi
                             }
                             else {
                                 //First reduction of the count sort algorithm. Lost particles are not included.
-                                for ( int i = 0 ; i<(int)nDim_particle; i++ ){
-                                    (*particles).cell_keys[iPart] *= length[i];
-                                    (*particles).cell_keys[iPart] += round( ((*particles).position(i,iPart)-min_loc_vec[i]) * dx_inv_[i] );
-                                }
+                                (*particles).cell_keys[iPart] = cell_key( *particles, iPart );
+                                (*particles).cell_keys[iPart] = cell_to_bin( (*particles).cell_keys[iPart] );
                                 count[(*particles).cell_keys[iPart]] ++; //First reduction of the count sort algorithm. Lost particles are not included.
                             }
                         }
@@ -970,7 +1003,7 @@ void SpeciesV::ponderomotive_update_position_and_currents(double time_dual, unsi
 #endif
             if ((!particles->is_test) && (mass > 0))
                 for (unsigned int scell = 0 ; scell < packsize_ ; scell++)
-                    (*Proj)(EMfields, *particles, smpi, first_index[ipack*packsize_+scell], last_index[ipack*packsize_+scell], ithread, ipack*packsize_+scell, clrw, diag_flag, params.is_spectral, b_dim, ispec, first_index[ipack*packsize_] );
+                    (*Proj)(EMfields, *particles, smpi, first_index[ipack*packsize_+scell], last_index[ipack*packsize_+scell], ithread, bin_to_cell( ipack*packsize_+scell ), clrw, diag_flag, params.is_spectral, b_dim, ispec, first_index[ipack*packsize_] );
 
 #ifdef  __DETAILED_TIMERS
             patch->patch_timers[12] += MPI_Wtime() - timer;
@@ -1002,3 +1035,131 @@ void SpeciesV::ponderomotive_update_position_and_currents(double time_dual, unsi
    }//END if time vs. time_frozen
 
 } // end ponderomotive_update_position_and_currents
+
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Measure the time per particle of the scalar and vectorized operators on synthetic cells
+// The synthetic particles have a zero charge: the push does not move them and nothing is projected.
+// ---------------------------------------------------------------------------------------------------------------------
+void SpeciesV::benchmark_operators( Params &params, Patch *patch, SmileiMPI *smpi,
+                                    const vector<double> &particles_per_cell,
+                                    vector<double> &vecto_time,
+                                    vector<double> &scalar_time )
+{
+    int ithread;
+#ifdef _OPENMP
+    ithread = omp_get_thread_num();
+#else
+    ithread = 0;
+#endif
+
+    ElectroMagn *EMfields = patch->EMfields;
+
+    // Scalar (0) and vectorized (1) operators
+    Interpolator *interp[2];
+    Pusher *push[2];
+    Projector *proj[2];
+    bool vectorized = vectorized_operators;
+    for( unsigned int mode=0 ; mode<2 ; mode++ ) {
+        vectorized_operators = ( mode==1 );
+        interp[mode] = InterpolatorFactory::create( params, patch, vectorized_operators );
+        push  [mode] = PusherFactory::create( params, this );
+        proj  [mode] = ProjectorFactory::create( params, patch, vectorized_operators );
+    }
+    vectorized_operators = vectorized;
+
+    // The benchmark is restricted to the first bins of the patch to bound its memory footprint
+    unsigned int nbins = 1;
+    for( unsigned int idim=0 ; idim<nDim_field ; idim++ ) {
+        nbins *= params.n_space[idim]+1;
+    }
+    nbins = min( nbins, 64u );
+
+    // Quasi-random offsets of the particles in their cell (additive recurrence)
+    const double alpha[3] = { 0.6180339887498949, 0.7548776662466927, 0.5698402909980532 };
+
+    vecto_time.resize( particles_per_cell.size() );
+    scalar_time.resize( particles_per_cell.size() );
+
+    for( unsigned int isample=0 ; isample<particles_per_cell.size() ; isample++ ) {
+
+        unsigned int ppc = particles_per_cell[isample];
+        int npart = ppc * nbins;
+
+        Particles parts;
+        parts.initialize( npart, *particles );
+        vector<int> first( nbins ), last( nbins );
+
+        for( unsigned int ibin=0 ; ibin<nbins ; ibin++ ) {
+            first[ibin] = ibin*ppc;
+            last [ibin] = first[ibin]+ppc;
+
+            // Coordinates of the cell stored in this bin
+            unsigned int icell[3];
+            int cell = bin_to_cell( ibin );
+            for( int idim=nDim_field-1 ; idim>=0 ; idim-- ) {
+                icell[idim] = cell % ( params.n_space[idim]+1 );
+                cell /= params.n_space[idim]+1;
+            }
+
+            for( unsigned int ip=0 ; ip<ppc ; ip++ ) {
+                unsigned int ipart = first[ibin]+ip;
+                for( unsigned int idim=0 ; idim<nDim_field ; idim++ ) {
+                    double offset = 0.45 * ( 2.*fmod( ( ip+0.5 )*alpha[idim], 1. ) - 1. );
+                    if( icell[idim] == 0 ) {
+                        offset = fabs( offset );
+                    } else if( icell[idim] == params.n_space[idim] ) {
+                        offset = -fabs( offset );
+                    }
+                    parts.position( idim, ipart ) = min_loc_vec[idim] + ( icell[idim]+offset )*cell_length[idim];
+                }
+                for( unsigned int i=0 ; i<3 ; i++ ) {
+                    parts.momentum( i, ipart ) = 0.;
+                }
+                parts.weight( ipart ) = 1.;
+                parts.charge( ipart ) = 0;
+            }
+        }
+
+        smpi->dynamics_resize( ithread, nDim_field, npart, false );
+
+        // Enough repetitions to measure at least ~10^5 particle updates
+        unsigned int nrepeat = max( 1, 100000/npart );
+
+        for( unsigned int mode=0 ; mode<2 ; mode++ ) {
+            // Best of 3 trials, the first one also warms up the caches
+            double best = 0.;
+            for( unsigned int itrial=0 ; itrial<3 ; itrial++ ) {
+                double timer = MPI_Wtime();
+                for( unsigned int irepeat=0 ; irepeat<nrepeat ; irepeat++ ) {
+                    if( mode == 1 ) {
+                        for( unsigned int ibin=0 ; ibin<nbins ; ibin++ ) {
+                            ( *interp[mode] )( EMfields, parts, smpi, &first[ibin], &last[ibin], ithread, 0 );
+                        }
+                        ( *push[mode] )( parts, smpi, 0, npart, ithread, 0 );
+                        for( unsigned int ibin=0 ; ibin<nbins ; ibin++ ) {
+                            ( *proj[mode] )( EMfields, parts, smpi, first[ibin], last[ibin], ithread, bin_to_cell( ibin ),
+                                             clrw, false, params.is_spectral, b_dim, 0, 0 );
+                        }
+                    } else {
+                        int istart = 0, iend = npart;
+                        ( *interp[mode] )( EMfields, parts, smpi, &istart, &iend, ithread );
+                        ( *push[mode] )( parts, smpi, 0, npart, ithread );
+                        ( *proj[mode] )( EMfields, parts, smpi, 0, npart, ithread, 0, clrw, false, params.is_spectral, b_dim, 0 );
+                    }
+                }
+                timer = MPI_Wtime() - timer;
+                if( itrial == 0 || timer < best ) {
+                    best = timer;
+                }
+            }
+            ( mode==1 ? vecto_time : scalar_time )[isample] = best / ( nrepeat*npart );
+        }
+    }
+
+    for( unsigned int mode=0 ; mode<2 ; mode++ ) {
+        delete interp[mode];
+        delete push[mode];
+        delete proj[mode];
+    }
+}
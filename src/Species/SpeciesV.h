@@ -3,6 +3,7 @@
 
 #include <vector>
 #include <string>
+#include <cmath>
 
 #include "Species.h"
 
@@ -86,6 +87,52 @@ class SpeciesV : public Species
     //! Method to import particles in this species while conserving the sorting among bins
     void importParticles( Params&, Patch*, Particles&, std::vector<Diagnostic*>& )override;
 
+    //! Measure the time per particle of the scalar and vectorized operators (interpolation, push, projection)
+    //! on synthetic cells of the patch, each containing particles_per_cell[i] particles
+    void benchmark_operators( Params &params, Patch *patch, SmileiMPI *smpi,
+                              const std::vector<double> &particles_per_cell,
+                              std::vector<double> &vecto_time,
+                              std::vector<double> &scalar_time );
+
+protected:
+
+    //! Bin index of each cell (linear index) when the cells are ordered along a Morton curve.
+    //! Empty for the standard ordering, in which the bin index is the linear cell index.
+    std::vector<int> cell_bin_;
+    //! Linear index of the cell stored in each bin (inverse of cell_bin_)
+    std::vector<int> bin_cell_;
+
+    //! Build cell_bin_ and bin_cell_ according to params.cell_ordering
+    void init_cell_ordering(Params& params);
+
+    //! Bin index of the cell of linear index icell
+    inline int cell_to_bin(int icell) const {
+        return cell_bin_.empty() ? icell : cell_bin_[icell];
+    }
+    //! Linear index of the cell stored in bin ibin (as expected by the vectorized projectors)
+    inline int bin_to_cell(int ibin) const {
+        return bin_cell_.empty() ? ibin : bin_cell_[ibin];
+    }
+
+    //! True in AM geometry: the cells are indexed by the longitudinal position and the distance to the axis
+    bool AM_;
+
+    //! Scalar interpolator and projector of the hybrid vectorization mode, applied to the cells
+    //! containing too few particles to benefit from the vectorized operators (NULL otherwise)
+    Interpolator* Interp_scalar_;
+    Projector* Proj_scalar_;
+
+    //! Linear index of the cell (rounded position) of the particle ipart of parts
+    inline int cell_key( Particles &parts, unsigned int ipart ) const {
+        if ( AM_ )
+            return round( (parts.position(0,ipart)-min_loc_vec[0]) * dx_inv_[0] ) * length[1]
+                 + round( (sqrt( parts.distance2_to_axis(ipart) )-min_loc_vec[1]) * dx_inv_[1] );
+        int key = 0;
+        for ( unsigned int ipos=0; ipos < nDim_particle ; ipos++ )
+            key = key * length[ipos] + round( (parts.position(ipos,ipart)-min_loc_vec[ipos]) * dx_inv_[ipos] );
+        return key;
+    }
+
 private:
 
     //! Number of packs of particles that divides the total number of particles
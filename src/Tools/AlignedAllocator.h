@@ -0,0 +1,76 @@
+// -----------------------------------------------------------------------------
+//
+//! \file AlignedAllocator.h
+//
+//! \brief Allocator providing memory aligned on the SIMD register/cache
+//!        line boundaries, for the arrays accessed by vectorized operators
+//
+// -----------------------------------------------------------------------------
+
+#ifndef ALIGNEDALLOCATOR_H
+#define ALIGNEDALLOCATOR_H
+
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+#include <utility>
+
+//! Alignment in bytes of the particle property arrays (one cache line,
+//! also the width of an AVX-512 register)
+#define SMILEI_ALIGNMENT 64
+
+template<typename T, std::size_t Alignment = SMILEI_ALIGNMENT>
+class AlignedAllocator
+{
+public:
+    typedef T              value_type;
+    typedef T*             pointer;
+    typedef const T*       const_pointer;
+    typedef T&             reference;
+    typedef const T&       const_reference;
+    typedef std::size_t    size_type;
+    typedef std::ptrdiff_t difference_type;
+
+    template<typename U>
+    struct rebind {
+        typedef AlignedAllocator<U, Alignment> other;
+    };
+
+    AlignedAllocator() {}
+    template<typename U>
+    AlignedAllocator( const AlignedAllocator<U, Alignment>& ) {}
+
+    //! Allocate n elements on an Alignment-byte boundary
+    pointer allocate( size_type n, const void* = 0 ) {
+        if ( n == 0 ) return nullptr;
+        void* p = nullptr;
+        if ( posix_memalign( &p, Alignment, n*sizeof(T) ) != 0 )
+            throw std::bad_alloc();
+        return static_cast<pointer>(p);
+    }
+
+    void deallocate( pointer p, size_type ) {
+        free( p );
+    }
+
+    size_type max_size() const {
+        return static_cast<size_type>(-1) / sizeof(T);
+    }
+
+    template<typename U, typename... Args>
+    void construct( U* p, Args&&... args ) {
+        ::new((void*)p) U( std::forward<Args>(args)... );
+    }
+
+    template<typename U>
+    void destroy( U* p ) {
+        p->~U();
+    }
+};
+
+template<typename T, typename U, std::size_t A>
+inline bool operator==( const AlignedAllocator<T,A>&, const AlignedAllocator<U,A>& ) { return true;  }
+template<typename T, typename U, std::size_t A>
+inline bool operator!=( const AlignedAllocator<T,A>&, const AlignedAllocator<U,A>& ) { return false; }
+
+#endif
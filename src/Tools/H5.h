@@ -252,19 +252,27 @@ class H5 {
     }
     
     //! write a vector<short>
-    static void vect(hid_t locationId, std::string name, std::vector<short> v, int deflate=0) {
+    template<class A>
+    static void vect(hid_t locationId, std::string name, std::vector<short,A> v, int deflate=0) {
         vect(locationId, name, v[0], v.size(), H5T_NATIVE_SHORT, deflate);
     }
     
     //! write a vector<doubles>
-    static void vect(hid_t locationId, std::string name, std::vector<double> v, int deflate=0) {
+    template<class A>
+    static void vect(hid_t locationId, std::string name, std::vector<double,A> v, int deflate=0) {
         vect(locationId, name, v[0], v.size(), H5T_NATIVE_DOUBLE, deflate);
     }
     
+    //! write a vector<floats>
+    template<class A>
+    static void vect(hid_t locationId, std::string name, std::vector<float,A> v, int deflate=0) {
+        vect(locationId, name, v[0], v.size(), H5T_NATIVE_FLOAT, deflate);
+    }
+    
     
     //! write any vector
-    template<class T>
-    static void vect(hid_t locationId, std::string name, std::vector<T> v, hid_t type, int deflate=0) {
+    template<class T, class A>
+    static void vect(hid_t locationId, std::string name, std::vector<T,A> v, hid_t type, int deflate=0) {
         vect(locationId, name, v[0], v.size(), type, deflate);
     }
     
@@ -295,10 +303,17 @@ class H5 {
     
     
     //! retrieve a double vector
-    static void getVect(hid_t locationId, std::string vect_name,  std::vector<double> &vect, bool resizeVect=false) {
+    template<class A>
+    static void getVect(hid_t locationId, std::string vect_name,  std::vector<double,A> &vect, bool resizeVect=false) {
         getVect(locationId, vect_name, vect, H5T_NATIVE_DOUBLE,resizeVect);
     }
     
+    //! retrieve a float vector (converted by HDF5 if the dataset holds doubles)
+    template<class A>
+    static void getVect(hid_t locationId, std::string vect_name,  std::vector<float,A> &vect, bool resizeVect=false) {
+        getVect(locationId, vect_name, vect, H5T_NATIVE_FLOAT,resizeVect);
+    }
+    
     //! retrieve an unsigned int vector
     static void getVect(hid_t locationId, std::string vect_name,  std::vector<unsigned int> &vect, bool resizeVect=false) {
         getVect(locationId, vect_name, vect, H5T_NATIVE_UINT,resizeVect);
@@ -310,13 +325,14 @@ class H5 {
     }
     
     //! retrieve a short vector
-    static void getVect(hid_t locationId, std::string vect_name,  std::vector<short> &vect, bool resizeVect=false) {
+    template<class A>
+    static void getVect(hid_t locationId, std::string vect_name,  std::vector<short,A> &vect, bool resizeVect=false) {
         getVect(locationId, vect_name, vect, H5T_NATIVE_SHORT,resizeVect);
     }
     
     //! template to read generic 1d vector
-    template<class T>
-    static void getVect(hid_t locationId, std::string vect_name, std::vector<T> &vect, hid_t type, bool resizeVect=false) {
+    template<class T, class A>
+    static void getVect(hid_t locationId, std::string vect_name, std::vector<T,A> &vect, hid_t type, bool resizeVect=false) {
         hid_t did = H5Dopen(locationId, vect_name.c_str(), H5P_DEFAULT);
         hid_t sid = H5Dget_space(did);
         int sdim = H5Sget_simple_extent_ndims(sid);
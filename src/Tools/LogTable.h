@@ -0,0 +1,141 @@
+// -----------------------------------------------------------------------------
+//
+//! \file LogTable.h
+//
+//! \brief Lookups in the tables of the QED processes (radiation reaction,
+//!        multiphoton Breit-Wheeler), tabulated on grids uniform in log10
+//!        of the quantum parameter
+//
+// -----------------------------------------------------------------------------
+
+#ifndef LOGTABLE_H
+#define LOGTABLE_H
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "AlignedAllocator.h"
+
+//! Contiguous storage of a table, aligned for the vectorized lookups
+typedef std::vector<double, AlignedAllocator<double> > table_vector;
+
+// -----------------------------------------------------------------------------
+//! Lookup in a table of dim values tabulated from log10_min with a constant
+//! spacing delta in log10(x): the index of x is computed directly from the
+//! spacing and the values are interpolated linearly. The functions are inline
+//! so that they can be called from vectorized loops over whole bins.
+// -----------------------------------------------------------------------------
+class LogTable
+{
+public:
+    LogTable() : data_( nullptr ), dim_( 0 ), log10_min_( 0. ), inv_delta_( 0. ) {}
+
+    //! Point the lookup to the values of a table (not copied)
+    void set( const double *data, int dim, double log10_min, double delta )
+    {
+        data_      = data;
+        dim_       = dim;
+        log10_min_ = log10_min;
+        inv_delta_ = 1./delta;
+    }
+
+    //! Position of x in the table, in units of the spacing
+    inline double position( double x ) const
+    {
+        return ( log10( x ) - log10_min_ )*inv_delta_;
+    }
+
+    //! Linear interpolation at the position pos in the table,
+    //! the values at the boundaries are used out of the table
+    inline double value( double pos ) const
+    {
+        pos = std::min( std::max( pos, 0. ), (double)( dim_-1 ) );
+        int i = std::min( (int)pos, dim_-2 );
+        double d = pos - (double)i;
+        return data_[i]*( 1.-d ) + data_[i+1]*d;
+    }
+
+    //! Linear interpolation at x
+    inline double interpolate( double x ) const
+    {
+        return value( position( x ) );
+    }
+
+    //! Interpolation at the n values x (batched over a bin)
+    template<typename T>
+    void interpolate( const T *x, double *y, int n ) const
+    {
+        #pragma omp simd
+        for( int i=0 ; i<n ; i++ ) {
+            y[i] = interpolate( x[i] );
+        }
+    }
+
+private:
+    const double *data_;
+    int dim_;
+    double log10_min_;
+    double inv_delta_;
+};
+
+// -----------------------------------------------------------------------------
+//! Inverse lookup in a table of cumulative distribution functions (one per row).
+//! A guide gives, for nguide uniform intervals of probability, the range of
+//! points containing the intervals, so that the binary search is done in a
+//! few points of the row only.
+// -----------------------------------------------------------------------------
+class CDFGuide
+{
+public:
+    CDFGuide() : cdf_( nullptr ), ncols_( 0 ), nguide_( 0 ) {}
+
+    //! Build the guide of the nrows x ncols table cdf (not copied)
+    void build( const double *cdf, int nrows, int ncols, int nguide )
+    {
+        cdf_    = cdf;
+        ncols_  = ncols;
+        nguide_ = nguide;
+        guide_.resize( nrows*( nguide+1 ) );
+        for( int row=0 ; row<nrows ; row++ ) {
+            const double *c = cdf + row*ncols;
+            int i = 0;
+            for( int b=0 ; b<=nguide ; b++ ) {
+                // Last point of the row below b/nguide
+                double xi = (double)b/(double)nguide;
+                while( i < ncols-2 && c[i+1] <= xi ) {
+                    i++;
+                }
+                guide_[row*( nguide+1 )+b] = i;
+            }
+        }
+    }
+
+    //! Index i in the row such that cdf[i] <= xi < cdf[i+1], at most ncols-2
+    //! (same result as userFunctions::search_elem_in_array for cdf[0] < xi)
+    inline int search( int row, double xi ) const
+    {
+        const double *c = cdf_ + row*ncols_;
+        int b = std::min( std::max( (int)( xi*nguide_ ), 0 ), nguide_-1 );
+        const int *g = &guide_[row*( nguide_+1 )+b];
+        int imin = g[0];
+        int imax = std::min( g[1]+1, ncols_-1 );
+        while( imax - imin > 1 ) {
+            int imid = ( imin + imax )/2;
+            if( xi >= c[imid] ) {
+                imin = imid;
+            } else {
+                imax = imid;
+            }
+        }
+        return imin;
+    }
+
+private:
+    const double *cdf_;
+    int ncols_;
+    int nguide_;
+    std::vector<int> guide_;
+};
+
+#endif
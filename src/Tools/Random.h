@@ -0,0 +1,166 @@
+// -----------------------------------------------------------------------------
+//
+//! \file Random.h
+//
+//! \brief Counter-based random number generator (Philox4x32-10,
+//!        J. K. Salmon et al., SC'11)
+//
+//! \details Each number is a pure function of a key and a counter. The key is
+//!          made of the random seed and of the patch Hindex, the counter of
+//!          the timestep, of the operation (species dynamics, collisions...),
+//!          of the species or collision index and of the rank of the draw.
+//!          The numbers drawn in a patch therefore do not depend on the
+//!          thread or MPI process that owns the patch, nor on the order in
+//!          which the patches are treated.
+//
+// -----------------------------------------------------------------------------
+
+#ifndef RANDOM_H
+#define RANDOM_H
+
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+class Random
+{
+public:
+    //! Operations drawing random numbers during a timestep: each one has its own streams
+    enum Operation {
+        DYNAMICS               = 0,
+        PONDEROMOTIVE_MOMENTUM = 1,
+        PONDEROMOTIVE_POSITION = 2,
+        COLLISIONS             = 3
+    };
+
+    Random( unsigned int seed )
+    {
+        key_[0] = seed;
+        key_[1] = 0;
+        set_stream( 0, 0, 0, 0 );
+    }
+
+    //! Select a stream and restart its counter
+    //! \param hindex    Hilbert index of the patch
+    //! \param step      timestep number
+    //! \param operation see Random::Operation
+    //! \param id        species or collision index
+    inline void set_stream( uint32_t hindex, uint32_t step, uint32_t operation, uint32_t id )
+    {
+        key_[1] = hindex;
+        counter_[0] = 0;
+        counter_[1] = id;
+        counter_[2] = step;
+        counter_[3] = operation;
+        index_ = 4;
+    }
+
+    //! Random 32-bit integer
+    inline uint32_t integer()
+    {
+        if( index_ == 4 ) {
+            philox( counter_[0], counter_[1], counter_[2], counter_[3], key_[0], key_[1], buffer_ );
+            counter_[0]++;
+            index_ = 0;
+        }
+        return buffer_[index_++];
+    }
+
+    //! Random number uniformly distributed in [0,1[ (1-uniform() is never 0)
+    inline double uniform()
+    {
+        return (double)integer() * invmax_;
+    }
+
+    //! Random number uniformly distributed in [-1,1[
+    inline double uniform2()
+    {
+        return 2.*uniform() - 1.;
+    }
+
+    //! Random number in a normal distribution of standard deviation stddev (Box-Muller)
+    inline double normal( double stddev )
+    {
+        double r = std::sqrt( -2.*std::log( 1.-uniform() ) );
+        return stddev * r * std::cos( 2.*M_PI*uniform() );
+    }
+
+    //! Fill r[0:n] with random numbers uniformly distributed in [0,1[
+    //! The blocks of 4 numbers are computed independently, in a SIMD loop
+    inline void uniform( double *r, int n )
+    {
+        const uint32_t c0 = counter_[0];
+        const uint32_t c1 = counter_[1], c2 = counter_[2], c3 = counter_[3];
+        const uint32_t k0 = key_[0], k1 = key_[1];
+        const int nfull = n/4;
+
+        #pragma omp simd
+        for( int iblock=0 ; iblock<nfull ; iblock++ ) {
+            uint32_t out[4];
+            philox( c0+iblock, c1, c2, c3, k0, k1, out );
+            for( int k=0 ; k<4 ; k++ ) {
+                r[4*iblock+k] = (double)out[k] * invmax_;
+            }
+        }
+        if( n > 4*nfull ) {
+            uint32_t out[4];
+            philox( c0+nfull, c1, c2, c3, k0, k1, out );
+            for( int k=0 ; k<n-4*nfull ; k++ ) {
+                r[4*nfull+k] = (double)out[k] * invmax_;
+            }
+        }
+
+        counter_[0] += ( n+3 )/4;
+        index_ = 4;
+    }
+
+    //! Key and counter, stored in the checkpoints
+    inline std::vector<unsigned int> get_state()
+    {
+        return std::vector<unsigned int> { key_[0], key_[1], counter_[0], counter_[1], counter_[2], counter_[3] };
+    }
+    inline void set_state( std::vector<unsigned int> &state )
+    {
+        if( state.size() != 6 ) return;
+        key_[0] = state[0];
+        key_[1] = state[1];
+        for( int k=0 ; k<4 ; k++ ) {
+            counter_[k] = state[2+k];
+        }
+        index_ = 4;
+    }
+
+private:
+    //! Philox4x32 with 10 rounds: 4 random 32-bit integers from the counter (c0,c1,c2,c3) and the key (k0,k1)
+    static inline void philox( uint32_t c0, uint32_t c1, uint32_t c2, uint32_t c3, uint32_t k0, uint32_t k1, uint32_t *out )
+    {
+        for( int round=0 ; round<10 ; round++ ) {
+            uint64_t p0 = (uint64_t)0xD2511F53 * c0;
+            uint64_t p1 = (uint64_t)0xCD9E8D57 * c2;
+            uint32_t hi0 = (uint32_t)( p0 >> 32 ), lo0 = (uint32_t)p0;
+            uint32_t hi1 = (uint32_t)( p1 >> 32 ), lo1 = (uint32_t)p1;
+            c0 = hi1 ^ c1 ^ k0;
+            c1 = lo1;
+            c2 = hi0 ^ c3 ^ k1;
+            c3 = lo0;
+            k0 += 0x9E3779B9;
+            k1 += 0xBB67AE85;
+        }
+        out[0] = c0;
+        out[1] = c1;
+        out[2] = c2;
+        out[3] = c3;
+    }
+
+    //! Key: random seed and patch Hindex
+    uint32_t key_[2];
+    //! Counter: rank of the block of 4 numbers, species/collision index, timestep, operation
+    uint32_t counter_[4];
+    //! Last block of 4 numbers, and index of the next one to be returned
+    uint32_t buffer_[4];
+    unsigned int index_;
+
+    static constexpr double invmax_ = 1./4294967296.;
+};
+
+#endif
@@ -0,0 +1,196 @@
+// -----------------------------------------------------------------------------
+//
+//! \file TableCache.cpp
+//
+//! \brief Persistent cache of the computed tables of the QED processes
+//
+// -----------------------------------------------------------------------------
+
+#include "TableCache.h"
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <mpi.h>
+
+#include "SmileiMPI.h"
+#include "Tools.h"
+
+namespace
+{
+//! Version of the file format and of the table computations:
+//! to be incremented when they change, so that old files are not used
+const uint64_t table_cache_version = 1;
+
+//! Header of a cache file, followed by the values of the arrays
+struct TableCacheHeader {
+    char magic[8];
+    uint64_t version;
+    uint64_t key;
+    uint64_t narrays;
+    uint64_t sizes[TableCache::max_arrays];
+};
+
+const char table_cache_magic[8] = {'S', 'M', 'I', 'L', 'E', 'I', 'Q', 'T'};
+}
+
+// -----------------------------------------------------------------------------
+//! Constructor of the cache of the table name in the directory path
+// -----------------------------------------------------------------------------
+TableCache::TableCache( std::string path, std::string name ) :
+    path_( path ),
+    name_( name ),
+    key_( 14695981039346656037ULL )
+{
+    hash( &table_cache_version, sizeof( table_cache_version ) );
+    hash( name.c_str(), name.size() );
+}
+
+void TableCache::hash( const void *data, size_t size )
+{
+    const unsigned char *bytes = ( const unsigned char * )data;
+    for( size_t i=0 ; i<size ; i++ ) {
+        key_ = ( key_ ^ bytes[i] )*1099511628211ULL;
+    }
+}
+
+void TableCache::key( int value )
+{
+    int64_t v = value;
+    hash( &v, sizeof( v ) );
+}
+
+void TableCache::key( double value )
+{
+    hash( &value, sizeof( value ) );
+}
+
+std::string TableCache::filename() const
+{
+    std::ostringstream name;
+    name << path_ << "/" << name_ << "_" << std::hex << std::setw( 16 )
+         << std::setfill( '0' ) << key_ << ".bin";
+    return name.str();
+}
+
+// -----------------------------------------------------------------------------
+//! Read the arrays of the table from the cache file. The file is mapped
+//! read-only by every rank; the header is checked against the key and the
+//! sizes of the arrays before the values are copied.
+//
+//! \param smpi Object of class SmileiMPI containing MPI properties
+//! \param arrays arrays of the table, resized to the given sizes
+//! \param sizes expected number of values of the arrays
+// -----------------------------------------------------------------------------
+bool TableCache::read( SmileiMPI *smpi, std::vector<table_vector *> arrays, std::vector<int> sizes )
+{
+    if( path_.empty() ) {
+        return false;
+    }
+
+    int found = 0;
+    size_t file_size = sizeof( TableCacheHeader );
+    for( unsigned int i=0 ; i<sizes.size() ; i++ ) {
+        file_size += sizes[i]*sizeof( double );
+    }
+
+    int fd = open( filename().c_str(), O_RDONLY );
+    if( fd >= 0 ) {
+        struct stat st;
+        if( fstat( fd, &st ) == 0 && ( size_t )st.st_size == file_size ) {
+            void *map = mmap( NULL, file_size, PROT_READ, MAP_SHARED, fd, 0 );
+            if( map != MAP_FAILED ) {
+                const TableCacheHeader *header = ( const TableCacheHeader * )map;
+                bool valid = memcmp( header->magic, table_cache_magic, 8 ) == 0
+                             && header->version == table_cache_version
+                             && header->key == key_
+                             && header->narrays == arrays.size();
+                for( unsigned int i=0 ; valid && i<arrays.size() ; i++ ) {
+                    valid = header->sizes[i] == ( uint64_t )sizes[i];
+                }
+                if( valid ) {
+                    const double *values = ( const double * )( header+1 );
+                    for( unsigned int i=0 ; i<arrays.size() ; i++ ) {
+                        arrays[i]->assign( values, values+sizes[i] );
+                        values += sizes[i];
+                    }
+                    found = 1;
+                }
+                munmap( map, file_size );
+            }
+        }
+        close( fd );
+    }
+
+    // The table is computed by all the ranks if one of them did not find it
+    MPI_Allreduce( MPI_IN_PLACE, &found, 1, MPI_INT, MPI_MIN, smpi->getGlobalComm() );
+
+    return found;
+}
+
+// -----------------------------------------------------------------------------
+//! Write the arrays of the table in the cache file. The file is written
+//! under a temporary name and then renamed, so that concurrent runs
+//! only see complete files.
+//
+//! \param smpi Object of class SmileiMPI containing MPI properties
+//! \param arrays arrays of the table
+// -----------------------------------------------------------------------------
+void TableCache::write( SmileiMPI *smpi, std::vector<table_vector *> arrays )
+{
+    if( path_.empty() ) {
+        return;
+    }
+
+    if( arrays.size() > ( size_t )max_arrays ) {
+        ERROR( "Too many arrays in the table " << name_ << " for the cache" );
+    }
+
+    // Rank of the process in its node
+    MPI_Comm node_comm;
+    int node_rank;
+    MPI_Comm_split_type( smpi->getGlobalComm(), MPI_COMM_TYPE_SHARED,
+                         smpi->getRank(), MPI_INFO_NULL, &node_comm );
+    MPI_Comm_rank( node_comm, &node_rank );
+    MPI_Comm_free( &node_comm );
+
+    if( node_rank != 0 || Tools::file_exists( filename() ) ) {
+        return;
+    }
+
+    TableCacheHeader header;
+    memset( &header, 0, sizeof( header ) );
+    memcpy( header.magic, table_cache_magic, 8 );
+    header.version = table_cache_version;
+    header.key     = key_;
+    header.narrays = arrays.size();
+    for( unsigned int i=0 ; i<arrays.size() ; i++ ) {
+        header.sizes[i] = arrays[i]->size();
+    }
+
+    // The directory is created if needed (not its parents)
+    mkdir( path_.c_str(), 0755 );
+
+    std::ostringstream tmp;
+    tmp << filename() << "." << getpid() << "." << smpi->getRank() << ".tmp";
+
+    std::ofstream file( tmp.str().c_str(), std::ios::binary );
+    file.write( ( const char * )&header, sizeof( header ) );
+    for( unsigned int i=0 ; i<arrays.size() ; i++ ) {
+        file.write( ( const char * )arrays[i]->data(), arrays[i]->size()*sizeof( double ) );
+    }
+    file.close();
+
+    if( file.fail() || rename( tmp.str().c_str(), filename().c_str() ) != 0 ) {
+        WARNING( "The table " << name_ << " could not be written in the cache " << path_ );
+        remove( tmp.str().c_str() );
+    }
+}
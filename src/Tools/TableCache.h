@@ -0,0 +1,64 @@
+// -----------------------------------------------------------------------------
+//
+//! \file TableCache.h
+//
+//! \brief Persistent cache of the computed tables of the QED processes
+//
+// -----------------------------------------------------------------------------
+
+#ifndef TABLECACHE_H
+#define TABLECACHE_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "LogTable.h"
+
+class SmileiMPI;
+
+// -----------------------------------------------------------------------------
+//! Cache of a computed table on disk. The file of a table is named after a
+//! hash (key) of the parameters of its computation, so that identical tables
+//! are computed once and reused by all the following runs. The file is a
+//! fixed-size header followed by the raw values of the arrays of the table,
+//! so that it is read through a read-only memory mapping: the ranks of a node
+//! share the pages of the file instead of receiving the table through MPI.
+// -----------------------------------------------------------------------------
+class TableCache
+{
+public:
+    //! Cache of the table name in the directory path (disabled if path is empty)
+    TableCache( std::string path, std::string name );
+
+    //! Add a parameter of the table computation to the key
+    void key( int value );
+    void key( double value );
+
+    //! Name of the cache file of the table
+    std::string filename() const;
+
+    //! Read the arrays of the table of the given sizes from the cache,
+    //! true only if all the ranks found it (collective)
+    bool read( SmileiMPI *smpi, std::vector<table_vector *> arrays, std::vector<int> sizes );
+
+    //! Write the arrays of the table in the cache, by one rank per node
+    //! (collective) so that node-local directories can be used
+    void write( SmileiMPI *smpi, std::vector<table_vector *> arrays );
+
+    //! Maximum number of arrays in a table
+    static const int max_arrays = 4;
+
+private:
+    //! Add bytes to the key (FNV-1a hash)
+    void hash( const void *data, size_t size );
+
+    //! Directory of the cache
+    std::string path_;
+    //! Name of the table
+    std::string name_;
+    //! Hash of the name and of the parameters of the table
+    uint64_t key_;
+};
+
+#endif